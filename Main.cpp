@@ -1,457 +1,603 @@
-#include <iostream>
-#include <fstream>
-#include <limits>
-#include "include/DataManager.hpp"
-#include "include/ResultsPredictor.hpp"
-#include "include/DrivingAnalysis.hpp"
-#include "include/StrategyRecommendation.hpp"
-#include <map>
-#include <stdexcept>
-
-using namespace std;
-
-// Excepcion de fallos con cargar los datos
-class FileLoadException : public runtime_error {
-public:
-    FileLoadException(const string& filename, const string& details = "")
-        : runtime_error("Error al cargar el archivo: " + filename + 
-                      (details.empty() ? "" : ". Detalles: " + details)) {}
-};
-
-// Excepcion de seleccion de opciones invalidas
-class InvalidOptionException : public runtime_error {
-public:
-    InvalidOptionException(const string& input = "")
-        : runtime_error("Opcion no valida" + 
-                       (input.empty() ? "" : ": " + input) + 
-                       ". Por favor intente nuevamente.") {}
-};
-
-// Excepcion rango de anos invalido
-class InvalidYearException : public invalid_argument {
-public:
-    InvalidYearException(int start, int end)
-        : invalid_argument("Ano de inicio (" + to_string(start) + 
-                          ") no puede ser mayor al ano final (" + 
-                          to_string(end) + ")") {}
-};
-
-// Error de respuesta en campo
-
-class InvalidInputException : public runtime_error {
-public:
-    InvalidInputException(const string& field)
-        : runtime_error("Entrada invalida para el campo: " + field) {}
-};
-
-// Datos vacíos
-class EmptyDataException : public runtime_error {
-public:
-    EmptyDataException(const string& datasetName)
-        : runtime_error("El conjunto de datos esta vacio: " + datasetName) {}
-};
-
-
-// Comprobacion de la existencia del archivo de los datos
-bool fileExists(const string& filename) {
-    ifstream testFile(filename);
-    return testFile.good();
-}
-
-// Comprobacion rango de anos valido
-void validateYearInput(int year) {
-    if (cin.fail() || year < 1950 || year > 2023) { // Ajusta el rango segun tus datos
-        throw InvalidInputException("ano - debe ser entre 1950 y 2023");
-    }
-}
-
-int main() {
-    DataManager dataManager;
-    ResultsPredictor predictor;
-    DrivingAnalysis analysis;
-    StrategyRecommendation strategy;
-
-    try {
-        // Configuracion de rutas de archivos
-        string circuitsFilename = "Database/circuits.csv";
-        string racesFilename = "Database/races.csv";
-        string driverFilename = "Database/drivers.csv";
-        string driverStandingsFilename = "Database/driver_standings.csv";
-        string teamFilename = "Database/constructors.csv";
-        string teamStandingsFilename = "Database/constructor_standings.csv";
-        string resultsInfoFilename = "Database/results.csv";
-
-        // Verificar existencia de archivos
-        if (!fileExists(circuitsFilename)) throw FileLoadException(circuitsFilename, "Archivo no encontrado");
-        if (!fileExists(racesFilename)) throw FileLoadException(racesFilename, "Archivo no encontrado");
-        if (!fileExists(driverFilename)) throw FileLoadException(driverFilename, "Archivo no encontrado");
-        if (!fileExists(driverStandingsFilename)) throw FileLoadException(driverStandingsFilename, "Archivo no encontrado");
-        if (!fileExists(teamFilename)) throw FileLoadException(teamFilename, "Archivo no encontrado");
-        if (!fileExists(teamStandingsFilename)) throw FileLoadException(teamStandingsFilename, "Archivo no encontrado");
-        if (!fileExists(resultsInfoFilename)) throw FileLoadException(resultsInfoFilename, "Archivo no encontrado");
-
-        // Declaracion de estructuras de datos
-        map<int, Circuit> circuits;
-        map<int, Race> races;
-        map<int, Driver> drivers;
-        map<int, Team> teams;
-        map<int, DriverStandings> standings;
-        map<int, TeamStandings> teamStandings;
-        map<int, ResultsInfo_driver> driverResults;
-        map<int, ResultsInfo_team> teamResults;
-
-        // Carga de datos con manejo de excepciones
-        try {
-            circuits = dataManager.loadCircuits(circuitsFilename);
-            if (circuits.empty()) throw EmptyDataException("circuitos");
-            
-            races = dataManager.loadRaces(racesFilename, circuits);
-            if (races.empty()) throw EmptyDataException("carreras");
-            
-            drivers = dataManager.loadDrivers(driverFilename);
-            if (drivers.empty()) throw EmptyDataException("conductores");
-            
-            teams = dataManager.loadTeams(teamFilename);
-            if (teams.empty()) throw EmptyDataException("equipos");
-            
-            standings = dataManager.loadDriverStandings(driverStandingsFilename, races, drivers);
-            if (standings.empty()) throw EmptyDataException("clasificacion de conductores");
-            
-            teamStandings = dataManager.loadTeamStandings(teamStandingsFilename, races, teams);
-            if (teamStandings.empty()) throw EmptyDataException("clasificacion de equipos");
-            
-            driverResults = dataManager.loadDriverResults(resultsInfoFilename, drivers, races);
-            if (driverResults.empty()) throw EmptyDataException("resultados de conductores");
-            
-            teamResults = dataManager.loadTeamResults(resultsInfoFilename, teams, races);
-            if (teamResults.empty()) throw EmptyDataException("resultados de equipos");
-        }
-        catch (const exception& e) {
-            throw FileLoadException("Error al cargar datos", e.what());
-        }
-
-        // Bucle principal del menu
-        while (true) {
-            cout << "\n--- Menu Principal ---\n";
-            cout << "1. Prediccion de resultados para conductores\n";
-            cout << "2. Prediccion de resultados para equipos\n";
-            cout << "3. Predecir importancia de la posicion de salida\n";
-            cout << "4. Analisis de top 5 conductores\n";
-            cout << "5. Generar reporte de top 5 conductores\n";
-            cout << "6. Analisis de top 5 equipos\n";
-            cout << "7. Generar reporte de top 5 equipos\n";
-            cout << "8. Recomendacion de estrategia de pits y neumaticos\n";
-            cout << "9. Recomendacion de estrategia de combustible\n";
-            cout << "10. Recomendacion de configuracion del coche\n";
-            cout << "11. Salir\n";
-            cout << "Elija una opcion: ";
-
-            int choice;
-            try {
-                cin >> choice;
-                if (cin.fail()) {
-                    cin.clear();
-                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                    throw InvalidInputException("opcion del menu");
-                }
-                cin.ignore();
-
-                switch (choice) {
-                case 1: { // Prediccion de resultados para conductores
-                    cout << "\n1. Prediccion general\n";
-                    cout << "2. Prediccion por circuito\n";
-                    cout << "Elija una opcion para la prediccion: ";
-                    
-                    int subChoice;
-                    cin >> subChoice;
-                    if (cin.fail() || (subChoice != 1 && subChoice != 2)) {
-                        throw InvalidOptionException(to_string(subChoice));
-                    }
-                    cin.ignore();
-
-                    if (subChoice == 1) {
-                        predictor.predictResults(drivers, standings, races);
-                    } else {
-                        string circuitName;
-                        cout << "Ingrese el nombre del circuito: ";
-                        getline(cin, circuitName);
-                        if (circuitName.empty()) {
-                            throw InvalidInputException("nombre del circuito");
-                        }
-                        
-                        bool circuitFound = false;
-                        for (const auto& circuit : circuits) {
-                            if (circuit.second.name == circuitName) {
-                                circuitFound = true;
-                                break;
-                            }
-                        }
-                        if (!circuitFound) {
-                            throw InvalidInputException("nombre del circuito - circuito no encontrado");
-                        }
-                        
-                        predictor.predictResults(drivers, standings, races, circuitName);
-                    }
-                    break;
-                }
-                case 2: { // Prediccion de resultados para equipos
-                    cout << "\n1. Prediccion general\n";
-                    cout << "2. Prediccion por circuito\n";
-                    cout << "Elija una opcion para la prediccion: ";
-                    
-                    int subChoice;
-                    cin >> subChoice;
-                    if (cin.fail() || (subChoice != 1 && subChoice != 2)) {
-                        throw InvalidOptionException(to_string(subChoice));
-                    }
-                    cin.ignore();
-
-                    if (subChoice == 1) {
-                        predictor.predictTeamResults(teams, teamStandings, races);
-                    } else {
-                        string circuitName;
-                        cout << "Ingrese el nombre del circuito: ";
-                        getline(cin, circuitName);
-                        if (circuitName.empty()) {
-                            throw InvalidInputException("nombre del circuito");
-                        }
-                        
-                        bool circuitFound = false;
-                        for (const auto& circuit : circuits) {
-                            if (circuit.second.name == circuitName) {
-                                circuitFound = true;
-                                break;
-                            }
-                        }
-                        if (!circuitFound) {
-                            throw InvalidInputException("nombre del circuito - circuito no encontrado");
-                        }
-                        
-                        predictor.predictTeamResults(teams, teamStandings, races, circuitName);
-                    }
-                    break;
-                }
-                case 3: // Importancia de la posicion de salida
-                    predictor.calculateStartPositionImpact(driverResults, teamResults);
-                    break;
-                case 4: { // Analisis de top 5 conductores
-                    int startYear, endYear;
-                    cout << "Ingrese ano de inicio: ";
-                    cin >> startYear;
-                    validateYearInput(startYear);
-                    
-                    cout << "Ingrese ano final: ";
-                    cin >> endYear;
-                    validateYearInput(endYear);
-                    cin.ignore();
-
-                    if (startYear > endYear) {
-                        throw InvalidYearException(startYear, endYear);
-                    }
-
-                    auto topDrivers = analysis.calculateTopDrivers(startYear, endYear, drivers, driverResults, races);
-                    analysis.printDriverStats(topDrivers);
-                    break;
-                }
-                case 5: { // Generar reporte de top 5 conductores
-                    string filename;
-                    int startYear, endYear;
-                    
-                    cout << "Ingrese nombre del archivo para guardar el reporte: ";
-                    getline(cin, filename);
-                    if (filename.empty()) {
-                        throw InvalidInputException("nombre de archivo");
-                    }
-                    
-                    cout << "Ingrese ano de inicio: ";
-                    cin >> startYear;
-                    validateYearInput(startYear);
-                    
-                    cout << "Ingrese ano final: ";
-                    cin >> endYear;
-                    validateYearInput(endYear);
-                    cin.ignore();
-
-                    if (startYear > endYear) {
-                        throw InvalidYearException(startYear, endYear);
-                    }
-
-                    auto topDrivers = analysis.calculateTopDrivers(startYear, endYear, drivers, driverResults, races);
-                    analysis.saveDriverStatsToFile(topDrivers, filename);
-                    cout << "Reporte guardado en '" << filename << "'\n";
-                    break;
-                }
-                case 6: { // Analisis de top 5 equipos
-                    int startYear, endYear;
-                    cout << "Ingrese ano de inicio: ";
-                    cin >> startYear;
-                    validateYearInput(startYear);
-                    
-                    cout << "Ingrese ano final: ";
-                    cin >> endYear;
-                    validateYearInput(endYear);
-                    cin.ignore();
-
-                    if (startYear > endYear) {
-                        throw InvalidYearException(startYear, endYear);
-                    }
-
-                    auto topTeams = analysis.calculateTopTeams(startYear, endYear, teams, teamStandings, races);
-                    analysis.printTeamStats(topTeams);
-                    break;
-                }
-                case 7: { // Generar reporte de top 5 equipos
-                    string filename;
-                    int startYear, endYear;
-                    
-                    cout << "Ingrese nombre del archivo para guardar el reporte: ";
-                    getline(cin, filename);
-                    if (filename.empty()) {
-                        throw InvalidInputException("nombre de archivo");
-                    }
-                    
-                    cout << "Ingrese ano de inicio: ";
-                    cin >> startYear;
-                    validateYearInput(startYear);
-                    
-                    cout << "Ingrese ano final: ";
-                    cin >> endYear;
-                    validateYearInput(endYear);
-                    cin.ignore();
-
-                    if (startYear > endYear) {
-                        throw InvalidYearException(startYear, endYear);
-                    }
-
-                    auto topTeams = analysis.calculateTopTeams(startYear, endYear, teams, teamStandings, races);
-                    analysis.saveTeamStatsToFile(topTeams, filename);   // Guardamos el reporte
-                    cout << "Reporte guardado en '" << filename << "'\n";
-                    break;
-                }
-                case 8: { // Recomendacion de estrategia de pits y neumaticos
-                    string weather;
-                    int laps;
-                    double circuitLength;
-                    
-                    cout << "Ingrese condiciones climaticas (lluvioso, calor, etc.): ";
-                    getline(cin, weather);
-                    if (weather.empty()) {
-                        throw InvalidInputException("condiciones climaticas");
-                    }
-                    
-                    cout << "Ingrese numero de vueltas: ";
-                    cin >> laps;
-                    if (cin.fail() || laps <= 0) {
-                        throw InvalidInputException("numero de vueltas");
-                    }
-                    
-                    cout << "Ingrese longitud del circuito en km: ";
-                    cin >> circuitLength;
-                    if (cin.fail() || circuitLength <= 0) {
-                        throw InvalidInputException("longitud del circuito");
-                    }
-                    cin.ignore();
-
-                    cout << "\nRecomendacion de paradas en boxes:\n"
-                        << strategy.recommendPitStops(weather, laps, circuitLength)
-                        << "\n\nRecomendacion de neumaticos:\n"
-                        << strategy.recommendTireType(weather, laps)
-                        << endl;
-                    break;
-                }
-                case 9: { // Recomendacion de estrategia de combustible
-                    int laps;
-                    double circuitLength;
-                    string weather;
-                    
-                    cout << "Ingrese condiciones climaticas (lluvioso, calor, etc.): ";
-                    getline(cin, weather);
-                    if (weather.empty()) {
-                        throw InvalidInputException("condiciones climaticas");
-                    }
-                    
-                    cout << "Ingrese numero de vueltas: ";
-                    cin >> laps;
-                    if (cin.fail() || laps <= 0) {
-                        throw InvalidInputException("numero de vueltas");
-                    }
-                    
-                    cout << "Ingrese longitud del circuito en km: ";
-                    cin >> circuitLength;
-                    if (cin.fail() || circuitLength <= 0) {
-                        throw InvalidInputException("longitud del circuito");
-                    }
-                    cin.ignore();
-
-                    cout << "\nRecomendacion de estrategia de combustible:\n"
-                        << strategy.recommendFuelStrategy(laps, circuitLength, weather)
-                        << endl;
-                    break;
-                }
-                case 10: { // Recomendacion de configuracion del coche
-                    string circuitType;
-                    string weather;
-                    
-                    cout << "Ingrese tipo de circuito (altaDownforce, altaVelocidad, etc.): ";
-                    getline(cin, circuitType);
-                    if (circuitType.empty()) {
-                        throw InvalidInputException("tipo de circuito");
-                    }
-                    
-                    cout << "Ingrese condiciones climaticas (lluvioso, calor, etc.): ";
-                    getline(cin, weather);
-                    if (weather.empty()) {
-                        throw InvalidInputException("condiciones climaticas");
-                    }
-
-                    cout << "\nRecomendacion de configuracion del coche:\n"
-                        << strategy.recommendCarSetup(circuitType, weather)
-                        << endl;
-                    break;
-                }
-                case 11: // Salir del programa
-                    cout << "Saliendo del programa...\n";
-                    return 0;
-                default:
-                    throw InvalidOptionException(to_string(choice));
-                }
-            }
-            catch (const InvalidOptionException& e) {
-                cerr << "\nError: " << e.what() << endl;
-                cin.clear();
-                cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            }
-            catch (const InvalidYearException& e) {
-                cerr << "\nError: " << e.what() << endl;
-                cin.clear();
-                cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            }
-            catch (const InvalidInputException& e) {
-                cerr << "\nError: " << e.what() << endl;
-                cin.clear();
-                cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            }
-            catch (const exception& e) {
-                cerr << "\nError inesperado: " << e.what() << endl;
-                cin.clear();
-                cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            }
-        }
-    }
-    catch (const FileLoadException& e) {
-        cerr << "\nError Critico: " << e.what() << endl;
-        cerr << "El programa no puede continuar sin los datos necesarios." << endl;
-        return 1;
-    }
-    catch (const EmptyDataException& e) {
-        cerr << "\nError Critico: " << e.what() << endl;
-        cerr << "El programa no puede continuar con conjuntos de datos vacios." << endl;
-        return 1;
-    }
-    catch (const exception& e) {
-        cerr << "\nError Inesperado: " << e.what() << endl;
-        return 1;
-    }
-
-    return 0;
+#include <iostream>
+#include <fstream>
+#include <limits>
+#include "include/DataManager.hpp"
+#include "include/ResultsPredictor.hpp"
+#include "include/DrivingAnalysis.hpp"
+#include "include/StrategyRecommendation.hpp"
+#include "include/CSVBenchmark.hpp"
+#include "include/RankingEngine.hpp"
+#include "include/BatchRunner.hpp"
+#include "include/QueryServer.hpp"
+#include "include/QueryCache.hpp"
+#include "include/PitStopAnalysis.hpp"
+#include "include/FieldParser.hpp"
+#include <map>
+#include <stdexcept>
+
+using namespace std;
+
+// Excepcion de fallos con cargar los datos
+class FileLoadException : public runtime_error {
+public:
+    FileLoadException(const string& filename, const string& details = "")
+        : runtime_error("Error al cargar el archivo: " + filename + 
+                      (details.empty() ? "" : ". Detalles: " + details)) {}
+};
+
+// Excepcion de seleccion de opciones invalidas
+class InvalidOptionException : public runtime_error {
+public:
+    InvalidOptionException(const string& input = "")
+        : runtime_error("Opcion no valida" + 
+                       (input.empty() ? "" : ": " + input) + 
+                       ". Por favor intente nuevamente.") {}
+};
+
+// Excepcion rango de anos invalido
+class InvalidYearException : public invalid_argument {
+public:
+    InvalidYearException(int start, int end)
+        : invalid_argument("Ano de inicio (" + to_string(start) + 
+                          ") no puede ser mayor al ano final (" + 
+                          to_string(end) + ")") {}
+};
+
+// Error de respuesta en campo
+
+class InvalidInputException : public runtime_error {
+public:
+    InvalidInputException(const string& field)
+        : runtime_error("Entrada invalida para el campo: " + field) {}
+};
+
+// Datos vacíos
+class EmptyDataException : public runtime_error {
+public:
+    EmptyDataException(const string& datasetName)
+        : runtime_error("El conjunto de datos esta vacio: " + datasetName) {}
+};
+
+
+// Comprobacion de la existencia del archivo de los datos
+bool fileExists(const string& filename) {
+    ifstream testFile(filename);
+    return testFile.good();
+}
+
+// Comprobacion rango de anos valido
+void validateYearInput(int year) {
+    if (cin.fail() || year < 1950 || year > 2023) { // Ajusta el rango segun tus datos
+        throw InvalidInputException("ano - debe ser entre 1950 y 2023");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Modo benchmark: compara los lectores CSV sobre todos los ficheros de Database/
+    if (argc > 1 && string(argv[1]) == "--benchmark") {
+        CSVBenchmark benchmark;
+        benchmark.run(argc > 2 ? argv[2] : "Database");
+        return 0;
+    }
+
+    // Modo por lotes: --batch <fichero|-> [--format json|csv] [--output fichero]
+    bool batchMode = argc > 1 && string(argv[1]) == "--batch";
+    string batchInput = "-";
+    string batchOutput;
+    BatchFormat batchFormat = BatchFormat::JsonLines;
+    if (batchMode) {
+        for (int i = 2; i < argc; ++i) {
+            string arg = argv[i];
+            if (arg == "--format" && i + 1 < argc) {
+                optional<BatchFormat> format = BatchRunner::parseFormat(argv[++i]);
+                if (!format) {
+                    cerr << "Formato no valido: " << argv[i] << " (json o csv)" << endl;
+                    return 1;
+                }
+                batchFormat = *format;
+            } else if (arg == "--output" && i + 1 < argc) {
+                batchOutput = argv[++i];
+            } else if (arg.rfind("--", 0) != 0) {
+                batchInput = arg;
+            } else {
+                cerr << "Uso: " << argv[0] << " --batch <fichero|-> [--format json|csv] [--output fichero]" << endl;
+                return 1;
+            }
+        }
+    }
+
+    // Modo servidor: --server [puerto] [hilos]
+    bool serverMode = argc > 1 && string(argv[1]) == "--server";
+    int serverPort = 5757;
+    int serverThreads = 0;
+    if (serverMode) {
+        if ((argc > 2 && !FieldParser::parseInt(argv[2], serverPort)) || serverPort <= 0 || serverPort > 65535
+            || (argc > 3 && (!FieldParser::parseInt(argv[3], serverThreads) || serverThreads < 0))) {
+            cerr << "Uso: " << argv[0] << " --server [puerto] [hilos]" << endl;
+            return 1;
+        }
+    }
+
+    DataManager dataManager;
+    ResultsPredictor predictor;
+    DrivingAnalysis analysis;
+    StrategyRecommendation strategy;
+
+    try {
+        // Configuracion de rutas de archivos
+        string circuitsFilename = "Database/circuits.csv";
+        string racesFilename = "Database/races.csv";
+        string driverFilename = "Database/drivers.csv";
+        string driverStandingsFilename = "Database/driver_standings.csv";
+        string teamFilename = "Database/constructors.csv";
+        string teamStandingsFilename = "Database/constructor_standings.csv";
+        string resultsInfoFilename = "Database/results.csv";
+        string pitStopsFilename = "Database/pit_stops.csv";
+        string qualifyingFilename = "Database/qualifying.csv";
+        string sprintResultsFilename = "Database/sprint_results.csv";
+        string statusFilename = "Database/status.csv";
+
+        // Verificar existencia de archivos
+        if (!fileExists(circuitsFilename)) throw FileLoadException(circuitsFilename, "Archivo no encontrado");
+        if (!fileExists(racesFilename)) throw FileLoadException(racesFilename, "Archivo no encontrado");
+        if (!fileExists(driverFilename)) throw FileLoadException(driverFilename, "Archivo no encontrado");
+        if (!fileExists(driverStandingsFilename)) throw FileLoadException(driverStandingsFilename, "Archivo no encontrado");
+        if (!fileExists(teamFilename)) throw FileLoadException(teamFilename, "Archivo no encontrado");
+        if (!fileExists(teamStandingsFilename)) throw FileLoadException(teamStandingsFilename, "Archivo no encontrado");
+        if (!fileExists(resultsInfoFilename)) throw FileLoadException(resultsInfoFilename, "Archivo no encontrado");
+        if (!fileExists(pitStopsFilename)) throw FileLoadException(pitStopsFilename, "Archivo no encontrado");
+        if (!fileExists(qualifyingFilename)) throw FileLoadException(qualifyingFilename, "Archivo no encontrado");
+        if (!fileExists(sprintResultsFilename)) throw FileLoadException(sprintResultsFilename, "Archivo no encontrado");
+        if (!fileExists(statusFilename)) throw FileLoadException(statusFilename, "Archivo no encontrado");
+
+        // Carga de datos con manejo de excepciones: instantanea binaria si esta al dia,
+        // si no todos los CSV en paralelo
+        Dataset data;
+        try {
+            data = dataManager.loadCached("Database", "Database/dataset.snapshot");
+            if (data.circuits.empty()) throw EmptyDataException("circuitos");
+            if (data.races.empty()) throw EmptyDataException("carreras");
+            if (data.drivers.empty()) throw EmptyDataException("conductores");
+            if (data.teams.empty()) throw EmptyDataException("equipos");
+            if (data.driverStandings.empty()) throw EmptyDataException("clasificacion de conductores");
+            if (data.teamStandings.empty()) throw EmptyDataException("clasificacion de equipos");
+            if (data.results.empty()) throw EmptyDataException("resultados");
+        }
+        catch (const exception& e) {
+            throw FileLoadException("Error al cargar datos", e.what());
+        }
+
+        // En modo servidor los datos pasan al servidor, que los mantiene en memoria
+        if (serverMode) {
+            QueryServer server("Database", "Database/dataset.snapshot", move(data));
+            return server.run(static_cast<uint16_t>(serverPort), static_cast<size_t>(serverThreads)) ? 0 : 1;
+        }
+
+        const map<int, Driver>& drivers = data.drivers;
+        const map<int, Team>& teams = data.teams;
+        const ResultsTable& results = data.results;
+        const StatusDictionary& statuses = data.statuses;
+        const DataIndexes& indexes = data.indexes;
+        RankingEngine ranking(data);
+
+        // En modo por lotes se responden todas las consultas con una sola carga y se sale
+        if (batchMode) {
+            ifstream inputFile;
+            if (batchInput != "-") {
+                inputFile.open(batchInput);
+                if (!inputFile) throw FileLoadException(batchInput, "No se pudo abrir el fichero de consultas");
+            }
+            ofstream outputFile;
+            if (!batchOutput.empty()) {
+                outputFile.open(batchOutput);
+                if (!outputFile) throw FileLoadException(batchOutput, "No se pudo crear el fichero de salida");
+            }
+
+            // Las consultas repetidas en el mismo fichero se sirven de la cache
+            QueryCache cache;
+            BatchRunner batch(data, ranking, &cache);
+            size_t errors = batch.run(batchInput == "-" ? cin : inputFile,
+                batchOutput.empty() ? cout : outputFile, batchFormat);
+            if (errors > 0) {
+                cerr << errors << " consulta(s) con error" << endl;
+                return 2;
+            }
+            return 0;
+        }
+
+        // Bucle principal del menu
+        while (true) {
+            cout << "\n--- Menu Principal ---\n";
+            cout << "1. Prediccion de resultados para conductores\n";
+            cout << "2. Prediccion de resultados para equipos\n";
+            cout << "3. Predecir importancia de la posicion de salida\n";
+            cout << "4. Analisis de top 5 conductores\n";
+            cout << "5. Generar reporte de top 5 conductores\n";
+            cout << "6. Analisis de top 5 equipos\n";
+            cout << "7. Generar reporte de top 5 equipos\n";
+            cout << "8. Recomendacion de estrategia de pits y neumaticos\n";
+            cout << "9. Recomendacion de estrategia de combustible\n";
+            cout << "10. Recomendacion de configuracion del coche\n";
+            cout << "11. Ranking configurable (top K)\n";
+            cout << "12. Salir\n";
+            cout << "Elija una opcion: ";
+
+            int choice;
+            try {
+                cin >> choice;
+                if (cin.fail()) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    throw InvalidInputException("opcion del menu");
+                }
+                cin.ignore();
+
+                switch (choice) {
+                case 1: { // Prediccion de resultados para conductores
+                    cout << "\n1. Prediccion general\n";
+                    cout << "2. Prediccion por circuito\n";
+                    cout << "Elija una opcion para la prediccion: ";
+                    
+                    int subChoice;
+                    cin >> subChoice;
+                    if (cin.fail() || (subChoice != 1 && subChoice != 2)) {
+                        throw InvalidOptionException(to_string(subChoice));
+                    }
+                    cin.ignore();
+
+                    if (subChoice == 1) {
+                        predictor.predictResults(drivers, indexes);
+                    } else {
+                        string circuitName;
+                        cout << "Ingrese el nombre del circuito: ";
+                        getline(cin, circuitName);
+                        if (circuitName.empty()) {
+                            throw InvalidInputException("nombre del circuito");
+                        }
+                        
+                        if (indexes.names.findCircuits(circuitName).empty()) {
+                            throw InvalidInputException("nombre del circuito - circuito no encontrado");
+                        }
+                        
+                        predictor.predictResults(drivers, indexes, circuitName);
+                    }
+                    break;
+                }
+                case 2: { // Prediccion de resultados para equipos
+                    cout << "\n1. Prediccion general\n";
+                    cout << "2. Prediccion por circuito\n";
+                    cout << "Elija una opcion para la prediccion: ";
+                    
+                    int subChoice;
+                    cin >> subChoice;
+                    if (cin.fail() || (subChoice != 1 && subChoice != 2)) {
+                        throw InvalidOptionException(to_string(subChoice));
+                    }
+                    cin.ignore();
+
+                    if (subChoice == 1) {
+                        predictor.predictTeamResults(teams, indexes);
+                    } else {
+                        string circuitName;
+                        cout << "Ingrese el nombre del circuito: ";
+                        getline(cin, circuitName);
+                        if (circuitName.empty()) {
+                            throw InvalidInputException("nombre del circuito");
+                        }
+                        
+                        if (indexes.names.findCircuits(circuitName).empty()) {
+                            throw InvalidInputException("nombre del circuito - circuito no encontrado");
+                        }
+                        
+                        predictor.predictTeamResults(teams, indexes, circuitName);
+                    }
+                    break;
+                }
+                case 3: // Importancia de la posicion de salida
+                    predictor.calculateStartPositionImpact(results);
+                    break;
+                case 4: { // Analisis de top 5 conductores
+                    int startYear, endYear;
+                    cout << "Ingrese ano de inicio: ";
+                    cin >> startYear;
+                    validateYearInput(startYear);
+                    
+                    cout << "Ingrese ano final: ";
+                    cin >> endYear;
+                    validateYearInput(endYear);
+                    cin.ignore();
+
+                    if (startYear > endYear) {
+                        throw InvalidYearException(startYear, endYear);
+                    }
+
+                    auto topDrivers = analysis.calculateTopDrivers(startYear, endYear, drivers, results, statuses, indexes);
+                    analysis.printDriverStats(topDrivers);
+                    break;
+                }
+                case 5: { // Generar reporte de top 5 conductores
+                    string filename;
+                    int startYear, endYear;
+                    
+                    cout << "Ingrese nombre del archivo para guardar el reporte: ";
+                    getline(cin, filename);
+                    if (filename.empty()) {
+                        throw InvalidInputException("nombre de archivo");
+                    }
+                    
+                    cout << "Ingrese ano de inicio: ";
+                    cin >> startYear;
+                    validateYearInput(startYear);
+                    
+                    cout << "Ingrese ano final: ";
+                    cin >> endYear;
+                    validateYearInput(endYear);
+                    cin.ignore();
+
+                    if (startYear > endYear) {
+                        throw InvalidYearException(startYear, endYear);
+                    }
+
+                    auto topDrivers = analysis.calculateTopDrivers(startYear, endYear, drivers, results, statuses, indexes);
+                    analysis.saveDriverStatsToFile(topDrivers, filename);
+                    cout << "Reporte guardado en '" << filename << "'\n";
+                    break;
+                }
+                case 6: { // Analisis de top 5 equipos
+                    int startYear, endYear;
+                    cout << "Ingrese ano de inicio: ";
+                    cin >> startYear;
+                    validateYearInput(startYear);
+                    
+                    cout << "Ingrese ano final: ";
+                    cin >> endYear;
+                    validateYearInput(endYear);
+                    cin.ignore();
+
+                    if (startYear > endYear) {
+                        throw InvalidYearException(startYear, endYear);
+                    }
+
+                    auto topTeams = analysis.calculateTopTeams(startYear, endYear, teams, indexes);
+                    analysis.printTeamStats(topTeams);
+                    break;
+                }
+                case 7: { // Generar reporte de top 5 equipos
+                    string filename;
+                    int startYear, endYear;
+                    
+                    cout << "Ingrese nombre del archivo para guardar el reporte: ";
+                    getline(cin, filename);
+                    if (filename.empty()) {
+                        throw InvalidInputException("nombre de archivo");
+                    }
+                    
+                    cout << "Ingrese ano de inicio: ";
+                    cin >> startYear;
+                    validateYearInput(startYear);
+                    
+                    cout << "Ingrese ano final: ";
+                    cin >> endYear;
+                    validateYearInput(endYear);
+                    cin.ignore();
+
+                    if (startYear > endYear) {
+                        throw InvalidYearException(startYear, endYear);
+                    }
+
+                    auto topTeams = analysis.calculateTopTeams(startYear, endYear, teams, indexes);
+                    analysis.saveTeamStatsToFile(topTeams, filename);   // Guardamos el reporte
+                    cout << "Reporte guardado en '" << filename << "'\n";
+                    break;
+                }
+                case 8: { // Recomendacion de estrategia de pits y neumaticos
+                    string circuitName;
+                    string weather;
+                    int laps;
+                    double circuitLength;
+
+                    // Con un circuito, las paradas se basan en su historico de pit_stops.csv
+                    optional<CircuitPitProfile> history;
+                    cout << "Ingrese el nombre del circuito (vacio para una recomendacion general): ";
+                    getline(cin, circuitName);
+                    if (!circuitName.empty()) {
+                        vector<int> circuitIds = indexes.names.findCircuits(circuitName);
+                        if (circuitIds.empty()) {
+                            throw InvalidInputException("nombre del circuito - circuito no encontrado");
+                        }
+                        PitStopAnalysis pitStopAnalysis;
+                        vector<CircuitPitProfile> profiles = pitStopAnalysis.circuitProfiles(data.pitStops, results, circuitIds.front());
+                        if (profiles.empty()) {
+                            cout << "No hay datos de paradas para ese circuito; se usa la recomendacion general.\n";
+                        } else {
+                            history = profiles.front();
+                        }
+                    }
+
+                    cout << "Ingrese condiciones climaticas (lluvioso, calor, etc.): ";
+                    getline(cin, weather);
+                    if (weather.empty()) {
+                        throw InvalidInputException("condiciones climaticas");
+                    }
+                    
+                    cout << "Ingrese numero de vueltas: ";
+                    cin >> laps;
+                    if (cin.fail() || laps <= 0) {
+                        throw InvalidInputException("numero de vueltas");
+                    }
+                    
+                    cout << "Ingrese longitud del circuito en km: ";
+                    cin >> circuitLength;
+                    if (cin.fail() || circuitLength <= 0) {
+                        throw InvalidInputException("longitud del circuito");
+                    }
+                    cin.ignore();
+
+                    cout << "\nRecomendacion de paradas en boxes:\n"
+                        << strategy.recommendPitStops(weather, laps, circuitLength, history ? &*history : nullptr)
+                        << "\n\nRecomendacion de neumaticos:\n"
+                        << strategy.recommendTireType(weather, laps)
+                        << "\n\nSimulacion de estrategias:\n"
+                        << strategy.recommendStrategy(weather, laps, circuitLength, history ? &*history : nullptr)
+                        << endl;
+                    break;
+                }
+                case 9: { // Recomendacion de estrategia de combustible
+                    int laps;
+                    double circuitLength;
+                    string weather;
+                    
+                    cout << "Ingrese condiciones climaticas (lluvioso, calor, etc.): ";
+                    getline(cin, weather);
+                    if (weather.empty()) {
+                        throw InvalidInputException("condiciones climaticas");
+                    }
+                    
+                    cout << "Ingrese numero de vueltas: ";
+                    cin >> laps;
+                    if (cin.fail() || laps <= 0) {
+                        throw InvalidInputException("numero de vueltas");
+                    }
+                    
+                    cout << "Ingrese longitud del circuito en km: ";
+                    cin >> circuitLength;
+                    if (cin.fail() || circuitLength <= 0) {
+                        throw InvalidInputException("longitud del circuito");
+                    }
+                    cin.ignore();
+
+                    cout << "\nRecomendacion de estrategia de combustible:\n"
+                        << strategy.recommendFuelStrategy(laps, circuitLength, weather)
+                        << endl;
+                    break;
+                }
+                case 10: { // Recomendacion de configuracion del coche
+                    string circuitType;
+                    string weather;
+                    
+                    cout << "Ingrese tipo de circuito (altaDownforce, altaVelocidad, etc.): ";
+                    getline(cin, circuitType);
+                    if (circuitType.empty()) {
+                        throw InvalidInputException("tipo de circuito");
+                    }
+                    
+                    cout << "Ingrese condiciones climaticas (lluvioso, calor, etc.): ";
+                    getline(cin, weather);
+                    if (weather.empty()) {
+                        throw InvalidInputException("condiciones climaticas");
+                    }
+
+                    cout << "\nRecomendacion de configuracion del coche:\n"
+                        << strategy.recommendCarSetup(circuitType, weather)
+                        << endl;
+                    break;
+                }
+                case 11: { // Ranking configurable
+                    RankingQuery query;
+                    int option;
+                    cout << "\n1. Conductores\n2. Equipos\nElija el tipo de ranking: ";
+                    cin >> option;
+                    if (cin.fail() || (option != 1 && option != 2)) {
+                        throw InvalidOptionException(to_string(option));
+                    }
+                    query.entity = option == 1 ? RankingEntity::Driver : RankingEntity::Constructor;
+
+                    cout << "\n1. Puntos por temporada\n2. Puntos totales\n3. Victorias\n4. Podios\n"
+                        << "5. Posicion media de llegada\n6. Puntos por carrera\nElija la metrica: ";
+                    cin >> option;
+                    if (cin.fail() || option < 1 || option > 6) {
+                        throw InvalidOptionException(to_string(option));
+                    }
+                    query.metric = static_cast<RankingMetric>(option - 1);
+
+                    int topCount;
+                    cout << "Ingrese cuantos puestos mostrar (K): ";
+                    cin >> topCount;
+                    if (cin.fail() || topCount <= 0) {
+                        throw InvalidInputException("numero de puestos");
+                    }
+                    query.topCount = static_cast<size_t>(topCount);
+
+                    cout << "Ingrese ano de inicio: ";
+                    cin >> query.startYear;
+                    validateYearInput(query.startYear);
+
+                    cout << "Ingrese ano final: ";
+                    cin >> query.endYear;
+                    validateYearInput(query.endYear);
+                    cin.ignore();
+
+                    if (query.startYear > query.endYear) {
+                        throw InvalidYearException(query.startYear, query.endYear);
+                    }
+
+                    // Filtros opcionales (linea vacia = sin filtro)
+                    string filter;
+                    cout << "Ingrese nacionalidad (vacio para todas): ";
+                    getline(cin, filter);
+                    if (!filter.empty()) {
+                        query.nationality = InternedString::find(filter);
+                        if (!query.nationality) {
+                            throw InvalidInputException("nacionalidad - nacionalidad no encontrada");
+                        }
+                    }
+
+                    cout << "Ingrese el nombre del circuito (vacio para todos): ";
+                    getline(cin, filter);
+                    if (!filter.empty()) {
+                        vector<int> circuitIds = indexes.names.findCircuits(filter);
+                        if (circuitIds.empty()) {
+                            throw InvalidInputException("nombre del circuito - circuito no encontrado");
+                        }
+                        query.circuitId = circuitIds.front();
+                    }
+
+                    ranking.printRanking(query, ranking.rank(query));
+                    break;
+                }
+                case 12: // Salir del programa
+                    cout << "Saliendo del programa...\n";
+                    return 0;
+                default:
+                    throw InvalidOptionException(to_string(choice));
+                }
+            }
+            catch (const InvalidOptionException& e) {
+                cerr << "\nError: " << e.what() << endl;
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            }
+            catch (const InvalidYearException& e) {
+                cerr << "\nError: " << e.what() << endl;
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            }
+            catch (const InvalidInputException& e) {
+                cerr << "\nError: " << e.what() << endl;
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            }
+            catch (const exception& e) {
+                cerr << "\nError inesperado: " << e.what() << endl;
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            }
+        }
+    }
+    catch (const FileLoadException& e) {
+        cerr << "\nError Critico: " << e.what() << endl;
+        cerr << "El programa no puede continuar sin los datos necesarios." << endl;
+        return 1;
+    }
+    catch (const EmptyDataException& e) {
+        cerr << "\nError Critico: " << e.what() << endl;
+        cerr << "El programa no puede continuar con conjuntos de datos vacios." << endl;
+        return 1;
+    }
+    catch (const exception& e) {
+        cerr << "\nError Inesperado: " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,1236 @@
+#include "BatchRunner.hpp"
+#include "FieldParser.hpp"
+#include "QueryCache.hpp"
+#include "StrategySimulator.hpp"
+#include "CorrelationEngine.hpp"
+#include "ReliabilityAnalysis.hpp"
+#include "ChampionshipReplay.hpp"
+#include "RatingEngine.hpp"
+#include "HeadToHeadEngine.hpp"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <cmath>
+
+namespace {
+
+vector<string> splitFields(const string& line, char separator = '|') {
+    vector<string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t bar = line.find(separator, start);
+        fields.push_back(line.substr(start, bar == string::npos ? string::npos : bar - start));
+        if (bar == string::npos) {
+            break;
+        }
+        start = bar + 1;
+    }
+    return fields;
+}
+
+double parseDoubleField(const string& field, const char* what) {
+    double value;
+    if (!FieldParser::parseDouble(field, value)) {
+        throw invalid_argument(string("valor no valido para ") + what + ": '" + field + "'");
+    }
+    return value;
+}
+
+int parseField(const string& field, const char* what) {
+    int value;
+    if (!FieldParser::parseInt(field, value)) {
+        throw invalid_argument(string("valor no valido para ") + what + ": '" + field + "'");
+    }
+    return value;
+}
+
+void requireFields(const vector<string>& fields, size_t count) {
+    if (fields.size() < count) {
+        throw invalid_argument("faltan campos en la consulta '" + fields[0] + "'");
+    }
+}
+
+// Quita de 'fields' la opcion sessions=race|sprint|all, que puede ir en cualquier posicion
+SessionMask takeSessions(vector<string>& fields) {
+    for (size_t i = 1; i < fields.size(); ++i) {
+        if (fields[i].compare(0, 9, "sessions=") != 0) {
+            continue;
+        }
+        string value = fields[i].substr(9);
+        SessionMask sessions;
+        if (value == "race") {
+            sessions = RACE_SESSIONS;
+        } else if (value == "sprint") {
+            sessions = SPRINT_SESSIONS;
+        } else if (value == "all") {
+            sessions = ALL_SESSIONS;
+        } else {
+            throw invalid_argument("sesiones no validas (race, sprint o all): '" + value + "'");
+        }
+        fields.erase(fields.begin() + i);
+        return sessions;
+    }
+    return ALL_SESSIONS;
+}
+
+// Ids ordenados y sin repetir, separados por comas (parte de una clave de cache)
+string idList(vector<int> ids) {
+    sort(ids.begin(), ids.end());
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+    string text;
+    for (int id : ids) {
+        text += (text.empty() ? "" : ",") + to_string(id);
+    }
+    return text;
+}
+
+// Sistema de puntuacion de una consulta replay: preset o tabla, mas opciones clave=valor.
+// 'rounds' solo se acepta si no es nullptr.
+PointsSystem parseSystem(const string& spec, const vector<string>& fields, size_t firstOption, int* rounds) {
+    optional<PointsSystem> system = PointsSystem::parse(spec);
+    if (!system) {
+        throw invalid_argument("sistema de puntuacion no valido: '" + spec + "'");
+    }
+    for (size_t i = firstOption; i < fields.size(); ++i) {
+        size_t equals = fields[i].find('=');
+        string option = fields[i].substr(0, equals);
+        string value = equals == string::npos ? "" : fields[i].substr(equals + 1);
+        if (option == "sprint") {
+            optional<PointsSystem> sprint = PointsSystem::parse(value);
+            if (!sprint || sprint->official) {
+                throw invalid_argument("valor no valido para sprint: '" + value + "'");
+            }
+            system->sprint = sprint->race;
+        } else if (option == "fastest") {
+            if (!FieldParser::parsePoints(value, system->fastestLap) || system->fastestLap < 0) {
+                throw invalid_argument("valor no valido para fastest: '" + value + "'");
+            }
+        } else if (option == "fastest-top") {
+            system->fastestLapTop = max(parseField(value, option.c_str()), 0);
+        } else if (option == "best") {
+            system->bestResults = max(parseField(value, option.c_str()), 0);
+        } else if (option == "round" && rounds) {
+            *rounds = max(parseField(value, option.c_str()), 0);
+        } else {
+            throw invalid_argument("opcion desconocida: '" + fields[i] + "'");
+        }
+    }
+    // Con opciones, "official" deja de ser la puntuacion oficial
+    if (system->official && (!system->sprint.empty() || system->fastestLap || system->bestResults)) {
+        throw invalid_argument("el sistema official no admite opciones de puntuacion");
+    }
+    return *system;
+}
+
+// Forma normalizada de un sistema para la clave de cache
+string systemKey(const PointsSystem& system) {
+    if (system.official) {
+        return "official";
+    }
+    string key;
+    for (const vector<int32_t>* table : { &system.race, &system.sprint }) {
+        for (size_t i = 0; i < table->size(); ++i) {
+            key += (i ? "," : "") + to_string((*table)[i]);
+        }
+        key += ";";
+    }
+    return key + to_string(system.fastestLap) + ";" + to_string(system.fastestLapTop) + ";" + to_string(system.bestResults);
+}
+
+// Quita de 'fields' las opciones clave=valor del motor de puntuaciones
+RatingSettings takeRatingSettings(vector<string>& fields) {
+    RatingSettings settings;
+    for (size_t i = 1; i < fields.size();) {
+        size_t equals = fields[i].find('=');
+        if (equals == string::npos) {
+            ++i;
+            continue;
+        }
+        string option = fields[i].substr(0, equals);
+        string value = fields[i].substr(equals + 1);
+        if (option == "model") {
+            optional<RatingModel> model = RatingSettings::parseModel(value);
+            if (!model) {
+                throw invalid_argument("modelo de puntuacion desconocido (glicko o elo): '" + value + "'");
+            }
+            settings.model = *model;
+        } else if (option == "initial") {
+            settings.initialRating = parseDoubleField(value, "initial");
+        } else if (option == "k") {
+            settings.kFactor = parseDoubleField(value, "k");
+        } else if (option == "c") {
+            settings.deviationGrowth = parseDoubleField(value, "c");
+        } else if (option == "mechanical") {
+            if (value != "ignore" && value != "count") {
+                throw invalid_argument("valor no valido para mechanical (ignore o count): '" + value + "'");
+            }
+            settings.excludeMechanical = value == "ignore";
+        } else {
+            throw invalid_argument("opcion desconocida: '" + option + "'");
+        }
+        if (settings.kFactor <= 0 || settings.deviationGrowth < 0) {
+            throw invalid_argument("valor no valido para " + option + ": '" + value + "'");
+        }
+        fields.erase(fields.begin() + i);
+    }
+    return settings;
+}
+
+void writeJsonString(ostream& out, const string& text) {
+    out << '"';
+    for (char c : text) {
+        switch (c) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\r': out << "\\r"; break;
+        case '\t': out << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out << "\\u" << hex << setw(4) << setfill('0') << static_cast<int>(c) << dec << setfill(' ');
+            } else {
+                out << c;
+            }
+        }
+    }
+    out << '"';
+}
+
+// NaN e infinito no son JSON valido (p. ej. una media 0/0 de una ventana vacia): se escriben como null
+void writeNumber(ostream& out, double value) {
+    if (isfinite(value)) {
+        out << value;
+    } else {
+        out << "null";
+    }
+}
+
+void writeCsvField(ostream& out, const string& text) {
+    if (text.find_first_of(",\"\n\r") == string::npos) {
+        out << text;
+        return;
+    }
+    out << '"';
+    for (char c : text) {
+        if (c == '"') {
+            out << '"';
+        }
+        out << c;
+    }
+    out << '"';
+}
+
+}
+
+BatchRunner::BatchRunner(const Dataset& data, const RankingEngine& ranking, QueryCache* cache, uint64_t dataVersion,
+    RatingEngineSet* ratings, const HeadToHeadEngine* headToHead, const ChampionshipReplay* replay)
+    : data(data), ranking(ranking), cache(cache), dataVersion(dataVersion), sharedReplay(replay), sharedRatings(ratings),
+      sharedHeadToHead(headToHead) {}
+
+BatchRunner::~BatchRunner() = default;
+
+size_t BatchRunner::run(istream& in, ostream& out, BatchFormat format) {
+    out << setprecision(10);
+    if (format == BatchFormat::Csv) {
+        out << "query,type,rank,id,name,field,value\n";
+    }
+
+    size_t query = 0;
+    size_t errors = 0;
+    string line;
+    while (getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        BatchResult result = execute(line);
+        ++query;
+        if (!result.error.empty()) {
+            ++errors;
+        }
+        if (format == BatchFormat::JsonLines) {
+            writeJson(out, query, result);
+        } else {
+            writeCsv(out, query, result);
+        }
+    }
+    out.flush();
+    return errors;
+}
+
+BatchResult BatchRunner::execute(const string& line) {
+    vector<string> fields = splitFields(line);
+    try {
+        const string& type = fields[0];
+        if (type == "drivers" || type == "teams") {
+            return predict(fields);
+        }
+        if (type == "top") {
+            return top(fields);
+        }
+        if (type == "stats") {
+            return stats(fields);
+        }
+        if (type == "impact") {
+            return cached("impact", [&]() { return impact(); });
+        }
+        if (type == "pitstops") {
+            return pitStops(fields);
+        }
+        if (type == "correlation") {
+            return correlation(fields);
+        }
+        if (type == "reliability") {
+            return reliability(fields);
+        }
+        if (type == "qualifying") {
+            return qualifying(fields);
+        }
+        if (type == "simulate") {
+            return simulate(fields);
+        }
+        if (type == "replay") {
+            return replay(fields);
+        }
+        if (type == "rating") {
+            return rating(fields);
+        }
+        if (type == "teammates") {
+            return teammates(fields);
+        }
+        if (type == "cache") {
+            return cacheStats();
+        }
+        throw invalid_argument("tipo de consulta desconocido: '" + type + "'");
+    }
+    catch (const exception& e) {
+        BatchResult result;
+        result.type = fields[0];
+        result.error = e.what();
+        return result;
+    }
+}
+
+BatchResult BatchRunner::predict(const vector<string>& fields) {
+    requireFields(fields, 3);
+    bool driver = fields[0] == "drivers";
+    const string& circuitName = fields[1];
+    if (!circuitName.empty() && !findCircuit(circuitName)) {
+        throw invalid_argument("circuito no encontrado: '" + circuitName + "'");
+    }
+
+    // Los campos clave=valor son opciones; el resto, nombres
+    ResultsPredictor queryPredictor;
+    vector<string> names;
+    for (size_t i = 2; i < fields.size(); ++i) {
+        size_t equals = fields[i].find('=');
+        if (equals == string::npos) {
+            names.push_back(fields[i]);
+            continue;
+        }
+        string key = fields[i].substr(0, equals);
+        string value = fields[i].substr(equals + 1);
+        PredictionSettings& settings = queryPredictor.settings;
+        if (key == "weighting") {
+            optional<WeightingMode> mode = PredictionKernel::parseWeighting(value);
+            if (!mode) {
+                throw invalid_argument("funcion de peso desconocida: '" + value + "'");
+            }
+            settings.weighting = *mode;
+        } else if (key == "reference") {
+            settings.referenceYear = parseField(value, "reference");
+        } else if (key == "halflife") {
+            settings.halfLifeYears = parseDoubleField(value, "halflife");
+        } else if (key == "span") {
+            settings.linearSpanYears = parseDoubleField(value, "span");
+        } else if (key == "qualifying") {
+            settings.qualifyingWeight = parseDoubleField(value, "qualifying");
+            if (settings.qualifyingWeight < 0) {
+                throw invalid_argument("el peso de la clasificacion no puede ser negativo");
+            }
+        } else if (key == "reliability") {
+            settings.reliabilityWeight = parseDoubleField(value, "reliability");
+            if (settings.reliabilityWeight < 0) {
+                throw invalid_argument("el peso de la fiabilidad no puede ser negativo");
+            }
+        } else {
+            throw invalid_argument("opcion desconocida: '" + key + "'");
+        }
+    }
+
+    // Clave: los ids a los que se resuelven los nombres y el circuito, y el peso
+    vector<int> ids;
+    string unknown;
+    for (const string& name : names) {
+        vector<int> found = driver ? data.indexes.names.findDrivers(name) : data.indexes.names.findTeams(name);
+        if (found.empty()) {
+            unknown += (unknown.empty() ? "'" : ", '") + name + "'";
+        }
+        ids.insert(ids.end(), found.begin(), found.end());
+    }
+    if (!unknown.empty()) {
+        throw invalid_argument(string(driver ? "pilotos" : "equipos") + " no encontrados: " + unknown);
+    }
+    const PredictionSettings& settings = queryPredictor.settings;
+    ostringstream key;
+    key << setprecision(17) << fields[0] << "|" << (circuitName.empty() ? "*" : idList(data.indexes.names.findCircuits(circuitName)))
+        << "|" << idList(ids) << "|" << PredictionKernel::weightingName(settings.weighting) << "|" << settings.referenceYear;
+    if (settings.weighting == WeightingMode::HalfLife) {
+        key << "|" << settings.halfLifeYears;
+    } else if (settings.weighting == WeightingMode::Linear) {
+        key << "|" << settings.linearSpanYears;
+    }
+    if (settings.qualifyingWeight > 0) {
+        key << "|q" << settings.qualifyingWeight;
+    }
+    if (settings.reliabilityWeight > 0) {
+        key << "|r" << settings.reliabilityWeight;
+    }
+
+    return cached(key.str(), [&]() {
+        vector<pair<double, int>> prediction = driver
+            ? queryPredictor.calculateDriverPrediction(data.indexes, names, circuitName)
+            : queryPredictor.calculateTeamPrediction(data.indexes, names, circuitName);
+
+        BatchResult result;
+        result.type = fields[0];
+        for (const auto& entry : prediction) {
+            result.rows.push_back({ entry.second, entityName(driver, entry.second), { { "points", entry.first } } });
+        }
+        return result;
+    });
+}
+
+BatchResult BatchRunner::top(const vector<string>& queryFields) {
+    vector<string> fields = queryFields;
+    RankingQuery query;
+    query.sessions = takeSessions(fields);
+    requireFields(fields, 6);
+    if (fields[1] == "driver") {
+        query.entity = RankingEntity::Driver;
+    } else if (fields[1] == "team") {
+        query.entity = RankingEntity::Constructor;
+    } else {
+        throw invalid_argument("entidad no valida (driver o team): '" + fields[1] + "'");
+    }
+
+    optional<RankingMetric> metric = RankingEngine::parseMetric(fields[2]);
+    if (!metric) {
+        throw invalid_argument("metrica desconocida: '" + fields[2] + "'");
+    }
+    query.metric = *metric;
+
+    int topCount = parseField(fields[3], "K");
+    if (topCount <= 0) {
+        throw invalid_argument("K debe ser positivo");
+    }
+    query.topCount = static_cast<size_t>(topCount);
+    query.startYear = parseField(fields[4], "ano de inicio");
+    query.endYear = parseField(fields[5], "ano final");
+    if (query.startYear > query.endYear) {
+        throw invalid_argument("el ano de inicio es mayor que el ano final");
+    }
+
+    if (fields.size() > 6 && !fields[6].empty()) {
+        // Una nacionalidad que no aparece en los datos no es un filtro vacio sino un error
+        query.nationality = InternedString::find(fields[6]);
+        if (!query.nationality) {
+            throw invalid_argument("nacionalidad no encontrada: '" + fields[6] + "'");
+        }
+    }
+    if (fields.size() > 7 && !fields[7].empty()) {
+        query.circuitId = findCircuit(fields[7]);
+        if (!query.circuitId) {
+            throw invalid_argument("circuito no encontrado: '" + fields[7] + "'");
+        }
+    }
+
+    bool driver = query.entity == RankingEntity::Driver;
+    string key = "top|" + fields[1] + "|" + RankingEngine::metricKey(query.metric) + "|" + to_string(query.topCount)
+        + "|" + to_string(query.startYear) + "|" + to_string(query.endYear)
+        + "|" + (query.nationality ? to_string(query.nationality->index()) : "*")
+        + "|" + (query.circuitId ? to_string(*query.circuitId) : "*") + "|s" + to_string(query.sessions);
+
+    return cached(key, [&]() {
+        BatchResult result;
+        result.type = "top";
+        for (const RankingEntry& entry : ranking.rank(query)) {
+            result.rows.push_back({ entry.entityId, entityName(driver, entry.entityId),
+                { { RankingEngine::metricKey(query.metric), entry.value }, { "starts", static_cast<double>(entry.starts) } } });
+        }
+        return result;
+    });
+}
+
+BatchResult BatchRunner::stats(const vector<string>& queryFields) {
+    vector<string> fields = queryFields;
+    SessionMask sessions = takeSessions(fields);
+    requireFields(fields, 4);
+    int startYear = parseField(fields[2], "ano de inicio");
+    int endYear = parseField(fields[3], "ano final");
+    if (startYear > endYear) {
+        throw invalid_argument("el ano de inicio es mayor que el ano final");
+    }
+
+    auto values = [](const PointStats& stats) -> vector<pair<string, double>> {
+        return { { "max", stats.maxPoints }, { "min", stats.minPoints },
+            { "average", stats.averagePoints }, { "stddev", stats.stdDevPoints() } };
+    };
+
+    if (fields[1] != "drivers" && fields[1] != "teams") {
+        throw invalid_argument("entidad no valida (drivers o teams): '" + fields[1] + "'");
+    }
+
+    string key = "stats|" + fields[1] + "|" + to_string(startYear) + "|" + to_string(endYear) + "|s" + to_string(sessions);
+    return cached(key, [&]() {
+        BatchResult result;
+        result.type = "stats";
+        if (fields[1] == "drivers") {
+            for (const auto& item : analysis.calculateTopDrivers(startYear, endYear, data.drivers, data.results, data.statuses,
+                    data.indexes, sessions)) {
+                result.rows.push_back({ item.first.driverId, item.first.fullName.str(), values(item.second) });
+            }
+        } else {
+            for (const auto& item : analysis.calculateTopTeams(startYear, endYear, data.teams, data.indexes)) {
+                result.rows.push_back({ item.first.teamId, item.first.name.str(), values(item.second) });
+            }
+        }
+        return result;
+    });
+}
+
+BatchResult BatchRunner::impact() {
+    BatchResult result;
+    result.type = "impact";
+    result.rows.push_back({ 0, "", { { "pearson", predictor.calculateStartPositionCorrelation(data.results) } } });
+    return result;
+}
+
+BatchResult BatchRunner::pitStops(const vector<string>& fields) {
+    requireFields(fields, 2);
+    if (fields[1] == "teams") {
+        requireFields(fields, 4);
+        int startYear = parseField(fields[2], "ano de inicio");
+        int endYear = parseField(fields[3], "ano final");
+        if (startYear > endYear) {
+            throw invalid_argument("el ano de inicio es mayor que el ano final");
+        }
+        return cached("pitstops|teams|" + to_string(startYear) + "|" + to_string(endYear), [&]() {
+            BatchResult result;
+            result.type = "pitstops";
+            for (const TeamPitSummary& team : pitStopAnalysis.teamStopTimes(data.pitStops, startYear, endYear)) {
+                result.rows.push_back({ team.teamId, entityName(false, team.teamId), {
+                    { "median-seconds", team.medianSeconds }, { "best-seconds", team.bestSeconds },
+                    { "stops", static_cast<double>(team.stops) } } });
+            }
+            return result;
+        });
+    }
+    if (fields[1] != "circuits") {
+        throw invalid_argument("entidad no valida (circuits o teams): '" + fields[1] + "'");
+    }
+
+    optional<int> circuitId;
+    if (fields.size() > 2 && !fields[2].empty()) {
+        circuitId = findCircuit(fields[2]);
+        if (!circuitId) {
+            throw invalid_argument("circuito no encontrado: '" + fields[2] + "'");
+        }
+    }
+    return cached("pitstops|circuits|" + (circuitId ? to_string(*circuitId) : "*"), [&]() {
+        BatchResult result;
+        result.type = "pitstops";
+        for (const CircuitPitProfile& profile : pitStopAnalysis.circuitProfiles(data.pitStops, data.results, circuitId)) {
+            auto circuit = data.circuits.find(profile.circuitId);
+            BatchRow row{ profile.circuitId, circuit != data.circuits.end() ? circuit->second.name.str() : "", {
+                { "races", static_cast<double>(profile.races) },
+                { "typical-stops", static_cast<double>(profile.typicalStops) },
+                { "average-stops", profile.averageStops },
+                { "race-laps", static_cast<double>(profile.raceLaps) },
+                { "lap-seconds", profile.lapSeconds },
+                { "safety-car-rate", profile.safetyCarRate },
+                { "undercut-start", static_cast<double>(profile.undercutStart) },
+                { "undercut-end", static_cast<double>(profile.undercutEnd) },
+                { "median-seconds", profile.medianSeconds } } };
+            for (const StopLapSummary& stop : profile.stopLaps) {
+                row.values.push_back({ "stop" + to_string(stop.stop) + "-median-lap", static_cast<double>(stop.medianLap) });
+            }
+            result.rows.push_back(move(row));
+        }
+        return result;
+    });
+}
+
+BatchResult BatchRunner::correlation(const vector<string>& fields) {
+    requireFields(fields, 2);
+    CorrelationOptions options;
+    if (fields.size() > 3) {
+        options.startYear = parseField(fields[2], "ano de inicio");
+        options.endYear = parseField(fields[3], "ano final");
+        if (options.startYear > options.endYear) {
+            throw invalid_argument("el ano de inicio es mayor que el ano final");
+        }
+    }
+    string years = to_string(options.startYear) + "|" + to_string(options.endYear);
+
+    if (fields[1] == "matrix") {
+        optional<int> circuitId;
+        if (fields.size() > 4 && !fields[4].empty()) {
+            circuitId = findCircuit(fields[4]);
+            if (!circuitId) {
+                throw invalid_argument("circuito no encontrado: '" + fields[4] + "'");
+            }
+        }
+        options.ranks = false;
+        options.transitions = true;
+        return cached("correlation|matrix|" + years + "|" + (circuitId ? to_string(*circuitId) : "*"), [&]() {
+            BatchResult result;
+            result.type = "correlation";
+            CorrelationEngine engine(data.results, data.races);
+            for (const GroupCorrelation& group : engine.compute(circuitId ? CorrelationGroup::Circuit : CorrelationGroup::All, options)) {
+                if (circuitId && group.groupId != *circuitId) {
+                    continue;
+                }
+                // Una fila por posicion de salida: probabilidad de cada posicion de llegada
+                const TransitionMatrix& matrix = group.transitions;
+                for (int grid = 1; grid <= matrix.size; ++grid) {
+                    uint64_t starts = matrix.rowTotal(grid);
+                    if (starts == 0) {
+                        continue;
+                    }
+                    BatchRow row{ grid, "", { { "starts", static_cast<double>(starts) } } };
+                    for (int finish = 1; finish <= matrix.size; ++finish) {
+                        if (uint32_t cell = matrix.at(grid, finish)) {
+                            row.values.push_back({ "p" + to_string(finish), static_cast<double>(cell) / starts });
+                        }
+                    }
+                    result.rows.push_back(move(row));
+                }
+            }
+            return result;
+        });
+    }
+
+    CorrelationGroup group;
+    if (fields[1] == "all") {
+        group = CorrelationGroup::All;
+    } else if (fields[1] == "circuits") {
+        group = CorrelationGroup::Circuit;
+    } else if (fields[1] == "seasons") {
+        group = CorrelationGroup::Season;
+    } else if (fields[1] == "constructors") {
+        group = CorrelationGroup::Constructor;
+    } else {
+        throw invalid_argument("agrupacion no valida (all, circuits, seasons, constructors o matrix): '" + fields[1] + "'");
+    }
+    return cached("correlation|" + fields[1] + "|" + years, [&]() {
+        BatchResult result;
+        result.type = "correlation";
+        CorrelationEngine engine(data.results, data.races);
+        for (const GroupCorrelation& correlation : engine.compute(group, options)) {
+            string name;
+            if (group == CorrelationGroup::Season) {
+                name = to_string(correlation.groupId);
+            } else if (group == CorrelationGroup::Constructor) {
+                name = entityName(false, correlation.groupId);
+            } else if (group == CorrelationGroup::Circuit) {
+                auto circuit = data.circuits.find(correlation.groupId);
+                name = circuit != data.circuits.end() ? circuit->second.name.str() : "";
+            }
+            const CorrelationStats& stats = correlation.stats;
+            result.rows.push_back({ correlation.groupId, name, {
+                { "count", stats.count },
+                { "pearson", stats.pearson() },
+                { "spearman", correlation.spearman },
+                { "covariance", stats.covariance() },
+                { "mean-grid", stats.meanX },
+                { "mean-finish", stats.meanY } } });
+        }
+        return result;
+    });
+}
+
+BatchResult BatchRunner::reliability(const vector<string>& fields) {
+    requireFields(fields, 2);
+    int startYear = 0;
+    int endYear = 0;
+    if (fields.size() > 3) {
+        startYear = parseField(fields[2], "ano de inicio");
+        endYear = parseField(fields[3], "ano final");
+        if (startYear > endYear) {
+            throw invalid_argument("el ano de inicio es mayor que el ano final");
+        }
+    }
+    string years = to_string(startYear) + "|" + to_string(endYear);
+
+    if (fields[1] == "causes") {
+        int constructorId = -1;
+        if (fields.size() > 4 && !fields[4].empty()) {
+            vector<int> teams = data.indexes.names.findTeams(fields[4]);
+            if (teams.empty()) {
+                throw invalid_argument("equipo no encontrado: '" + fields[4] + "'");
+            }
+            constructorId = teams.front();
+        }
+        return cached("reliability|causes|" + years + "|" + (constructorId < 0 ? "*" : to_string(constructorId)), [&]() {
+            BatchResult result;
+            result.type = "reliability";
+            ReliabilityAnalysis analysis(data.results, data.statuses);
+            size_t starts = 0;
+            for (const GroupReliability& team : analysis.compute(ReliabilityGroup::Constructor, startYear, endYear)) {
+                if (constructorId < 0 || team.groupId == constructorId) {
+                    starts += team.outcomes.starts;
+                }
+            }
+            for (const StatusCount& cause : analysis.causes(startYear, endYear, constructorId)) {
+                result.rows.push_back({ cause.statusId, data.statuses.name(cause.statusId).str(), {
+                    { "count", static_cast<double>(cause.count) },
+                    { "share", starts ? static_cast<double>(cause.count) / starts : 0.0 },
+                    { "mechanical", cause.outcome == Outcome::Mechanical ? 1.0 : 0.0 } } });
+            }
+            return result;
+        });
+    }
+
+    ReliabilityGroup group;
+    if (fields[1] == "all") {
+        group = ReliabilityGroup::All;
+    } else if (fields[1] == "constructors") {
+        group = ReliabilityGroup::Constructor;
+    } else if (fields[1] == "drivers") {
+        group = ReliabilityGroup::Driver;
+    } else if (fields[1] == "seasons") {
+        group = ReliabilityGroup::Season;
+    } else if (fields[1] == "circuits") {
+        group = ReliabilityGroup::Circuit;
+    } else {
+        throw invalid_argument("agrupacion no valida (all, constructors, drivers, seasons, circuits o causes): '" + fields[1] + "'");
+    }
+    return cached("reliability|" + fields[1] + "|" + years, [&]() {
+        BatchResult result;
+        result.type = "reliability";
+        ReliabilityAnalysis analysis(data.results, data.statuses, data.races);
+        for (const GroupReliability& entry : analysis.compute(group, startYear, endYear)) {
+            string name;
+            if (group == ReliabilityGroup::Season) {
+                name = to_string(entry.groupId);
+            } else if (group == ReliabilityGroup::Constructor || group == ReliabilityGroup::Driver) {
+                name = entityName(group == ReliabilityGroup::Driver, entry.groupId);
+            } else if (group == ReliabilityGroup::Circuit) {
+                auto circuit = data.circuits.find(entry.groupId);
+                name = circuit != data.circuits.end() ? circuit->second.name.str() : "";
+            }
+            const OutcomeCounts& outcomes = entry.outcomes;
+            BatchRow row{ entry.groupId, name, { { "starts", static_cast<double>(outcomes.starts) } } };
+            for (size_t outcome = 0; outcome < StatusDictionary::OUTCOME_COUNT; ++outcome) {
+                row.values.push_back({ StatusDictionary::outcomeName(static_cast<Outcome>(outcome)),
+                    static_cast<double>(outcomes.counts[outcome]) });
+            }
+            row.values.push_back({ "finish-rate", outcomes.finishRate() });
+            row.values.push_back({ "failure-rate", outcomes.failureRate() });
+            row.values.push_back({ "attrition", outcomes.attrition() });
+            result.rows.push_back(move(row));
+        }
+        return result;
+    });
+}
+
+BatchResult BatchRunner::qualifying(const vector<string>& fields) {
+    requireFields(fields, 3);
+    if (fields[1] == "race") {
+        requireFields(fields, 4);
+        int year = parseField(fields[2], "ano");
+        optional<int> circuitId = findCircuit(fields[3]);
+        if (!circuitId) {
+            throw invalid_argument("circuito no encontrado: '" + fields[3] + "'");
+        }
+        int raceId = -1;
+        pair<size_t, size_t> races = data.indexes.racesBetween(year, year);
+        for (size_t i = races.first; i < races.second; ++i) {
+            const Race* race = data.indexes.racesByDate[i];
+            if (race->circuit && race->circuit->circuitId == *circuitId) {
+                raceId = race->raceId;
+                break;
+            }
+        }
+        if (raceId < 0) {
+            throw invalid_argument("no hay carrera en ese circuito en " + to_string(year));
+        }
+        return cached("qualifying|race|" + to_string(raceId), [&]() {
+            BatchResult result;
+            result.type = "qualifying";
+            for (const QualifyingGap& gap : qualifyingAnalysis.gapToPole(data.qualifying, data.results, data.indexes, raceId)) {
+                result.rows.push_back({ gap.driverId, entityName(true, gap.driverId), {
+                    { "position", static_cast<double>(gap.position) },
+                    { "best-seconds", gap.bestMs / 1000.0 },
+                    { "gap-seconds", gap.gapMs / 1000.0 },
+                    { "gap-percent", gap.gapPercent },
+                    { "race-fastest-lap-seconds", gap.raceFastestLapMs > 0 ? gap.raceFastestLapMs / 1000.0 : -1.0 } } });
+            }
+            return result;
+        });
+    }
+    if (fields[1] == "teammates") {
+        requireFields(fields, 4);
+        int startYear = parseField(fields[2], "ano de inicio");
+        int endYear = parseField(fields[3], "ano final");
+        if (startYear > endYear) {
+            throw invalid_argument("el ano de inicio es mayor que el ano final");
+        }
+        return cached("qualifying|teammates|" + to_string(startYear) + "|" + to_string(endYear), [&]() {
+            BatchResult result;
+            result.type = "qualifying";
+            for (const TeammateDelta& duel : qualifyingAnalysis.teammateDeltas(data.qualifying, data.indexes, startYear, endYear)) {
+                result.rows.push_back({ duel.driverId, entityName(true, duel.driverId), {
+                    { "teammate-id", static_cast<double>(duel.teammateId) },
+                    { "team-id", static_cast<double>(duel.teamId) },
+                    { "races", static_cast<double>(duel.races) },
+                    { "ahead", static_cast<double>(duel.ahead) },
+                    { "median-delta-percent", duel.medianDeltaPercent } } });
+            }
+            return result;
+        });
+    }
+    if (fields[1] != "season") {
+        throw invalid_argument("consulta de clasificacion no valida (race, teammates o season): '" + fields[1] + "'");
+    }
+    int year = parseField(fields[2], "ano");
+    return cached("qualifying|season|" + to_string(year), [&]() {
+        BatchResult result;
+        result.type = "qualifying";
+        for (const QualifyingPace& pace : qualifyingAnalysis.seasonPace(data.qualifying, data.indexes, year)) {
+            result.rows.push_back({ pace.driverId, entityName(true, pace.driverId), {
+                { "races", static_cast<double>(pace.races) },
+                { "median-gap-percent", pace.medianGapPercent },
+                { "average-position", pace.averagePosition },
+                { "poles", static_cast<double>(pace.poles) } } });
+        }
+        return result;
+    });
+}
+
+BatchResult BatchRunner::simulate(const vector<string>& fields) {
+    requireFields(fields, 5);
+    optional<int> circuitId;
+    if (!fields[1].empty()) {
+        circuitId = findCircuit(fields[1]);
+        if (!circuitId) {
+            throw invalid_argument("circuito no encontrado: '" + fields[1] + "'");
+        }
+    }
+    int laps = parseField(fields[2], "numero de vueltas");
+    double circuitLength = parseDoubleField(fields[3], "longitud del circuito");
+    if (laps <= 0 || circuitLength <= 0) {
+        throw invalid_argument("el numero de vueltas y la longitud deben ser positivos");
+    }
+    const string& weather = fields[4];
+
+    SimulationSettings settings;
+    for (size_t i = 5; i < fields.size(); ++i) {
+        size_t equals = fields[i].find('=');
+        string option = fields[i].substr(0, equals);
+        string value = equals == string::npos ? "" : fields[i].substr(equals + 1);
+        int number = parseField(value, option.c_str());
+        if (number <= 0 && option != "seed" && option != "stops") {
+            throw invalid_argument("valor no valido para " + option + ": '" + value + "'");
+        }
+        if (option == "runs") {
+            settings.runs = static_cast<size_t>(number);
+        } else if (option == "seed") {
+            settings.seed = static_cast<uint64_t>(number);
+        } else if (option == "stops") {
+            settings.maxStops = min(max(number, 0), 4);
+        } else if (option == "step") {
+            settings.lapStep = number;
+        } else if (option == "top") {
+            settings.topCount = static_cast<size_t>(number);
+        } else {
+            throw invalid_argument("opcion desconocida: '" + fields[i] + "'");
+        }
+    }
+
+    ostringstream key;
+    key << setprecision(17) << "simulate|" << (circuitId ? to_string(*circuitId) : "*") << "|" << laps << "|"
+        << circuitLength << "|" << weather << "|" << settings.runs << "|" << settings.seed << "|"
+        << settings.maxStops << "|" << settings.lapStep << "|" << settings.topCount;
+    return cached(key.str(), [&]() {
+        optional<CircuitPitProfile> history;
+        if (circuitId) {
+            vector<CircuitPitProfile> profiles = pitStopAnalysis.circuitProfiles(data.pitStops, data.results, circuitId);
+            if (!profiles.empty()) {
+                history = profiles.front();
+            }
+        }
+        RaceModel model = RaceModel::build(laps, circuitLength, weather, history ? &*history : nullptr);
+
+        StrategySimulator simulator(model);
+        vector<Strategy> strategies = simulator.enumerateStrategies(settings);
+        if (strategies.empty()) {
+            throw invalid_argument("no hay estrategias posibles: " + simulator.emptyReason(settings));
+        }
+        BatchResult result;
+        result.type = "simulate";
+        for (const StrategyResult& strategy : simulator.evaluate(strategies, settings)) {
+            result.rows.push_back({ 0, StrategySimulator::describe(strategy.strategy), {
+                { "stops", static_cast<double>(strategy.strategy.stops()) },
+                { "mean-seconds", strategy.meanSeconds },
+                { "stddev-seconds", strategy.stdDevSeconds },
+                { "lower-seconds", strategy.lowerSeconds },
+                { "upper-seconds", strategy.upperSeconds } } });
+        }
+        return result;
+    });
+}
+
+BatchResult BatchRunner::replay(const vector<string>& fields) {
+    requireFields(fields, 4);
+    if (fields[1] == "compare") {
+        requireFields(fields, 5);
+        int startYear = parseField(fields[3], "ano de inicio");
+        int endYear = parseField(fields[4], "ano final");
+        vector<PointsSystem> systems;
+        string key = "replay|compare|" + to_string(startYear) + "|" + to_string(endYear);
+        // Las opciones clave=valor se aplican a todos los sistemas comparados
+        for (const string& spec : splitFields(fields[2], ';')) {
+            systems.push_back(parseSystem(spec, fields, 5, nullptr));
+            key += "|" + systemKey(systems.back());
+        }
+        return cached(key, [&]() {
+            vector<vector<SeasonChampions>> champions = replayEngine().championsForAll(systems, startYear, endYear);
+            BatchResult result;
+            result.type = "replay";
+            for (size_t i = 0; i < systems.size(); ++i) {
+                size_t driverTitles = 0, teamTitles = 0, changedDrivers = 0, changedTeams = 0;
+                for (const SeasonChampions& season : champions[i]) {
+                    if (season.officialDriverId >= 0) {
+                        ++driverTitles;
+                        changedDrivers += season.driverId != season.officialDriverId;
+                    }
+                    if (season.officialTeamId >= 0) {
+                        ++teamTitles;
+                        changedTeams += season.teamId != season.officialTeamId;
+                    }
+                }
+                result.rows.push_back({ static_cast<int>(i), systems[i].name, {
+                    { "seasons", static_cast<double>(champions[i].size()) },
+                    { "driver-titles-changed", static_cast<double>(changedDrivers) },
+                    { "driver-titles", static_cast<double>(driverTitles) },
+                    { "team-titles-changed", static_cast<double>(changedTeams) },
+                    { "team-titles", static_cast<double>(teamTitles) } } });
+            }
+            return result;
+        });
+    }
+    if (fields[1] == "seasons") {
+        requireFields(fields, 5);
+        int startYear = parseField(fields[3], "ano de inicio");
+        int endYear = parseField(fields[4], "ano final");
+        PointsSystem system = parseSystem(fields[2], fields, 5, nullptr);
+        string key = "replay|seasons|" + to_string(startYear) + "|" + to_string(endYear) + "|" + systemKey(system);
+        return cached(key, [&]() {
+            BatchResult result;
+            result.type = "replay";
+            for (const SeasonChampions& season : replayEngine().champions(system, startYear, endYear)) {
+                result.rows.push_back({ season.year, entityName(true, season.driverId), {
+                    { "driver-id", static_cast<double>(season.driverId) },
+                    { "points", season.driverPoints / 100.0 },
+                    { "official-driver-id", static_cast<double>(season.officialDriverId) },
+                    { "changed", season.officialDriverId >= 0 && season.driverId != season.officialDriverId ? 1.0 : 0.0 },
+                    { "team-id", static_cast<double>(season.teamId) },
+                    { "team-points", season.teamPoints / 100.0 },
+                    { "official-team-id", static_cast<double>(season.officialTeamId) } } });
+            }
+            return result;
+        });
+    }
+    if (fields[1] != "drivers" && fields[1] != "teams") {
+        throw invalid_argument("consulta replay no valida (seasons, drivers, teams o compare): '" + fields[1] + "'");
+    }
+    bool driver = fields[1] == "drivers";
+    int year = parseField(fields[3], "ano");
+    int rounds = 0;
+    PointsSystem system = parseSystem(fields[2], fields, 4, &rounds);
+    string key = "replay|" + fields[1] + "|" + to_string(year) + "|" + to_string(rounds) + "|" + systemKey(system);
+    return cached(key, [&]() {
+        const ChampionshipReplay& engine = replayEngine();
+        BatchResult result;
+        result.type = "replay";
+        for (const ReplayStanding& standing : driver ? engine.driverStandings(system, year, rounds)
+                                                     : engine.teamStandings(system, year, rounds)) {
+            result.rows.push_back({ standing.id, entityName(driver, standing.id), {
+                { "position", static_cast<double>(standing.position) },
+                { "points", standing.points / 100.0 },
+                { "wins", static_cast<double>(standing.wins) } } });
+        }
+        return result;
+    });
+}
+
+const ChampionshipReplay& BatchRunner::replayEngine() {
+    if (sharedReplay) {
+        return *sharedReplay;
+    }
+    if (!championshipReplay) {
+        championshipReplay = make_unique<ChampionshipReplay>(data);
+    }
+    return *championshipReplay;
+}
+
+BatchResult BatchRunner::rating(const vector<string>& queryFields) {
+    vector<string> fields = queryFields;
+    int round = 0;
+    for (size_t i = 1; i < fields.size(); ++i) {
+        if (fields[i].compare(0, 6, "round=") == 0) {
+            round = max(parseField(fields[i].substr(6), "round"), 0);
+            fields.erase(fields.begin() + i);
+            break;
+        }
+    }
+    RatingSettings settings = takeRatingSettings(fields);
+    requireFields(fields, 3);
+    bool driver = fields[1] == "drivers" || fields[1] == "driver";
+    RankingEntity entity = driver ? RankingEntity::Driver : RankingEntity::Constructor;
+    const map<int, pair<size_t, size_t>>& years = data.indexes.yearRange;
+
+    if (fields[1] == "drivers" || fields[1] == "teams") {
+        int year = parseField(fields[2], "ano");
+        size_t count = fields.size() > 3 ? static_cast<size_t>(max(parseField(fields[3], "K"), 0)) : 10;
+        auto range = years.find(year);
+        if (range == years.end()) {
+            throw invalid_argument("no hay carreras en " + to_string(year));
+        }
+        size_t last = round > 0 ? min(range->second.first + round, range->second.second) - 1 : range->second.second - 1;
+        string key = "rating|" + fields[1] + "|" + to_string(year) + "|" + to_string(count) + "|" + to_string(round)
+            + "|" + settings.key();
+        return cached(key, [&]() {
+            BatchResult result;
+            result.type = "rating";
+            for (const RatedEntry& entry : ratingEngine(settings).top(entity, range->second.first, last, count)) {
+                result.rows.push_back({ entry.entityId, entityName(driver, entry.entityId), {
+                    { "rating", entry.rating.rating },
+                    { "deviation", entry.rating.deviation },
+                    { "races", static_cast<double>(entry.rating.races) } } });
+            }
+            return result;
+        });
+    }
+    if (fields[1] != "driver" && fields[1] != "team") {
+        throw invalid_argument("consulta rating no valida (drivers, teams, driver o team): '" + fields[1] + "'");
+    }
+
+    requireFields(fields, 5);
+    int startYear = parseField(fields[3], "ano de inicio");
+    int endYear = parseField(fields[4], "ano final");
+    vector<int> ids = driver ? data.indexes.names.findDrivers(fields[2]) : data.indexes.names.findTeams(fields[2]);
+    if (ids.empty()) {
+        throw invalid_argument(string(driver ? "piloto" : "equipo") + " no encontrado: '" + fields[2] + "'");
+    }
+    sort(ids.begin(), ids.end());
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+    string key = "rating|" + fields[1] + "|" + idList(ids) + "|" + to_string(startYear) + "|" + to_string(endYear)
+        + "|" + settings.key();
+    return cached(key, [&]() {
+        const RatingEngine& engine = ratingEngine(settings);
+        BatchResult result;
+        result.type = "rating";
+        for (int id : ids) {
+            // Una fila por temporada en la que corrio
+            for (auto range = years.lower_bound(startYear); range != years.end() && range->first <= endYear; ++range) {
+                size_t first = range->second.first;
+                size_t last = range->second.second - 1;
+                optional<double> best = engine.peak(entity, id, first, last);
+                if (!best) {
+                    continue;
+                }
+                Rating end = *engine.ratingAt(entity, id, last);
+                optional<Rating> before = first > 0 ? engine.ratingAt(entity, id, first - 1) : nullopt;
+                result.rows.push_back({ id, entityName(driver, id), {
+                    { "year", static_cast<double>(range->first) },
+                    { "rating", end.rating },
+                    { "deviation", end.deviation },
+                    { "change", end.rating - (before ? before->rating : settings.initialRating) },
+                    { "peak", *best },
+                    { "races", static_cast<double>(end.races - (before ? before->races : 0)) } } });
+            }
+        }
+        return result;
+    });
+}
+
+const RatingEngine& BatchRunner::ratingEngine(const RatingSettings& settings) {
+    if (const RatingEngine* shared = sharedRatings ? sharedRatings->get(settings) : nullptr) {
+        return *shared;
+    }
+    unique_ptr<RatingEngine>& engine = ratingEngines[settings.key()];
+    if (!engine) {
+        engine = make_unique<RatingEngine>(data, settings);
+    }
+    return *engine;
+}
+
+BatchResult BatchRunner::teammates(const vector<string>& fields) {
+    requireFields(fields, 3);
+    int startYear = parseField(fields[1], "ano de inicio");
+    int endYear = parseField(fields[2], "ano final");
+    if (startYear > endYear) {
+        throw invalid_argument("el ano de inicio es mayor que el ano final");
+    }
+    vector<int> drivers;
+    if (fields.size() > 3 && !fields[3].empty()) {
+        drivers = data.indexes.names.findDrivers(fields[3]);
+        if (drivers.empty()) {
+            throw invalid_argument("piloto no encontrado: '" + fields[3] + "'");
+        }
+    }
+
+    string key = "teammates|" + to_string(startYear) + "|" + to_string(endYear) + "|" + (drivers.empty() ? "*" : idList(drivers));
+    return cached(key, [&]() {
+        const HeadToHeadEngine& engine = headToHeadEngine();
+        vector<HeadToHead> duels;
+        if (drivers.empty()) {
+            duels = engine.window(startYear, endYear);
+        } else {
+            for (int driverId : drivers) {
+                vector<HeadToHead> own = engine.forDriver(driverId, startYear, endYear);
+                duels.insert(duels.end(), own.begin(), own.end());
+            }
+        }
+
+        BatchResult result;
+        result.type = "teammates";
+        for (const HeadToHead& duel : duels) {
+            result.rows.push_back({ duel.driverId, entityName(true, duel.driverId), {
+                { "teammate-id", static_cast<double>(duel.teammateId) },
+                { "races", static_cast<double>(duel.races) },
+                { "race-ahead", static_cast<double>(duel.raceAhead) },
+                { "race-behind", static_cast<double>(duel.raceBehind) },
+                { "qualifying-ahead", static_cast<double>(duel.qualifyingAhead) },
+                { "qualifying-behind", static_cast<double>(duel.qualifyingBehind) },
+                { "points", duel.points / 100.0 },
+                { "teammate-points", duel.teammatePoints / 100.0 },
+                { "points-share", duel.pointsShare() } } });
+        }
+        return result;
+    });
+}
+
+const HeadToHeadEngine& BatchRunner::headToHeadEngine() {
+    if (sharedHeadToHead) {
+        return *sharedHeadToHead;
+    }
+    if (!ownHeadToHead) {
+        ownHeadToHead = make_unique<HeadToHeadEngine>(data);
+    }
+    return *ownHeadToHead;
+}
+
+BatchResult BatchRunner::cacheStats() {
+    if (!cache) {
+        throw invalid_argument("la cache de consultas no esta activada");
+    }
+    QueryCacheStats stats = cache->stats();
+    uint64_t lookups = stats.hits + stats.misses;
+    BatchResult result;
+    result.type = "cache";
+    result.rows.push_back({ 0, "", {
+        { "hits", static_cast<double>(stats.hits) },
+        { "misses", static_cast<double>(stats.misses) },
+        { "hit-rate", lookups ? static_cast<double>(stats.hits) / lookups : 0.0 },
+        { "entries", static_cast<double>(stats.entries) },
+        { "bytes", static_cast<double>(stats.bytes) },
+        { "capacity", static_cast<double>(stats.capacity) },
+        { "evictions", static_cast<double>(stats.evictions) },
+        { "invalidations", static_cast<double>(stats.invalidations) } } });
+    return result;
+}
+
+BatchResult BatchRunner::cached(const string& key, const function<BatchResult()>& compute) {
+    if (!cache) {
+        return compute();
+    }
+    if (shared_ptr<const BatchResult> stored = cache->find(key, dataVersion)) {
+        return *stored;
+    }
+    BatchResult result = compute();
+    cache->insert(key, dataVersion, make_shared<BatchResult>(result));
+    return result;
+}
+
+optional<int> BatchRunner::findCircuit(const string& name) const {
+    vector<int> ids = data.indexes.names.findCircuits(name);
+    if (ids.empty()) {
+        return nullopt;
+    }
+    return ids.front();
+}
+
+string BatchRunner::entityName(bool driver, int id) const {
+    if (driver) {
+        auto it = data.drivers.find(id);
+        return it != data.drivers.end() ? it->second.fullName.str() : "";
+    }
+    auto it = data.teams.find(id);
+    return it != data.teams.end() ? it->second.name.str() : "";
+}
+
+optional<BatchFormat> BatchRunner::parseFormat(const string& name) {
+    if (name == "json") {
+        return BatchFormat::JsonLines;
+    }
+    if (name == "csv") {
+        return BatchFormat::Csv;
+    }
+    return nullopt;
+}
+
+void BatchRunner::writeJson(ostream& out, size_t query, const BatchResult& result) {
+    out << "{\"query\":" << query << ",\"type\":";
+    writeJsonString(out, result.type);
+    if (!result.error.empty()) {
+        out << ",\"error\":";
+        writeJsonString(out, result.error);
+        out << "}\n";
+        return;
+    }
+
+    out << ",\"results\":[";
+    for (size_t i = 0; i < result.rows.size(); ++i) {
+        const BatchRow& row = result.rows[i];
+        out << (i ? "," : "") << "{\"rank\":" << i + 1 << ",\"id\":" << row.id << ",\"name\":";
+        writeJsonString(out, row.name);
+        for (const auto& value : row.values) {
+            out << ",";
+            writeJsonString(out, value.first);
+            out << ":";
+            writeNumber(out, value.second);
+        }
+        out << "}";
+    }
+    out << "]}\n";
+}
+
+void BatchRunner::writeCsv(ostream& out, size_t query, const BatchResult& result) {
+    if (!result.error.empty()) {
+        out << query << ",error,,,";
+        writeCsvField(out, result.type);
+        out << ",message,";
+        writeCsvField(out, result.error);
+        out << "\n";
+        return;
+    }
+
+    for (size_t i = 0; i < result.rows.size(); ++i) {
+        const BatchRow& row = result.rows[i];
+        for (const auto& value : row.values) {
+            out << query << "," << result.type << "," << i + 1 << "," << row.id << ",";
+            writeCsvField(out, row.name);
+            out << "," << value.first << ",";
+            writeNumber(out, value.second);
+            out << "\n";
+        }
+    }
+}
@@ -0,0 +1,152 @@
+#ifndef BATCH_RUNNER_HPP
+#define BATCH_RUNNER_HPP
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <optional>
+#include <utility>
+#include <functional>
+#include <cstdint>
+#include <memory>
+#include <map>
+#include "Dataset.hpp"
+#include "RankingEngine.hpp"
+#include "ResultsPredictor.hpp"
+#include "DrivingAnalysis.hpp"
+#include "PitStopAnalysis.hpp"
+#include "QualifyingAnalysis.hpp"
+
+using namespace std;
+
+class QueryCache;
+class ChampionshipReplay;
+class RatingEngine;
+class RatingEngineSet;
+class HeadToHeadEngine;
+struct RatingSettings;
+
+enum class BatchFormat { JsonLines, Csv };
+
+// Resultado de una consulta por lotes: filas con id, nombre y valores con nombre
+struct BatchRow {
+    int id;
+    string name;
+    vector<pair<string, double>> values;
+};
+
+struct BatchResult {
+    string type;
+    vector<BatchRow> rows;
+    string error;  // vacio si la consulta fue correcta
+};
+
+// Modo por lotes: ejecuta consultas sobre un Dataset ya cargado, sin menu.
+// Cada linea es una consulta con campos separados por '|':
+//   drivers|<circuito o vacio>|<nombre>|<nombre>...   prediccion de pilotos
+//   teams|<circuito o vacio>|<nombre>|<nombre>...     prediccion de equipos
+//     (en ambas, los campos clave=valor ajustan el peso: weighting=log|half-life|linear,
+//      reference=<ano>, halflife=<anos>, span=<anos>, qualifying=<peso del ritmo a una vuelta>,
+//      reliability=<peso de la tasa de averias>)
+//   top|driver o team|<metrica>|<K>|<inicio>|<fin>[|<nacionalidad>[|<circuito>]]
+//   stats|drivers o teams|<inicio>|<fin>              top 5 con max/min/media/desviacion
+//     (en top y stats, sessions=race|sprint|all elige que puntos cuentan; por defecto all.
+//      Los equipos de stats usan las clasificaciones oficiales, que ya incluyen los sprints)
+//   impact                                            correlacion salida/llegada
+//   correlation|all, circuits, seasons o constructors[|<inicio>|<fin>]
+//                                                     Pearson y Spearman salida/llegada por grupo
+//   correlation|matrix|<inicio>|<fin>[|<circuito>]    probabilidad de cada llegada por posicion de salida
+//   reliability|all, constructors, drivers, seasons o circuits[|<inicio>|<fin>]
+//                                                     llegadas, averias, accidentes y abandonos por grupo
+//   reliability|causes|<inicio>|<fin>[|<equipo>]      causas de abandono de mas a menos frecuente
+//   pitstops|circuits|<circuito o vacio>              paradas tipicas, vueltas y undercut por circuito
+//   pitstops|teams|<inicio>|<fin>                     mediana del tiempo en boxes por equipo
+//   qualifying|race|<ano>|<circuito>                  distancia a la pole de cada piloto
+//   qualifying|teammates|<inicio>|<fin>               duelos a una vuelta entre companeros
+//   qualifying|season|<ano>                           ranking de ritmo a una vuelta
+//   simulate|<circuito o vacio>|<vueltas>|<km>|<clima>  mejores estrategias de neumaticos (Monte Carlo);
+//     campos clave=valor: runs=<carreras>, seed=<semilla>, stops=<max paradas>,
+//     step=<vueltas entre paradas candidatas>, top=<estrategias devueltas>
+//   replay|seasons|<sistema>|<inicio>|<fin>          campeones de cada temporada con otro sistema de puntos
+//   replay|drivers o teams|<sistema>|<ano>            clasificacion final (round=<N>: tras N carreras)
+//   replay|compare|<sistema>;<sistema>...|<inicio>|<fin>  titulos que cambian con cada sistema
+//     (sistema: official, wins, 1950, 1960, 1961, 1991, 2003, 2010, 2019, 2021, 2022 o
+//      "25,18,15,..."; campos clave=valor: sprint=<sistema o tabla>, fastest=<puntos>,
+//      fastest-top=<posicion maxima>, best=<resultados que cuentan>; en compare valen para todos los sistemas)
+//   rating|drivers o teams|<ano>[|<K>]                K mejores puntuaciones Elo/Glicko al final del ano
+//                                                     entre quienes corrieron ese ano (round=<N>: tras N carreras)
+//   rating|driver o team|<nombre>|<inicio>|<fin>      puntuacion al final de cada temporada y maximo en ella
+//     (campos clave=valor: model=glicko|elo, initial=<puntuacion inicial>, k=<factor K de Elo>,
+//      c=<crecimiento de la desviacion de Glicko por carrera>, mechanical=ignore|count)
+//   teammates|<inicio>|<fin>[|<piloto>]               duelos entre companeros (carrera, clasificacion
+//                                                     y parte de los puntos); con piloto, solo los suyos
+//   cache                                             aciertos/fallos de la cache de consultas
+// Las lineas vacias y las que empiezan por '#' se ignoran.
+// Con una QueryCache, los resultados se guardan bajo la consulta normalizada:
+// nombres y circuitos resueltos a ids, opciones con sus valores efectivos.
+// "HAM" y "lewis hamilton" comparten entrada, igual que el mismo conjunto de
+// nombres en otro orden.
+// La salida es una linea JSON por consulta o CSV en formato largo
+// (query,type,rank,id,name,field,value).
+class BatchRunner {
+public:
+    // 'dataVersion' identifica los datos en la cache: debe cambiar cuando cambien.
+    // 'ratings' (opcional) son motores de puntuaciones compartidos entre
+    // ejecuciones; si falta, o no admite mas parametros, se construye uno propio.
+    // Igual con 'headToHead' y 'replay'.
+    BatchRunner(const Dataset& data, const RankingEngine& ranking, QueryCache* cache = nullptr, uint64_t dataVersion = 0,
+        RatingEngineSet* ratings = nullptr, const HeadToHeadEngine* headToHead = nullptr,
+        const ChampionshipReplay* replay = nullptr);
+    ~BatchRunner();
+
+    // Procesa todas las consultas de 'in'. Devuelve el numero de consultas con error.
+    size_t run(istream& in, ostream& out, BatchFormat format);
+
+    // Ejecuta una consulta (una linea)
+    BatchResult execute(const string& line);
+
+    static optional<BatchFormat> parseFormat(const string& name);
+    static void writeJson(ostream& out, size_t query, const BatchResult& result);
+    static void writeCsv(ostream& out, size_t query, const BatchResult& result);
+
+private:
+    const Dataset& data;
+    const RankingEngine& ranking;
+    QueryCache* cache;
+    uint64_t dataVersion;
+    ResultsPredictor predictor;
+    DrivingAnalysis analysis;
+    PitStopAnalysis pitStopAnalysis;
+    QualifyingAnalysis qualifyingAnalysis;
+    const ChampionshipReplay* sharedReplay;
+    unique_ptr<ChampionshipReplay> championshipReplay;  // Si no hay uno compartido, se prepara en la primera consulta replay
+    RatingEngineSet* sharedRatings;
+    map<string, unique_ptr<RatingEngine>> ratingEngines;  // Clave: RatingSettings::key()
+    const HeadToHeadEngine* sharedHeadToHead;
+    unique_ptr<HeadToHeadEngine> ownHeadToHead;  // Si no hay uno compartido, se prepara en la primera consulta
+
+    // Devuelve el resultado guardado para 'key' o lo calcula y lo guarda
+    BatchResult cached(const string& key, const function<BatchResult()>& compute);
+
+    BatchResult predict(const vector<string>& fields);
+    BatchResult top(const vector<string>& fields);
+    BatchResult stats(const vector<string>& fields);
+    BatchResult impact();
+    BatchResult pitStops(const vector<string>& fields);
+    BatchResult correlation(const vector<string>& fields);
+    BatchResult reliability(const vector<string>& fields);
+    BatchResult qualifying(const vector<string>& fields);
+    BatchResult simulate(const vector<string>& fields);
+    BatchResult replay(const vector<string>& fields);
+    const ChampionshipReplay& replayEngine();
+    BatchResult rating(const vector<string>& fields);
+    const RatingEngine& ratingEngine(const RatingSettings& settings);
+    BatchResult teammates(const vector<string>& fields);
+    const HeadToHeadEngine& headToHeadEngine();
+    BatchResult cacheStats();
+    optional<int> findCircuit(const string& name) const;
+    string entityName(bool driver, int id) const;
+};
+
+#endif // BATCH_RUNNER_HPP
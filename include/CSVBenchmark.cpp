@@ -0,0 +1,87 @@
+#include "CSVBenchmark.hpp"
+#include "CSVReader.hpp"
+#include "MappedCSVReader.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <filesystem>
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Tiempo de la mejor iteracion en milisegundos
+template <typename Fn>
+double bestTimeMs(int iterations, Fn&& fn) {
+    double best = 0;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        if (i == 0 || elapsed.count() < best) {
+            best = elapsed.count();
+        }
+    }
+    return best;
+}
+
+}
+
+void CSVBenchmark::run(const string& directory, int iterations) {
+    vector<string> files;
+    for (const auto& entry : filesystem::directory_iterator(directory)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".csv") {
+            files.push_back(entry.path().string());
+        }
+    }
+    sort(files.begin(), files.end());
+
+    cout << left << setw(40) << "Fichero" << right << setw(10) << "Filas"
+         << setw(14) << "readCSV (ms)" << setw(14) << "mmap (ms)" << setw(10) << "Mejora" << "\n";
+
+    double totalOld = 0;
+    double totalNew = 0;
+    for (const auto& file : files) {
+        size_t oldRows = 0;
+        size_t newRows = 0;
+        size_t checksum = 0;
+
+        double oldMs = bestTimeMs(iterations, [&]() {
+            CSVReader reader;
+            vector<vector<string>> data = reader.readCSV(file);
+            oldRows = data.size();
+            for (const auto& row : data) {
+                checksum += row.size();
+            }
+        });
+
+        double newMs = bestTimeMs(iterations, [&]() {
+            MappedCSVReader reader(file);
+            vector<string_view> row;
+            newRows = 0;
+            while (reader.nextRow(row)) {
+                ++newRows;
+                checksum += row.size();
+            }
+        });
+
+        totalOld += oldMs;
+        totalNew += newMs;
+        cout << left << setw(40) << filesystem::path(file).filename().string() << right << setw(10) << newRows
+             << fixed << setprecision(3) << setw(14) << oldMs << setw(14) << newMs
+             << setprecision(1) << setw(9) << (newMs > 0 ? oldMs / newMs : 0) << "x";
+        if (oldRows != newRows) {
+            cout << "  (filas distintas: " << oldRows << ")";
+        }
+        cout << "\n";
+        cout.unsetf(ios::fixed);
+        (void)checksum;
+    }
+
+    cout << left << setw(50) << "Total" << right << fixed << setprecision(3)
+         << setw(14) << totalOld << setw(14) << totalNew
+         << setprecision(1) << setw(9) << (totalNew > 0 ? totalOld / totalNew : 0) << "x\n";
+    cout.unsetf(ios::fixed);
+}
@@ -0,0 +1,15 @@
+#ifndef CSV_BENCHMARK_HPP
+#define CSV_BENCHMARK_HPP
+
+#include <string>
+
+using namespace std;
+
+// Compara el lector antiguo (CSVReader::readCSV) con MappedCSVReader
+// sobre todos los ficheros .csv de un directorio.
+class CSVBenchmark {
+public:
+    void run(const string& directory, int iterations = 5);
+};
+
+#endif // CSV_BENCHMARK_HPP
@@ -0,0 +1,538 @@
+#include "ChampionshipReplay.hpp"
+#include "ThreadPool.hpp"
+#include "FieldParser.hpp"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+vector<int32_t> hundredths(initializer_list<int> points) {
+    vector<int32_t> table;
+    for (int value : points) {
+        table.push_back(value * 100);
+    }
+    return table;
+}
+
+// Lider de la clasificacion en la ultima carrera del ano con datos (-1 si no
+// consta). Solo puede serlo quien corrio ese ano: basta con los huecos 'slots'
+template <typename Standing, typename OrderOf>
+int officialChampion(const map<int, vector<const Standing*>>& standingsByEntity, const vector<int32_t>& entityOfSlot,
+    pair<int32_t, int32_t> slots, int year, const OrderOf& orderOf) {
+    int champion = -1;
+    int32_t championOrder = -1;
+    for (int32_t slot = slots.first; slot < slots.second; ++slot) {
+        auto standings = standingsByEntity.find(entityOfSlot[slot]);
+        if (standings == standingsByEntity.end()) {
+            continue;
+        }
+        for (const Standing* standing : standings->second) {
+            if (standing->race && standing->race->year == year && standing->position == 1) {
+                int32_t order = orderOf(standing->race->raceId);
+                if (order > championOrder) {
+                    championOrder = order;
+                    champion = entityOfSlot[slot];
+                }
+            }
+        }
+    }
+    return champion;
+}
+
+}
+
+vector<string> PointsSystem::presetNames() {
+    return { "official", "wins", "1950", "1960", "1961", "1991", "2003", "2010", "2019", "2021", "2022" };
+}
+
+optional<PointsSystem> PointsSystem::preset(const string& name) {
+    PointsSystem system;
+    system.name = name;
+    if (name == "official") {
+        system.official = true;
+    } else if (name == "wins") {
+        system.race = hundredths({ 1 });
+    } else if (name == "1950") {
+        system.race = hundredths({ 8, 6, 4, 3, 2 });
+        system.fastestLap = 100;
+    } else if (name == "1960") {
+        system.race = hundredths({ 8, 6, 4, 3, 2, 1 });
+    } else if (name == "1961") {
+        system.race = hundredths({ 9, 6, 4, 3, 2, 1 });
+    } else if (name == "1991") {
+        system.race = hundredths({ 10, 6, 4, 3, 2, 1 });
+    } else if (name == "2003") {
+        system.race = hundredths({ 10, 8, 6, 5, 4, 3, 2, 1 });
+    } else if (name == "2010" || name == "2019" || name == "2021" || name == "2022") {
+        system.race = hundredths({ 25, 18, 15, 12, 10, 8, 6, 4, 2, 1 });
+        if (name != "2010") {
+            system.fastestLap = 100;
+            system.fastestLapTop = 10;
+        }
+        if (name == "2021") {
+            system.sprint = hundredths({ 3, 2, 1 });
+        } else if (name == "2022") {
+            system.sprint = hundredths({ 8, 7, 6, 5, 4, 3, 2, 1 });
+        }
+    } else {
+        return nullopt;
+    }
+    return system;
+}
+
+optional<PointsSystem> PointsSystem::parse(const string& spec) {
+    if (optional<PointsSystem> system = preset(spec)) {
+        return system;
+    }
+    PointsSystem system;
+    system.name = spec;
+    size_t start = 0;
+    while (start <= spec.size()) {
+        size_t comma = spec.find(',', start);
+        string_view item(spec.data() + start, (comma == string::npos ? spec.size() : comma) - start);
+        int32_t points;
+        if (!FieldParser::parsePoints(item, points) || points < 0) {
+            return nullopt;
+        }
+        system.race.push_back(points);
+        if (comma == string::npos) {
+            break;
+        }
+        start = comma + 1;
+    }
+    return system;
+}
+
+ChampionshipReplay::ChampionshipReplay(const Dataset& data) {
+    vector<uint32_t> rows(data.results.size());
+    for (size_t row = 0; row < rows.size(); ++row) {
+        rows[row] = static_cast<uint32_t>(row);
+    }
+    build(data, 0, move(rows));
+}
+
+void ChampionshipReplay::appendResults(const Dataset& data, size_t firstRow) {
+    const ResultsTable& table = data.results;
+    optional<int> firstYear;
+    vector<uint32_t> rows;
+    for (size_t row = firstRow; row < table.size(); ++row) {
+        auto race = data.races.find(table.raceId[row]);
+        if (race != data.races.end() && (!firstYear || race->second.year < *firstYear)) {
+            firstYear = race->second.year;
+        }
+        rows.push_back(static_cast<uint32_t>(row));
+    }
+    if (!firstYear) {
+        return;
+    }
+    // Las temporadas anteriores a la primera con filas nuevas no cambian
+    size_t firstSeason = static_cast<size_t>(
+        lower_bound(seasonYears.begin(), seasonYears.end(), *firstYear) - seasonYears.begin());
+    build(data, firstSeason, move(rows));
+}
+
+// Descarta las temporadas desde firstSeason y las vuelve a construir con sus
+// filas y con 'rows' (filas de ResultsTable que aun no tienen evento)
+void ChampionshipReplay::build(const Dataset& data, size_t firstSeason, vector<uint32_t> rows) {
+    const DataIndexes& indexes = data.indexes;
+
+    size_t firstEvent = eventRow.size();
+    int32_t firstDriverSlot = static_cast<int32_t>(driverOfSlot.size());
+    int32_t firstTeamSlot = static_cast<int32_t>(teamOfSlot.size());
+    if (firstSeason < seasonYears.size()) {
+        firstEvent = seasonEvents[firstSeason].first;
+        firstDriverSlot = seasonDriverSlots[firstSeason].first;
+        firstTeamSlot = seasonTeamSlots[firstSeason].first;
+    }
+    rows.insert(rows.end(), eventRow.begin() + firstEvent, eventRow.end());
+    eventRow.resize(firstEvent);
+    eventDriverSlot.resize(firstEvent);
+    eventTeamSlot.resize(firstEvent);
+    eventPosition.resize(firstEvent);
+    eventPoints.resize(firstEvent);
+    eventFlags.resize(firstEvent);
+    eventRound.resize(firstEvent);
+    seasonYears.resize(firstSeason);
+    seasonEvents.resize(firstSeason);
+    seasonDriverSlots.resize(firstSeason);
+    seasonTeamSlots.resize(firstSeason);
+    officialDriverChampion.resize(firstSeason);
+    officialTeamChampion.resize(firstSeason);
+    driverOfSlot.resize(firstDriverSlot);
+    teamOfSlot.resize(firstTeamSlot);
+    driverCountback.resize(static_cast<size_t>(firstDriverSlot) * COUNTBACK_POSITIONS);
+    teamCountback.resize(static_cast<size_t>(firstTeamSlot) * COUNTBACK_POSITIONS);
+    slotEventOffsets.resize(static_cast<size_t>(firstDriverSlot) + 1);
+    slotEvents.resize(slotEventOffsets.back());
+
+    // Orden de cada carrera en el calendario completo
+    int maxRaceId = data.races.empty() ? 0 : max(0, data.races.rbegin()->first);
+    vector<int32_t> raceOrder(static_cast<size_t>(maxRaceId) + 1, -1);
+    for (size_t i = 0; i < indexes.racesByDate.size(); ++i) {
+        if (indexes.racesByDate[i]->raceId >= 0) {
+            raceOrder[indexes.racesByDate[i]->raceId] = static_cast<int32_t>(i);
+        }
+    }
+    auto orderOf = [&](int raceId) {
+        return raceId >= 0 && raceId <= maxRaceId ? raceOrder[raceId] : -1;
+    };
+
+    // Filas de carrera y de sprint ordenadas por (carrera, sesion, fila)
+    struct Source {
+        int32_t order;
+        bool sprint;
+        uint32_t row;
+    };
+    const ResultsTable& table = data.results;
+    vector<Source> sources;
+    sources.reserve(rows.size());
+    for (uint32_t row : rows) {
+        int32_t order = orderOf(table.raceId[row]);
+        if (order >= 0 && table.driverId[row] >= 0) {
+            bool sprint = table.session[row] == static_cast<uint8_t>(Session::Sprint);
+            sources.push_back({ order, sprint, row });
+        }
+    }
+    sort(sources.begin(), sources.end(), [](const Source& a, const Source& b) {
+        if (a.order != b.order) return a.order < b.order;
+        if (a.sprint != b.sprint) return a.sprint;
+        return a.row < b.row;
+    });
+
+    size_t events = firstEvent + sources.size();
+    eventRow.reserve(events);
+    eventDriverSlot.reserve(events);
+    eventTeamSlot.reserve(events);
+    eventPosition.reserve(events);
+    eventPoints.reserve(events);
+    eventFlags.reserve(events);
+    eventRound.reserve(events);
+
+    // Hueco de cada piloto/equipo en la temporada en curso; seasonOf evita limpiar los vectores
+    vector<int32_t> driverSlotOf, teamSlotOf, driverSeasonOf, teamSeasonOf;
+    auto slotFor = [](vector<int32_t>& slotOf, vector<int32_t>& seasonOf, vector<int32_t>& entityOfSlot,
+                      int id, int32_t season) {
+        if (static_cast<size_t>(id) >= slotOf.size()) {
+            slotOf.resize(static_cast<size_t>(id) + 1, -1);
+            seasonOf.resize(static_cast<size_t>(id) + 1, -1);
+        }
+        if (seasonOf[id] != season) {
+            seasonOf[id] = season;
+            slotOf[id] = static_cast<int32_t>(entityOfSlot.size());
+            entityOfSlot.push_back(id);
+        }
+        return slotOf[id];
+    };
+
+    int32_t previousOrder = -1;
+    int32_t round = 0;
+    size_t raceStart = firstEvent;
+    // Marca la vuelta rapida de la carrera que acaba de terminar (eventos [raceStart, fin))
+    auto closeRace = [&]() {
+        int32_t best = -1;
+        size_t bestEvent = 0;
+        for (size_t e = raceStart; e < eventRow.size(); ++e) {
+            int32_t lap = (eventFlags[e] & SPRINT_EVENT) ? -1 : table.fastestLapMs[eventRow[e]];
+            if (lap > 0 && (best < 0 || lap < best)) {
+                best = lap;
+                bestEvent = e;
+            }
+        }
+        if (best > 0) {
+            eventFlags[bestEvent] |= FASTEST_LAP_EVENT;
+        }
+    };
+
+    for (const Source& source : sources) {
+        const Race* race = indexes.racesByDate[source.order];
+        size_t e = eventRow.size();
+
+        if (source.order != previousOrder) {
+            if (previousOrder >= 0) {
+                closeRace();
+            }
+            raceStart = e;
+            if (seasonYears.size() == firstSeason || seasonYears.back() != race->year) {
+                if (seasonYears.size() > firstSeason) {
+                    seasonEvents.back().second = e;
+                    seasonDriverSlots.back().second = static_cast<int32_t>(driverOfSlot.size());
+                    seasonTeamSlots.back().second = static_cast<int32_t>(teamOfSlot.size());
+                }
+                seasonYears.push_back(race->year);
+                seasonEvents.push_back({ e, e });
+                seasonDriverSlots.push_back({ static_cast<int32_t>(driverOfSlot.size()), 0 });
+                seasonTeamSlots.push_back({ static_cast<int32_t>(teamOfSlot.size()), 0 });
+                round = 0;
+            }
+            ++round;
+            previousOrder = source.order;
+        }
+
+        int32_t season = static_cast<int32_t>(seasonYears.size() - 1);
+        int32_t driverSlot = slotFor(driverSlotOf, driverSeasonOf, driverOfSlot, table.driverId[source.row], season);
+        int32_t teamSlot = -1;
+        if (race->year >= FIRST_CONSTRUCTORS_YEAR && table.constructorId[source.row] >= 0) {
+            teamSlot = slotFor(teamSlotOf, teamSeasonOf, teamOfSlot, table.constructorId[source.row], season);
+        }
+
+        eventRow.push_back(source.row);
+        eventDriverSlot.push_back(driverSlot);
+        eventTeamSlot.push_back(teamSlot);
+        eventPosition.push_back(static_cast<int16_t>(table.position[source.row]));
+        eventPoints.push_back(table.points[source.row]);
+        eventFlags.push_back(source.sprint ? SPRINT_EVENT : 0);
+        eventRound.push_back(round);
+    }
+    if (previousOrder >= 0) {
+        closeRace();
+        seasonEvents.back().second = events;
+        seasonDriverSlots.back().second = static_cast<int32_t>(driverOfSlot.size());
+        seasonTeamSlots.back().second = static_cast<int32_t>(teamOfSlot.size());
+    }
+
+    // Desempate (posiciones en carrera, no en sprint) y filas de carrera de cada piloto
+    driverCountback.resize(driverOfSlot.size() * COUNTBACK_POSITIONS, 0);
+    teamCountback.resize(teamOfSlot.size() * COUNTBACK_POSITIONS, 0);
+    slotEventOffsets.resize(driverOfSlot.size() + 1, 0);
+    for (size_t e = firstEvent; e < events; ++e) {
+        if (eventFlags[e] & SPRINT_EVENT) {
+            continue;
+        }
+        ++slotEventOffsets[eventDriverSlot[e] + 1];
+        int position = eventPosition[e];
+        if (position >= 1 && position <= COUNTBACK_POSITIONS) {
+            ++driverCountback[static_cast<size_t>(eventDriverSlot[e]) * COUNTBACK_POSITIONS + position - 1];
+            if (eventTeamSlot[e] >= 0) {
+                ++teamCountback[static_cast<size_t>(eventTeamSlot[e]) * COUNTBACK_POSITIONS + position - 1];
+            }
+        }
+    }
+    for (size_t slot = static_cast<size_t>(firstDriverSlot); slot < driverOfSlot.size(); ++slot) {
+        slotEventOffsets[slot + 1] += slotEventOffsets[slot];
+    }
+    slotEvents.resize(slotEventOffsets.back());
+    vector<uint32_t> next(slotEventOffsets.begin() + firstDriverSlot, slotEventOffsets.end() - 1);
+    for (size_t e = firstEvent; e < events; ++e) {
+        if (!(eventFlags[e] & SPRINT_EVENT)) {
+            slotEvents[next[eventDriverSlot[e] - firstDriverSlot]++] = static_cast<uint32_t>(e);
+        }
+    }
+
+    // Campeones oficiales: lider de la clasificacion en la ultima carrera con datos de cada temporada
+    for (size_t season = firstSeason; season < seasonYears.size(); ++season) {
+        officialDriverChampion.push_back(officialChampion(indexes.standingsByDriver, driverOfSlot,
+            seasonDriverSlots[season], seasonYears[season], orderOf));
+        officialTeamChampion.push_back(officialChampion(indexes.standingsByTeam, teamOfSlot,
+            seasonTeamSlots[season], seasonYears[season], orderOf));
+    }
+}
+
+optional<size_t> ChampionshipReplay::seasonIndex(int year) const {
+    auto it = lower_bound(seasonYears.begin(), seasonYears.end(), year);
+    if (it == seasonYears.end() || *it != year) {
+        return nullopt;
+    }
+    return static_cast<size_t>(it - seasonYears.begin());
+}
+
+int32_t ChampionshipReplay::eventScore(const PointsSystem& system, size_t event) const {
+    if (system.official) {
+        return eventPoints[event];
+    }
+    bool sprint = eventFlags[event] & SPRINT_EVENT;
+    const vector<int32_t>& table = sprint ? system.sprint : system.race;
+    int position = eventPosition[event];
+    int32_t score = position >= 1 && static_cast<size_t>(position) <= table.size() ? table[position - 1] : 0;
+    if (!sprint && system.fastestLap && (eventFlags[event] & FASTEST_LAP_EVENT)
+        && (system.fastestLapTop == 0 || (position >= 1 && position <= system.fastestLapTop))) {
+        score += system.fastestLap;
+    }
+    return score;
+}
+
+void ChampionshipReplay::accumulate(const PointsSystem& system, size_t first, size_t last, int rounds,
+    vector<int64_t>& driverPoints, vector<int64_t>& teamPoints) const {
+    bool dropScores = system.bestResults > 0;
+    for (size_t e = first; e < last; ++e) {
+        if (rounds > 0 && eventRound[e] > rounds) {
+            break;
+        }
+        int32_t score = eventScore(system, e);
+        if (score == 0) {
+            continue;
+        }
+        // Con descartes, los puntos de carrera de los pilotos se suman despues
+        if (!dropScores || (eventFlags[e] & SPRINT_EVENT)) {
+            driverPoints[eventDriverSlot[e]] += score;
+        }
+        if (eventTeamSlot[e] >= 0) {
+            teamPoints[eventTeamSlot[e]] += score;
+        }
+    }
+    if (!dropScores || first == last) {
+        return;
+    }
+
+    // N mejores resultados de carrera de cada piloto de la temporada
+    int32_t firstSlot = eventDriverSlot[first];
+    int32_t lastSlot = eventDriverSlot[first];
+    for (size_t e = first; e < last; ++e) {
+        firstSlot = min(firstSlot, eventDriverSlot[e]);
+        lastSlot = max(lastSlot, eventDriverSlot[e]);
+    }
+    vector<int32_t> scores;
+    for (int32_t slot = firstSlot; slot <= lastSlot; ++slot) {
+        scores.clear();
+        for (uint32_t i = slotEventOffsets[slot]; i < slotEventOffsets[slot + 1]; ++i) {
+            uint32_t e = slotEvents[i];
+            if (rounds > 0 && eventRound[e] > rounds) {
+                break;
+            }
+            scores.push_back(eventScore(system, e));
+        }
+        size_t kept = min(scores.size(), static_cast<size_t>(system.bestResults));
+        partial_sort(scores.begin(), scores.begin() + kept, scores.end(), greater<int32_t>());
+        for (size_t i = 0; i < kept; ++i) {
+            driverPoints[slot] += scores[i];
+        }
+    }
+}
+
+// Mas puntos; a igualdad, mas victorias, mas segundos puestos...; por ultimo el id menor
+bool ChampionshipReplay::better(const vector<int64_t>& points, const vector<uint16_t>& countback,
+    const vector<int32_t>& entityOfSlot, int32_t a, int32_t b) const {
+    if (points[a] != points[b]) {
+        return points[a] > points[b];
+    }
+    const uint16_t* countsA = countback.data() + static_cast<size_t>(a) * COUNTBACK_POSITIONS;
+    const uint16_t* countsB = countback.data() + static_cast<size_t>(b) * COUNTBACK_POSITIONS;
+    for (int position = 0; position < COUNTBACK_POSITIONS; ++position) {
+        if (countsA[position] != countsB[position]) {
+            return countsA[position] > countsB[position];
+        }
+    }
+    return entityOfSlot[a] < entityOfSlot[b];
+}
+
+vector<ReplayStanding> ChampionshipReplay::standings(const vector<int64_t>& points, pair<int32_t, int32_t> slots,
+    const vector<int32_t>& entityOfSlot, const vector<uint16_t>& countback) const {
+    vector<int32_t> order;
+    for (int32_t slot = slots.first; slot < slots.second; ++slot) {
+        order.push_back(slot);
+    }
+    sort(order.begin(), order.end(), [&](int32_t a, int32_t b) { return better(points, countback, entityOfSlot, a, b); });
+
+    vector<ReplayStanding> table;
+    for (size_t i = 0; i < order.size(); ++i) {
+        int32_t slot = order[i];
+        table.push_back({ entityOfSlot[slot], points[slot], countback[static_cast<size_t>(slot) * COUNTBACK_POSITIONS],
+            static_cast<int>(i + 1) });
+    }
+    return table;
+}
+
+vector<uint16_t> ChampionshipReplay::partialCountback(size_t season, int rounds, bool driver) const {
+    vector<uint16_t> countback((driver ? driverOfSlot.size() : teamOfSlot.size()) * COUNTBACK_POSITIONS, 0);
+    for (size_t e = seasonEvents[season].first; e < seasonEvents[season].second && eventRound[e] <= rounds; ++e) {
+        int32_t slot = driver ? eventDriverSlot[e] : eventTeamSlot[e];
+        int position = eventPosition[e];
+        if (slot >= 0 && !(eventFlags[e] & SPRINT_EVENT) && position >= 1 && position <= COUNTBACK_POSITIONS) {
+            ++countback[static_cast<size_t>(slot) * COUNTBACK_POSITIONS + position - 1];
+        }
+    }
+    return countback;
+}
+
+vector<ReplayStanding> ChampionshipReplay::driverStandings(const PointsSystem& system, int year, int rounds) const {
+    optional<size_t> season = seasonIndex(year);
+    if (!season) {
+        return {};
+    }
+    vector<int64_t> driverPoints(driverOfSlot.size(), 0);
+    vector<int64_t> teamPoints(teamOfSlot.size(), 0);
+    accumulate(system, seasonEvents[*season].first, seasonEvents[*season].second, rounds, driverPoints, teamPoints);
+    if (rounds > 0) {
+        return standings(driverPoints, seasonDriverSlots[*season], driverOfSlot, partialCountback(*season, rounds, true));
+    }
+    return standings(driverPoints, seasonDriverSlots[*season], driverOfSlot, driverCountback);
+}
+
+vector<ReplayStanding> ChampionshipReplay::teamStandings(const PointsSystem& system, int year, int rounds) const {
+    optional<size_t> season = seasonIndex(year);
+    if (!season) {
+        return {};
+    }
+    vector<int64_t> driverPoints(driverOfSlot.size(), 0);
+    vector<int64_t> teamPoints(teamOfSlot.size(), 0);
+    accumulate(system, seasonEvents[*season].first, seasonEvents[*season].second, rounds, driverPoints, teamPoints);
+    if (rounds > 0) {
+        return standings(teamPoints, seasonTeamSlots[*season], teamOfSlot, partialCountback(*season, rounds, false));
+    }
+    return standings(teamPoints, seasonTeamSlots[*season], teamOfSlot, teamCountback);
+}
+
+vector<SeasonChampions> ChampionshipReplay::champions(const PointsSystem& system, int startYear, int endYear) const {
+    vector<SeasonChampions> result;
+    auto first = lower_bound(seasonYears.begin(), seasonYears.end(), startYear);
+    auto last = upper_bound(seasonYears.begin(), seasonYears.end(), endYear);
+    if (first >= last) {
+        return result;
+    }
+    size_t firstSeason = first - seasonYears.begin();
+    size_t lastSeason = last - seasonYears.begin();
+
+    // Las temporadas ocupan huecos consecutivos, asi que basta una pasada por todo el tramo
+    vector<int64_t> driverPoints(driverOfSlot.size(), 0);
+    vector<int64_t> teamPoints(teamOfSlot.size(), 0);
+    if (system.bestResults > 0) {
+        for (size_t season = firstSeason; season < lastSeason; ++season) {
+            accumulate(system, seasonEvents[season].first, seasonEvents[season].second, 0, driverPoints, teamPoints);
+        }
+    } else {
+        accumulate(system, seasonEvents[firstSeason].first, seasonEvents[lastSeason - 1].second, 0, driverPoints, teamPoints);
+    }
+
+    for (size_t season = firstSeason; season < lastSeason; ++season) {
+        SeasonChampions champion{ seasonYears[season], -1, 0, -1, 0, officialDriverChampion[season], officialTeamChampion[season] };
+        pair<int32_t, int32_t> drivers = seasonDriverSlots[season];
+        int32_t best = -1;
+        for (int32_t slot = drivers.first; slot < drivers.second; ++slot) {
+            if (best < 0 || better(driverPoints, driverCountback, driverOfSlot, slot, best)) {
+                best = slot;
+            }
+        }
+        if (best >= 0) {
+            champion.driverId = driverOfSlot[best];
+            champion.driverPoints = driverPoints[best];
+        }
+
+        pair<int32_t, int32_t> teams = seasonTeamSlots[season];
+        best = -1;
+        for (int32_t slot = teams.first; slot < teams.second; ++slot) {
+            if (best < 0 || better(teamPoints, teamCountback, teamOfSlot, slot, best)) {
+                best = slot;
+            }
+        }
+        if (best >= 0) {
+            champion.teamId = teamOfSlot[best];
+            champion.teamPoints = teamPoints[best];
+        }
+        result.push_back(champion);
+    }
+    return result;
+}
+
+vector<vector<SeasonChampions>> ChampionshipReplay::championsForAll(const vector<PointsSystem>& systems, int startYear,
+    int endYear, size_t threads) const {
+    vector<vector<SeasonChampions>> results(systems.size());
+    ThreadPool pool(threads == 0 ? thread::hardware_concurrency() : threads);
+    vector<future<void>> tasks;
+    for (size_t i = 0; i < systems.size(); ++i) {
+        tasks.push_back(pool.submit([&, i]() { results[i] = champions(systems[i], startYear, endYear); }));
+    }
+    for (auto& task : tasks) {
+        task.get();
+    }
+    return results;
+}
@@ -0,0 +1,124 @@
+#ifndef CHAMPIONSHIP_REPLAY_HPP
+#define CHAMPIONSHIP_REPLAY_HPP
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+#include "Dataset.hpp"
+
+using namespace std;
+
+// Sistema de puntuacion. Los puntos van en centesimas, como ResultsTable::points.
+struct PointsSystem {
+    string name;
+    vector<int32_t> race;      // race[0] = puntos del ganador
+    vector<int32_t> sprint;    // Vacio: los sprints no puntuan
+    int32_t fastestLap = 0;    // Bonus por la vuelta rapida de la carrera
+    int fastestLapTop = 0;     // Solo si se termina entre los fastestLapTop primeros (0 = siempre)
+    int bestResults = 0;       // Campeonato de pilotos: solo cuentan los N mejores resultados (0 = todos)
+    bool official = false;     // Puntos oficiales de results.csv y sprint_results.csv
+
+    // official, wins, 1950, 1960, 1961, 1991, 2003, 2010, 2019, 2021, 2022
+    static optional<PointsSystem> preset(const string& name);
+    static vector<string> presetNames();
+    // Un preset o una tabla de carrera "25,18,15,..." (admite decimales)
+    static optional<PointsSystem> parse(const string& spec);
+};
+
+struct ReplayStanding {
+    int id;           // driverId o constructorId
+    int64_t points;   // centesimas
+    int wins;
+    int position;
+};
+
+struct SeasonChampions {
+    int year;
+    int driverId;
+    int64_t driverPoints;
+    int teamId;              // -1 antes de 1958 (sin campeonato de constructores)
+    int64_t teamPoints;
+    int officialDriverId;    // Campeon segun driver_standings.csv; -1 si no consta
+    int officialTeamId;      // Segun constructor_standings.csv; -1 si no consta
+};
+
+// Reconstruye los campeonatos carrera a carrera con cualquier sistema de puntuacion.
+// Al construirse ordena una vez todas las filas de carrera y de sprint por fecha
+// y les asigna un hueco denso (temporada, piloto) y (temporada, equipo); ademas
+// precalcula la vuelta rapida de cada carrera y el desempate por mejores
+// posiciones, que no dependen de la puntuacion. Repetir todas las temporadas con
+// un sistema es entonces una pasada con una busqueda en tabla por fila.
+// Simplificaciones: todos los coches de un equipo puntuan para el, no se
+// reparten puntos en coches compartidos ni se dan medios puntos, y la vuelta
+// rapida solo se conoce desde 2004 (fastestLapTime de results.csv).
+class ChampionshipReplay {
+public:
+    static const int COUNTBACK_POSITIONS = 40;  // Posiciones que se comparan al desempatar
+    static const int FIRST_CONSTRUCTORS_YEAR = 1958;
+
+    explicit ChampionshipReplay(const Dataset& data);
+
+    // Incorpora las filas de data.results desde firstRow (DataManager::appendDelta):
+    // se rehacen solo las temporadas desde la primera que tiene filas nuevas.
+    // No debe coincidir con consultas en curso.
+    void appendResults(const Dataset& data, size_t firstRow);
+
+    // Clasificacion de una temporada tras 'rounds' carreras (0 = temporada completa)
+    vector<ReplayStanding> driverStandings(const PointsSystem& system, int year, int rounds = 0) const;
+    vector<ReplayStanding> teamStandings(const PointsSystem& system, int year, int rounds = 0) const;
+
+    // Campeones de cada temporada entre startYear y endYear
+    vector<SeasonChampions> champions(const PointsSystem& system, int startYear, int endYear) const;
+
+    // champions() para varios sistemas en paralelo (threads = 0 usa todos los nucleos)
+    vector<vector<SeasonChampions>> championsForAll(const vector<PointsSystem>& systems, int startYear, int endYear,
+        size_t threads = 0) const;
+
+private:
+    // Filas en orden de carrera (columnas)
+    vector<uint32_t> eventRow;       // Fila de ResultsTable
+    vector<int32_t> eventDriverSlot;
+    vector<int32_t> eventTeamSlot;   // -1 si no puntua para constructores
+    vector<int16_t> eventPosition;
+    vector<int32_t> eventPoints;     // Puntos oficiales
+    vector<uint8_t> eventFlags;      // SPRINT_EVENT, FASTEST_LAP_EVENT
+    vector<int32_t> eventRound;      // Carrera de la temporada (1 = primera)
+
+    // Por temporada: tramo de filas y de huecos
+    vector<int> seasonYears;
+    vector<pair<size_t, size_t>> seasonEvents;
+    vector<pair<int32_t, int32_t>> seasonDriverSlots;
+    vector<pair<int32_t, int32_t>> seasonTeamSlots;
+    vector<int> officialDriverChampion;
+    vector<int> officialTeamChampion;
+
+    // Por hueco: entidad y recuento de posiciones para desempatar
+    vector<int32_t> driverOfSlot;
+    vector<int32_t> teamOfSlot;
+    vector<uint16_t> driverCountback;  // COUNTBACK_POSITIONS por hueco
+    vector<uint16_t> teamCountback;
+
+    // Filas de carrera de cada hueco de piloto (CSR), para los N mejores resultados
+    vector<uint32_t> slotEventOffsets;
+    vector<uint32_t> slotEvents;
+
+    static const uint8_t SPRINT_EVENT = 1;
+    static const uint8_t FASTEST_LAP_EVENT = 2;
+
+    void build(const Dataset& data, size_t firstSeason, vector<uint32_t> rows);
+    int32_t eventScore(const PointsSystem& system, size_t event) const;
+    // Suma los puntos de las filas [first, last) hasta la carrera 'rounds' (0 = todas)
+    void accumulate(const PointsSystem& system, size_t first, size_t last, int rounds,
+        vector<int64_t>& driverPoints, vector<int64_t>& teamPoints) const;
+    vector<ReplayStanding> standings(const vector<int64_t>& points, pair<int32_t, int32_t> slots,
+        const vector<int32_t>& entityOfSlot, const vector<uint16_t>& countback) const;
+    bool better(const vector<int64_t>& points, const vector<uint16_t>& countback, const vector<int32_t>& entityOfSlot,
+        int32_t a, int32_t b) const;
+    // Desempate con solo las 'rounds' primeras carreras de la temporada
+    vector<uint16_t> partialCountback(size_t season, int rounds, bool driver) const;
+    optional<size_t> seasonIndex(int year) const;
+};
+
+#endif // CHAMPIONSHIP_REPLAY_HPP
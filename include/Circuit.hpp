@@ -1,21 +1,22 @@
-#ifndef CIRCUIT_HPP
-#define CIRCUIT_HPP
-
-#include <string>
-
-using namespace std;
-
-class Circuit {
-public:
-    int circuitId;
-    string name;
-    string location;
-    string country;
-
-    // Constructor declarado aquí.
-    Circuit();
-
-    Circuit(int id, string n, string loc, string country);
-};
-
+#ifndef CIRCUIT_HPP
+#define CIRCUIT_HPP
+
+#include "InternedString.hpp"
+
+using namespace std;
+
+class Circuit {
+public:
+    int circuitId;
+    InternedString name;
+    InternedString location;
+    InternedString country;
+    InternedString circuitRef;  // Identificador textual de Ergast (p. ej. "monaco")
+
+    // Constructor declarado aquí.
+    Circuit();
+
+    Circuit(int id, InternedString n, InternedString loc, InternedString country, InternedString ref = InternedString());
+};
+
 #endif // CIRCUIT_HPP
\ No newline at end of file
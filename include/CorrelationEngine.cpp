@@ -0,0 +1,182 @@
+#include "CorrelationEngine.hpp"
+#include <algorithm>
+#include <cmath>
+
+void CorrelationStats::add(double x, double y) {
+    count += 1;
+    double deltaX = x - meanX;
+    meanX += deltaX / count;
+    double deltaY = y - meanY;
+    meanY += deltaY / count;
+    m2X += deltaX * (x - meanX);
+    m2Y += deltaY * (y - meanY);
+    coMoment += deltaX * (y - meanY);
+}
+
+void CorrelationStats::add(double x, double y, double weight) {
+    CorrelationStats block;
+    block.count = weight;
+    block.meanX = x;
+    block.meanY = y;
+    merge(block);
+}
+
+void CorrelationStats::merge(const CorrelationStats& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    double total = count + other.count;
+    double deltaX = other.meanX - meanX;
+    double deltaY = other.meanY - meanY;
+    double factor = count * other.count / total;
+    m2X += other.m2X + deltaX * deltaX * factor;
+    m2Y += other.m2Y + deltaY * deltaY * factor;
+    coMoment += other.coMoment + deltaX * deltaY * factor;
+    meanX += deltaX * other.count / total;
+    meanY += deltaY * other.count / total;
+    count = total;
+}
+
+double CorrelationStats::pearson() const {
+    double denominator = sqrt(m2X * m2Y);
+    return denominator == 0 ? 0.0 : coMoment / denominator;
+}
+
+uint64_t TransitionMatrix::rowTotal(int grid) const {
+    uint64_t total = 0;
+    for (int finish = 1; finish <= size; ++finish) {
+        total += at(grid, finish);
+    }
+    return total;
+}
+
+double TransitionMatrix::spearman() const {
+    // Rango medio de cada valor: las filas empatadas comparten la media de sus rangos
+    vector<double> gridRank(size + 1, 0.0);
+    vector<double> finishRank(size + 1, 0.0);
+    double gridBefore = 0;
+    double finishBefore = 0;
+    for (int value = 1; value <= size; ++value) {
+        double gridCount = 0;
+        double finishCount = 0;
+        for (int other = 1; other <= size; ++other) {
+            gridCount += at(value, other);
+            finishCount += at(other, value);
+        }
+        gridRank[value] = gridBefore + (gridCount + 1) / 2.0;
+        finishRank[value] = finishBefore + (finishCount + 1) / 2.0;
+        gridBefore += gridCount;
+        finishBefore += finishCount;
+    }
+
+    CorrelationStats ranks;
+    for (int grid = 1; grid <= size; ++grid) {
+        for (int finish = 1; finish <= size; ++finish) {
+            if (uint32_t cell = at(grid, finish)) {
+                ranks.add(gridRank[grid], finishRank[finish], cell);
+            }
+        }
+    }
+    return ranks.pearson();
+}
+
+CorrelationEngine::CorrelationEngine(const ResultsTable& results, const map<int, Race>& races) : results(results) {
+    if (!races.empty()) {
+        circuitOfRace.assign(static_cast<size_t>(max(0, races.rbegin()->first)) + 1, -1);
+    }
+    for (const auto& entry : races) {
+        if (entry.first >= 0 && entry.second.circuit) {
+            circuitOfRace[entry.first] = entry.second.circuit->circuitId;
+        }
+    }
+}
+
+vector<GroupCorrelation> CorrelationEngine::compute(CorrelationGroup group, const CorrelationOptions& options) const {
+    // Los ids de grupo son densos y pequenos: se asigna un acumulador al ver cada id por primera vez
+    vector<int32_t> slotOfGroup;
+    vector<CorrelationStats> stats;
+    vector<vector<uint32_t>> histograms;
+    bool histogram = options.ranks || options.transitions;
+    size_t cells = static_cast<size_t>(MAX_POSITION) * MAX_POSITION;
+    int minGrid = options.includePitLaneStarts ? 0 : 1;
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results.session[i] != static_cast<uint8_t>(Session::Race)) {
+            continue;
+        }
+        int grid = results.grid[i];
+        int position = results.position[i];
+        int year = results.year[i];
+        if (grid < minGrid || grid > MAX_POSITION || position < 1 || position > MAX_POSITION
+            || (options.startYear && year < options.startYear) || (options.endYear && year > options.endYear)) {
+            continue;
+        }
+
+        int groupId = 0;
+        switch (group) {
+        case CorrelationGroup::All: groupId = 0; break;
+        case CorrelationGroup::Season: groupId = year; break;
+        case CorrelationGroup::Constructor: groupId = results.constructorId[i]; break;
+        case CorrelationGroup::Circuit: {
+            int raceId = results.raceId[i];
+            groupId = raceId >= 0 && static_cast<size_t>(raceId) < circuitOfRace.size() ? circuitOfRace[raceId] : -1;
+            break;
+        }
+        }
+        if (groupId < 0) {
+            continue;
+        }
+        if (static_cast<size_t>(groupId) >= slotOfGroup.size()) {
+            slotOfGroup.resize(static_cast<size_t>(groupId) + 1, -1);
+        }
+        int32_t& slot = slotOfGroup[groupId];
+        if (slot < 0) {
+            slot = static_cast<int32_t>(stats.size());
+            stats.emplace_back();
+            if (histogram) {
+                histograms.emplace_back(cells, 0);
+            }
+        }
+
+        stats[slot].add(grid, position);
+        // Las salidas desde el pit lane cuentan en el histograma como ultima posicion de la matriz
+        if (histogram) {
+            int gridCell = grid > 0 ? grid : MAX_POSITION;
+            ++histograms[slot][static_cast<size_t>(gridCell - 1) * MAX_POSITION + (position - 1)];
+        }
+    }
+
+    vector<GroupCorrelation> correlations;
+    for (size_t groupId = 0; groupId < slotOfGroup.size(); ++groupId) {
+        int32_t slot = slotOfGroup[groupId];
+        if (slot < 0 || stats[slot].count < options.minCount) {
+            continue;
+        }
+        GroupCorrelation correlation{ static_cast<int>(groupId), stats[slot], 0.0, TransitionMatrix() };
+        if (histogram) {
+            TransitionMatrix matrix;
+            matrix.size = MAX_POSITION;
+            matrix.counts = move(histograms[slot]);
+            if (options.ranks) {
+                correlation.spearman = matrix.spearman();
+            }
+            if (options.transitions) {
+                correlation.transitions = move(matrix);
+            }
+        }
+        correlations.push_back(move(correlation));
+    }
+    return correlations;
+}
+
+GroupCorrelation CorrelationEngine::overall(const CorrelationOptions& options) const {
+    vector<GroupCorrelation> all = compute(CorrelationGroup::All, options);
+    if (all.empty()) {
+        return { 0, CorrelationStats(), 0.0, TransitionMatrix() };
+    }
+    return move(all.front());
+}
@@ -0,0 +1,84 @@
+#ifndef CORRELATION_ENGINE_HPP
+#define CORRELATION_ENGINE_HPP
+
+#include <map>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Race.hpp"
+#include "ResultsTable.hpp"
+
+using namespace std;
+
+// Medias y co-momentos de (x, y) actualizados en linea (Welford). Dos
+// acumuladores se pueden combinar (Chan et al.), asi que el total sale de los grupos.
+struct CorrelationStats {
+    double count = 0;
+    double meanX = 0;
+    double meanY = 0;
+    double m2X = 0;       // Suma de (x - media)^2
+    double m2Y = 0;
+    double coMoment = 0;  // Suma de (x - mediaX)(y - mediaY)
+
+    void add(double x, double y);
+    // Anade 'weight' observaciones iguales a (x, y)
+    void add(double x, double y, double weight);
+    void merge(const CorrelationStats& other);
+
+    double covariance() const { return count > 1 ? coMoment / (count - 1) : 0.0; }
+    double pearson() const;
+};
+
+// Recuentos salida -> llegada de un grupo; posiciones 1..size
+struct TransitionMatrix {
+    int size = 0;
+    vector<uint32_t> counts;  // counts[(grid - 1) * size + (finish - 1)]
+
+    uint32_t at(int grid, int finish) const { return counts[static_cast<size_t>(grid - 1) * size + (finish - 1)]; }
+    uint64_t rowTotal(int grid) const;
+    // Correlacion de Spearman con rangos medios para los empates, calculada sobre los recuentos
+    double spearman() const;
+};
+
+enum class CorrelationGroup { All, Circuit, Season, Constructor };
+
+struct CorrelationOptions {
+    int startYear = 0;                  // 0 = sin limite
+    int endYear = 0;
+    bool includePitLaneStarts = false;  // grid 0 (salida desde el pit lane)
+    bool ranks = true;                  // Spearman (necesita los recuentos por grupo)
+    bool transitions = false;           // Devolver la matriz de cada grupo
+    size_t minCount = 1;                // Grupos con menos filas se descartan
+};
+
+struct GroupCorrelation {
+    int groupId;               // circuitId, ano o constructorId; 0 con CorrelationGroup::All
+    CorrelationStats stats;    // x = salida, y = llegada
+    double spearman;           // 0 si no se pidieron rangos
+    TransitionMatrix transitions;  // Vacia si no se pidio
+};
+
+// Correlacion salida/llegada por grupos en una sola pasada sobre las columnas
+// grid, position, year, raceId y constructorId de ResultsTable, sin copiar filas.
+// Solo cuentan las filas de carrera (los sprints tienen su propia parrilla).
+// Las posiciones son enteros pequenos, asi que los rangos de Spearman y la matriz
+// de transiciones salen de un histograma salida x llegada por grupo.
+class CorrelationEngine {
+public:
+    static const int MAX_POSITION = 64;  // Filas con posiciones mayores se ignoran
+
+    // Sin carreras no se puede agrupar por circuito
+    CorrelationEngine(const ResultsTable& results, const map<int, Race>& races = {});
+
+    // Un elemento por grupo con filas, en orden de id
+    vector<GroupCorrelation> compute(CorrelationGroup group, const CorrelationOptions& options) const;
+
+    // Todas las filas juntas
+    GroupCorrelation overall(const CorrelationOptions& options) const;
+
+private:
+    const ResultsTable& results;
+    vector<int32_t> circuitOfRace;  // raceId -> circuitId (-1 si no hay)
+};
+
+#endif // CORRELATION_ENGINE_HPP
@@ -0,0 +1,485 @@
+#include "DataIndexes.hpp"
+#include <algorithm>
+#include <limits>
+#include <set>
+
+void StandingsColumns::setRows(int id, const vector<ColumnRow>& rows) {
+    if (id < 0) {
+        return;
+    }
+    for (const ColumnRow& row : rows) {
+        if (lastYear < firstYear) {
+            firstYear = lastYear = row.year;  // Columnas vacias
+        } else if (row.year < firstYear) {
+            rebaseYears(row.year);
+        }
+        lastYear = max(lastYear, row.year);
+    }
+    if (static_cast<size_t>(id) >= ranges.size()) {
+        ranges.resize(static_cast<size_t>(id) + 1, { 0, 0 });
+    }
+
+    liveRows -= ranges[id].second - ranges[id].first;
+    uint32_t begin = static_cast<uint32_t>(points.size());
+    for (const ColumnRow& row : rows) {
+        points.push_back(row.points);
+        yearSlots.push_back(row.year - firstYear);
+        circuitIds.push_back(row.circuitId);
+    }
+    ranges[id] = { begin, static_cast<uint32_t>(points.size()) };
+    liveRows += rows.size();
+    if (points.size() > 2 * liveRows) {
+        compact();
+    }
+}
+
+// Un ano anterior al primero desplaza todos los huecos de ano (no ocurre al anadir temporadas nuevas)
+void StandingsColumns::rebaseYears(int year) {
+    int shift = firstYear - year;
+    for (int32_t& slot : yearSlots) {
+        slot += shift;
+    }
+    firstYear = year;
+}
+
+// Vuelve a colocar los tramos en orden de id, sin huecos
+void StandingsColumns::compact() {
+    vector<double> keptPoints;
+    vector<int32_t> keptYears;
+    vector<int32_t> keptCircuits;
+    keptPoints.reserve(liveRows);
+    keptYears.reserve(liveRows);
+    keptCircuits.reserve(liveRows);
+    for (auto& range : ranges) {
+        uint32_t begin = static_cast<uint32_t>(keptPoints.size());
+        keptPoints.insert(keptPoints.end(), points.begin() + range.first, points.begin() + range.second);
+        keptYears.insert(keptYears.end(), yearSlots.begin() + range.first, yearSlots.begin() + range.second);
+        keptCircuits.insert(keptCircuits.end(), circuitIds.begin() + range.first, circuitIds.begin() + range.second);
+        range = { begin, static_cast<uint32_t>(keptPoints.size()) };
+    }
+    points = move(keptPoints);
+    yearSlots = move(keptYears);
+    circuitIds = move(keptCircuits);
+}
+
+pair<size_t, size_t> DataIndexes::racesBetween(int startYear, int endYear) const {
+    auto first = yearRange.lower_bound(startYear);
+    auto last = yearRange.upper_bound(endYear);
+    if (first == yearRange.end() || first == last) {
+        return { 0, 0 };
+    }
+    --last;
+    return { first->second.first, last->second.second };
+}
+
+void DataIndexes::indexResults(const ResultsTable& results) {
+    appendResults(results, 0);
+}
+
+void DataIndexes::indexResultIds(const ResultsTable& results, size_t firstRow) {
+    for (size_t i = firstRow; i < results.size(); ++i) {
+        resultRowById[results.session[i]][results.resultId[i]] = static_cast<uint32_t>(i);
+    }
+}
+
+// Al cargar todo basta con buscar desde los sprints (hay pocos); en un delta una
+// carrera nueva tambien puede encontrar un sprint cargado antes. Se busca desde
+// el final de las filas del piloto, donde estan las carreras recientes.
+void DataIndexes::linkWeekends(const ResultsTable& results, size_t firstRow) {
+    weekendPartner.resize(results.size(), -1);
+    for (size_t i = firstRow; i < results.size(); ++i) {
+        if (firstRow == 0 && results.session[i] != static_cast<uint8_t>(Session::Sprint)) {
+            continue;
+        }
+        auto rows = resultsByDriver.find(results.driverId[i]);
+        if (rows == resultsByDriver.end()) {
+            continue;
+        }
+        for (auto row = rows->second.rbegin(); row != rows->second.rend(); ++row) {
+            if (results.raceId[*row] == results.raceId[i] && results.session[*row] != results.session[i]) {
+                weekendPartner[i] = static_cast<int32_t>(*row);
+                weekendPartner[*row] = static_cast<int32_t>(i);
+                break;
+            }
+        }
+    }
+}
+
+void DataIndexes::indexPitStops(const PitStopTable& pitStops, size_t firstRow) {
+    for (size_t i = firstRow; i < pitStops.size(); ++i) {
+        pitStopsByRace[pitStops.raceId[i]].push_back(static_cast<uint32_t>(i));
+        pitStopsByDriver[pitStops.driverId[i]].push_back(static_cast<uint32_t>(i));
+    }
+}
+
+namespace {
+
+// Columnas con un valor por fila de una tabla, agrupadas por la entidad que devuelve
+// entityOf. Las filas con valor negativo o entidad -1 no se incluyen.
+template <typename EntityOf, typename YearOf, typename CircuitOf>
+StandingsColumns buildRowColumns(const vector<double>& values, EntityOf entityOf, YearOf yearOf, CircuitOf circuitOf) {
+    StandingsColumns columns;
+    int maxId = -1;
+    columns.firstYear = numeric_limits<int>::max();
+    columns.lastYear = numeric_limits<int>::min();
+    vector<uint32_t> counts;
+    for (size_t i = 0; i < values.size(); ++i) {
+        int id = entityOf(i);
+        if (id < 0 || values[i] < 0) {
+            continue;
+        }
+        if (id > maxId) {
+            maxId = id;
+            counts.resize(static_cast<size_t>(id) + 1, 0);
+        }
+        ++counts[id];
+        columns.firstYear = min(columns.firstYear, static_cast<int>(yearOf(i)));
+        columns.lastYear = max(columns.lastYear, static_cast<int>(yearOf(i)));
+    }
+    if (maxId < 0) {
+        return StandingsColumns();
+    }
+
+    // Tramos por recuento y despues un reparto estable en el orden de la tabla
+    columns.ranges.resize(static_cast<size_t>(maxId) + 1);
+    uint32_t rows = 0;
+    for (int id = 0; id <= maxId; ++id) {
+        columns.ranges[id] = { rows, rows + counts[id] };
+        rows += counts[id];
+    }
+    columns.liveRows = rows;
+    columns.points.resize(rows);
+    columns.yearSlots.resize(rows);
+    columns.circuitIds.resize(rows);
+    vector<uint32_t> next(counts.size());
+    for (int id = 0; id <= maxId; ++id) {
+        next[id] = columns.ranges[id].first;
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        int id = entityOf(i);
+        if (id < 0 || values[i] < 0) {
+            continue;
+        }
+        uint32_t row = next[id]++;
+        columns.points[row] = values[i];
+        columns.yearSlots[row] = yearOf(i) - columns.firstYear;
+        columns.circuitIds[row] = circuitOf(i);
+    }
+    return columns;
+}
+
+// Orden de racesByDate: (ano, fecha, raceId)
+bool earlierRace(const Race* a, const Race* b) {
+    if (a->year != b->year) return a->year < b->year;
+    if (a->date != b->date) return a->date.str() < b->date.str();
+    return a->raceId < b->raceId;
+}
+
+template <typename Standing>
+StandingsColumns buildStandingsColumns(const map<int, vector<const Standing*>>& standingsByEntity) {
+    StandingsColumns columns;
+    if (standingsByEntity.empty()) {
+        return columns;
+    }
+
+    columns.firstYear = numeric_limits<int>::max();
+    columns.lastYear = numeric_limits<int>::min();
+    size_t rows = 0;
+    for (const auto& entry : standingsByEntity) {
+        for (const Standing* standing : entry.second) {
+            columns.firstYear = min(columns.firstYear, standing->race->year);
+            columns.lastYear = max(columns.lastYear, standing->race->year);
+        }
+        rows += entry.second.size();
+    }
+
+    int maxId = max(0, standingsByEntity.rbegin()->first);
+    columns.ranges.assign(static_cast<size_t>(maxId) + 1, { 0, 0 });
+    columns.points.reserve(rows);
+    columns.yearSlots.reserve(rows);
+    columns.circuitIds.reserve(rows);
+
+    for (const auto& entry : standingsByEntity) {
+        if (entry.first < 0) {
+            continue;  // Ids negativos: no se indexan
+        }
+        uint32_t begin = static_cast<uint32_t>(columns.points.size());
+        for (const Standing* standing : entry.second) {
+            columns.points.push_back(standing->points);
+            columns.yearSlots.push_back(standing->race->year - columns.firstYear);
+            columns.circuitIds.push_back(standing->race->circuit ? standing->race->circuit->circuitId : -1);
+        }
+        columns.ranges[entry.first] = { begin, static_cast<uint32_t>(columns.points.size()) };
+    }
+    columns.liveRows = columns.points.size();
+    return columns;
+}
+
+template <typename Standing>
+vector<ColumnRow> standingRows(const vector<const Standing*>& standings) {
+    vector<ColumnRow> rows;
+    rows.reserve(standings.size());
+    for (const Standing* standing : standings) {
+        rows.push_back({ standing->points, standing->race->year, standing->race->circuit ? standing->race->circuit->circuitId : -1 });
+    }
+    return rows;
+}
+
+// Filas de una entidad (en el orden de su lista) con valor no negativo
+template <typename Value, typename YearOf, typename CircuitOf>
+vector<ColumnRow> entityRows(const vector<uint32_t>& tableRows, Value value, YearOf yearOf, CircuitOf circuitOf) {
+    vector<ColumnRow> rows;
+    for (uint32_t row : tableRows) {
+        double v = value(row);
+        if (v >= 0) {
+            rows.push_back({ v, static_cast<int>(yearOf(row)), circuitOf(row) });
+        }
+    }
+    return rows;
+}
+
+// Distancia a la pole de las filas de una carrera (-1 sin tiempo)
+void poleGaps(const QualifyingTable& qualifying, const vector<uint32_t>& raceRows, vector<double>& gaps) {
+    int32_t pole = -1;
+    for (uint32_t row : raceRows) {
+        int32_t best = qualifying.bestMs(row);
+        if (best > 0 && (pole < 0 || best < pole)) {
+            pole = best;
+        }
+    }
+    for (uint32_t row : raceRows) {
+        int32_t best = qualifying.bestMs(row);
+        gaps[row] = pole > 0 && best > 0 ? min(DataIndexes::MAX_QUALIFYING_GAP, (best - pole) * 100.0 / pole) : -1.0;
+    }
+}
+
+// 1 si la salida en carrera acabo en averia, 0 si no; -1 (fuera) para sprints y no salidas
+double failureValue(const ResultsTable& results, const StatusDictionary& statuses, size_t row) {
+    if (results.session[row] != static_cast<uint8_t>(Session::Race)) {
+        return -1.0;
+    }
+    Outcome outcome = statuses.outcome(results.statusId[row]);
+    if (outcome == Outcome::DidNotStart) {
+        return -1.0;
+    }
+    return outcome == Outcome::Mechanical ? 1.0 : 0.0;
+}
+
+}
+
+void DataIndexes::indexQualifying(const QualifyingTable& qualifying, size_t firstRow) {
+    set<int> races;
+    for (size_t i = firstRow; i < qualifying.size(); ++i) {
+        qualifyingByRace[qualifying.raceId[i]].push_back(static_cast<uint32_t>(i));
+        qualifyingByDriver[qualifying.driverId[i]].push_back(static_cast<uint32_t>(i));
+        qualifyingByTeam[qualifying.constructorId[i]].push_back(static_cast<uint32_t>(i));
+        qualifyingRowById[qualifying.qualifyId[i]] = static_cast<uint32_t>(i);
+        races.insert(qualifying.raceId[i]);
+    }
+
+    // Una fila nueva puede cambiar la pole de su carrera: se recalculan las carreras tocadas
+    qualifyingGaps.resize(qualifying.size(), -1.0);
+    set<int> drivers;
+    set<int> teams;
+    for (int raceId : races) {
+        const vector<uint32_t>& raceRows = qualifyingByRace[raceId];
+        poleGaps(qualifying, raceRows, qualifyingGaps);
+        for (uint32_t row : raceRows) {
+            if (firstRow > 0) {
+                drivers.insert(qualifying.driverId[row]);
+                teams.insert(qualifying.constructorId[row]);
+            }
+        }
+    }
+
+    auto gapOf = [&](size_t i) { return qualifyingGaps[i]; };
+    auto yearOf = [&](size_t i) { return qualifying.year[i]; };
+    auto circuitOf = [&](size_t i) { return qualifying.circuitId[i]; };
+    if (firstRow == 0) {
+        driverQualifyingColumns = buildRowColumns(qualifyingGaps, [&](size_t i) { return qualifying.driverId[i]; }, yearOf, circuitOf);
+        teamQualifyingColumns = buildRowColumns(qualifyingGaps, [&](size_t i) { return qualifying.constructorId[i]; }, yearOf, circuitOf);
+        return;
+    }
+    for (int driverId : drivers) {
+        driverQualifyingColumns.setRows(driverId, entityRows(qualifyingByDriver[driverId], gapOf, yearOf, circuitOf));
+    }
+    for (int teamId : teams) {
+        teamQualifyingColumns.setRows(teamId, entityRows(qualifyingByTeam[teamId], gapOf, yearOf, circuitOf));
+    }
+}
+
+void DataIndexes::indexReliability(const ResultsTable& results, const StatusDictionary& statuses, const map<int, Race>& races) {
+    // Circuito de cada carrera en un vector denso
+    vector<int32_t> circuitOfRace;
+    for (const auto& entry : races) {
+        if (entry.first >= 0 && entry.second.circuit) {
+            if (static_cast<size_t>(entry.first) >= circuitOfRace.size()) {
+                circuitOfRace.resize(static_cast<size_t>(entry.first) + 1, -1);
+            }
+            circuitOfRace[entry.first] = entry.second.circuit->circuitId;
+        }
+    }
+
+    vector<double> failures(results.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        failures[i] = failureValue(results, statuses, i);
+    }
+    auto yearOf = [&](size_t i) { return results.year[i]; };
+    auto circuitOf = [&](size_t i) {
+        int raceId = results.raceId[i];
+        return raceId >= 0 && static_cast<size_t>(raceId) < circuitOfRace.size() ? circuitOfRace[raceId] : -1;
+    };
+    driverReliabilityColumns = buildRowColumns(failures, [&](size_t i) { return results.driverId[i]; }, yearOf, circuitOf);
+    teamReliabilityColumns = buildRowColumns(failures, [&](size_t i) { return results.constructorId[i]; }, yearOf, circuitOf);
+}
+
+void DataIndexes::indexStandings(const map<int, DriverStandings>& driverStandings, const map<int, TeamStandings>& teamStandings) {
+    for (const auto& entry : driverStandings) {
+        if (entry.second.driver && entry.second.race) {
+            standingsByDriver[entry.second.driver->driverId].push_back(&entry.second);
+        }
+    }
+
+    for (const auto& entry : teamStandings) {
+        if (entry.second.team && entry.second.race) {
+            standingsByTeam[entry.second.team->teamId].push_back(&entry.second);
+        }
+    }
+
+    driverStandingColumns = buildStandingsColumns(standingsByDriver);
+    teamStandingColumns = buildStandingsColumns(standingsByTeam);
+}
+
+// Ordena las carreras por fecha y calcula el tramo de cada ano
+void DataIndexes::indexRaces(const map<int, Race>& races) {
+    racesByDate.clear();
+    racesByDate.reserve(races.size());
+    for (const auto& entry : races) {
+        racesByDate.push_back(&entry.second);
+    }
+    sort(racesByDate.begin(), racesByDate.end(), earlierRace);
+    indexRaceYears();
+}
+
+// Calcula yearRange a partir de racesByDate ya ordenado
+void DataIndexes::indexRaceYears() {
+    yearRange.clear();
+    for (size_t i = 0; i < racesByDate.size(); ++i) {
+        int year = racesByDate[i]->year;
+        auto it = yearRange.find(year);
+        if (it == yearRange.end()) {
+            yearRange[year] = { i, i + 1 };
+        } else {
+            it->second.second = i + 1;
+        }
+    }
+}
+
+void DataIndexes::indexCircuits(const map<int, Race>& races) {
+    for (const auto& entry : races) {
+        if (entry.second.circuit) {
+            racesByCircuit[entry.second.circuit->circuitId].push_back(&entry.second);
+        }
+    }
+}
+
+void DataIndexes::appendResults(const ResultsTable& results, size_t firstRow) {
+    // Las filas nuevas van al final de la tabla, asi que las listas siguen ordenadas
+    for (size_t i = firstRow; i < results.size(); ++i) {
+        resultsByDriver[results.driverId[i]].push_back(static_cast<uint32_t>(i));
+        resultsByTeam[results.constructorId[i]].push_back(static_cast<uint32_t>(i));
+    }
+    indexResultIds(results, firstRow);
+    linkWeekends(results, firstRow);
+}
+
+namespace {
+
+// Inserta cada clasificacion en la lista de su entidad respetando el orden por id;
+// devuelve las entidades cuya lista cambio
+template <typename Standing, typename EntityId, typename StandingId>
+set<int> insertStandings(map<int, vector<const Standing*>>& standingsByEntity, const vector<const Standing*>& added,
+    EntityId entityId, StandingId standingId) {
+    set<int> changed;
+    for (const Standing* standing : added) {
+        if (!standing->race || entityId(standing) < 0) {
+            continue;
+        }
+        vector<const Standing*>& list = standingsByEntity[entityId(standing)];
+        auto position = upper_bound(list.begin(), list.end(), standing, [&](const Standing* a, const Standing* b) {
+            return standingId(a) < standingId(b);
+        });
+        list.insert(position, standing);
+        changed.insert(entityId(standing));
+    }
+    return changed;
+}
+
+}
+
+void DataIndexes::appendStandings(const vector<const DriverStandings*>& driverAdded, const vector<const TeamStandings*>& teamAdded) {
+    set<int> drivers = insertStandings(standingsByDriver, driverAdded,
+        [](const DriverStandings* s) { return s->driver ? s->driver->driverId : -1; },
+        [](const DriverStandings* s) { return s->driverStandingsId; });
+    set<int> teams = insertStandings(standingsByTeam, teamAdded,
+        [](const TeamStandings* s) { return s->team ? s->team->teamId : -1; },
+        [](const TeamStandings* s) { return s->teamStandingsId; });
+
+    for (int driverId : drivers) {
+        driverStandingColumns.setRows(driverId, standingRows(standingsByDriver[driverId]));
+    }
+    for (int teamId : teams) {
+        teamStandingColumns.setRows(teamId, standingRows(standingsByTeam[teamId]));
+    }
+}
+
+void DataIndexes::appendReliability(const ResultsTable& results, const StatusDictionary& statuses, const map<int, Race>& races,
+    size_t firstRow, const vector<int>& addedStatuses) {
+    set<int> drivers;
+    set<int> teams;
+    for (size_t i = firstRow; i < results.size(); ++i) {
+        drivers.insert(results.driverId[i]);
+        teams.insert(results.constructorId[i]);
+    }
+    // Un estado nuevo reclasifica las filas antiguas que ya lo usaban (solo se lee la columna statusId)
+    if (!addedStatuses.empty()) {
+        for (size_t i = 0; i < firstRow; ++i) {
+            if (find(addedStatuses.begin(), addedStatuses.end(), results.statusId[i]) != addedStatuses.end()) {
+                drivers.insert(results.driverId[i]);
+                teams.insert(results.constructorId[i]);
+            }
+        }
+    }
+
+    auto failureOf = [&](size_t i) { return failureValue(results, statuses, i); };
+    auto yearOf = [&](size_t i) { return results.year[i]; };
+    auto circuitOf = [&](size_t i) {
+        auto race = races.find(results.raceId[i]);
+        return race != races.end() && race->second.circuit ? race->second.circuit->circuitId : -1;
+    };
+    for (int driverId : drivers) {
+        driverReliabilityColumns.setRows(driverId, entityRows(resultsByDriver[driverId], failureOf, yearOf, circuitOf));
+    }
+    for (int teamId : teams) {
+        teamReliabilityColumns.setRows(teamId, entityRows(resultsByTeam[teamId], failureOf, yearOf, circuitOf));
+    }
+}
+
+void DataIndexes::appendRaces(const vector<const Race*>& added) {
+    auto byId = [](const Race* a, const Race* b) { return a->raceId < b->raceId; };
+
+    for (const Race* race : added) {
+        racesByDate.insert(upper_bound(racesByDate.begin(), racesByDate.end(), race, earlierRace), race);
+        if (race->circuit) {
+            vector<const Race*>& list = racesByCircuit[race->circuit->circuitId];
+            list.insert(upper_bound(list.begin(), list.end(), race, byId), race);
+        }
+    }
+    if (!added.empty()) {
+        indexRaceYears();
+    }
+}
+
+void DataIndexes::indexNames(const map<int, Circuit>& circuits, const map<int, Driver>& drivers, const map<int, Team>& teams) {
+    names.build(circuits, drivers, teams);
+}
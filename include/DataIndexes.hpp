@@ -0,0 +1,146 @@
+#ifndef DATA_INDEXES_HPP
+#define DATA_INDEXES_HPP
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Race.hpp"
+#include "DriverStandings.hpp"
+#include "TeamStandings.hpp"
+#include "ResultsTable.hpp"
+#include "PitStopTable.hpp"
+#include "QualifyingTable.hpp"
+#include "StatusDictionary.hpp"
+#include "NameIndex.hpp"
+
+using namespace std;
+
+// Una fila de StandingsColumns antes de colocarla
+struct ColumnRow {
+    double points;
+    int year;
+    int32_t circuitId;
+};
+
+// Clasificaciones de un tipo de entidad en columnas contiguas, agrupadas por id:
+// las filas del id k son [ranges[k].first, ranges[k].second), en el mismo orden
+// que standingsByDriver/standingsByTeam. Al construir, los tramos quedan en
+// orden de id; una carga incremental escribe al final el tramo de cada entidad
+// que cambia (setRows) y el tramo viejo queda como hueco hasta compactar.
+struct StandingsColumns {
+    vector<pair<uint32_t, uint32_t>> ranges;
+    vector<double> points;
+    vector<int32_t> yearSlots;   // ano - firstYear
+    vector<int32_t> circuitIds;  // -1 si la carrera no tiene circuito
+    int firstYear = 0;
+    int lastYear = -1;
+    size_t liveRows = 0;         // Filas dentro de algun tramo; el resto son huecos
+
+    pair<size_t, size_t> rowsOf(int id) const {
+        if (id < 0 || static_cast<size_t>(id) >= ranges.size()) {
+            return { 0, 0 };
+        }
+        return ranges[id];
+    }
+
+    // Sustituye las filas de 'id'; el coste es el de sus filas (mas una
+    // compactacion ocasional cuando los huecos superan a las filas vivas)
+    void setRows(int id, const vector<ColumnRow>& rows);
+
+private:
+    void rebaseYears(int year);
+    void compact();
+};
+
+// Indices secundarios (listas de filas) que DataManager construye al cargar.
+// Permiten que las consultas por piloto, equipo, ano o circuito recorran solo
+// las filas relevantes en vez de toda la tabla.
+class DataIndexes {
+public:
+    // driverId -> filas de ResultsTable
+    map<int, vector<uint32_t>> resultsByDriver;
+    // constructorId -> filas de ResultsTable
+    map<int, vector<uint32_t>> resultsByTeam;
+    // Fila de ResultsTable -> fila de la otra sesion (carrera o sprint) del mismo
+    // piloto en la misma carrera; -1 si no hay. Suma los puntos de un fin de semana sin buscar.
+    vector<int32_t> weekendPartner;
+    // raceId -> filas de PitStopTable
+    map<int, vector<uint32_t>> pitStopsByRace;
+    // driverId -> filas de PitStopTable
+    map<int, vector<uint32_t>> pitStopsByDriver;
+    // resultId -> fila de ResultsTable, por Session (carreras y sprints numeran aparte)
+    unordered_map<int32_t, uint32_t> resultRowById[2];
+    // raceId -> filas de QualifyingTable
+    map<int, vector<uint32_t>> qualifyingByRace;
+    // driverId -> filas de QualifyingTable
+    map<int, vector<uint32_t>> qualifyingByDriver;
+    // constructorId -> filas de QualifyingTable
+    map<int, vector<uint32_t>> qualifyingByTeam;
+    // qualifyId -> fila de QualifyingTable
+    unordered_map<int32_t, uint32_t> qualifyingRowById;
+    // driverId -> clasificaciones del piloto (en orden de driverStandingsId)
+    map<int, vector<const DriverStandings*>> standingsByDriver;
+    // constructorId -> clasificaciones del equipo (en orden de teamStandingsId)
+    map<int, vector<const TeamStandings*>> standingsByTeam;
+    // Las mismas clasificaciones en columnas (puntos, ano, circuito) para el nucleo de prediccion
+    StandingsColumns driverStandingColumns;
+    StandingsColumns teamStandingColumns;
+    // Ritmo a una vuelta por piloto y por equipo en el mismo formato: 'points' es la
+    // distancia a la pole en % (mejor tiempo de Q1-Q3, limitada a MAX_QUALIFYING_GAP)
+    StandingsColumns driverQualifyingColumns;
+    StandingsColumns teamQualifyingColumns;
+    static constexpr double MAX_QUALIFYING_GAP = 7.0;
+    // Fiabilidad en el mismo formato: una fila por salida en carrera, con 'points' = 1
+    // si acabo en averia y 0 si no; la media ponderada es la tasa de averias
+    StandingsColumns driverReliabilityColumns;
+    StandingsColumns teamReliabilityColumns;
+    // Carreras ordenadas por (ano, raceId); yearRange da el tramo [inicio, fin) de cada ano
+    vector<const Race*> racesByDate;
+    map<int, pair<size_t, size_t>> yearRange;
+    // circuitId -> carreras disputadas en el circuito
+    map<int, vector<const Race*>> racesByCircuit;
+    // Nombres, codigos y refs -> ids (sin distinguir mayusculas ni acentos)
+    NameIndex names;
+
+    // Devuelve las carreras disputadas entre startYear y endYear (ambos incluidos)
+    pair<size_t, size_t> racesBetween(int startYear, int endYear) const;
+
+    // Pasos de construccion (los usan DataManager y DataSnapshot)
+    void indexResults(const ResultsTable& results);
+    void indexStandings(const map<int, DriverStandings>& driverStandings, const map<int, TeamStandings>& teamStandings);
+    // Indexa las paradas desde firstRow (0 al cargar; el final anterior en las cargas incrementales)
+    void indexPitStops(const PitStopTable& pitStops, size_t firstRow = 0);
+    // resultId -> fila desde firstRow (el resto de listas de resultados las guarda el snapshot)
+    void indexResultIds(const ResultsTable& results, size_t firstRow = 0);
+    // Indexa las filas desde firstRow; con firstRow > 0 solo se recalculan las
+    // carreras de esas filas y las columnas de ritmo de sus pilotos y equipos
+    void indexQualifying(const QualifyingTable& qualifying, size_t firstRow = 0);
+    // Construye las columnas de fiabilidad (una pasada)
+    void indexReliability(const ResultsTable& results, const StatusDictionary& statuses, const map<int, Race>& races);
+    void indexRaces(const map<int, Race>& races);
+    void indexRaceYears();
+    void indexCircuits(const map<int, Race>& races);
+    void indexNames(const map<int, Circuit>& circuits, const map<int, Driver>& drivers, const map<int, Team>& teams);
+
+    // Actualizacion incremental (DataManager::appendDelta): solo se tocan las
+    // listas de las filas nuevas y las columnas de las entidades que aparecen
+    // en ellas, sin volver a leer ningun CSV ni recorrer el historico
+    void appendResults(const ResultsTable& results, size_t firstRow);
+    void appendStandings(const vector<const DriverStandings*>& driverAdded, const vector<const TeamStandings*>& teamAdded);
+    void appendRaces(const vector<const Race*>& added);
+    // Fiabilidad de los pilotos y equipos de las filas desde firstRow y de las
+    // filas con alguno de los estados de 'addedStatuses' (antes desconocidos)
+    void appendReliability(const ResultsTable& results, const StatusDictionary& statuses, const map<int, Race>& races,
+        size_t firstRow, const vector<int>& addedStatuses);
+
+private:
+    // Distancia a la pole de cada fila de QualifyingTable (-1 sin tiempo)
+    vector<double> qualifyingGaps;
+
+    // Enlaza las filas desde firstRow con la otra sesion del mismo piloto en la misma carrera
+    void linkWeekends(const ResultsTable& results, size_t firstRow);
+};
+
+#endif // DATA_INDEXES_HPP
@@ -1,204 +1,777 @@
-#include "DataManager.hpp"
-
-map<int, Circuit> DataManager::loadCircuits(const string& filename) {
-    CSVReader reader;
-    map<int, Circuit> circuits;
-    vector<vector<string>> data = reader.readCSV(filename);
-
-    for (size_t i = 1; i < data.size(); ++i) {
-        const auto& row = data[i];
-        if (row.size() >= 4) {
-            try {
-                int id = stoi(row[0]);
-                string name = row[2];
-                string location = row[3];
-                string country = row[4];
-                circuits[id] = Circuit(id, name, location, country);
-            } catch (const invalid_argument& e) {
-                cerr << "Error: Invalid argument when converting string to int: " << e.what() << endl;
-            } catch (const out_of_range& e) {
-                cerr << "Error: String value out of integer range: " << e.what() << endl;
-            }
-        }
-    }
-
-    return circuits;
-}
-
-map<int, Race> DataManager::loadRaces(const string& filename, const map<int, Circuit>& circuits) {
-    CSVReader reader;
-    map<int, Race> races;
-    vector<vector<string>> data = reader.readCSV(filename);
-
-    for (size_t i = 1; i < data.size(); ++i) {  // Asumimos que la primera fila son encabezados
-        const auto& row = data[i];
-        if (row.size() >= 5) {
-            int raceId = stoi(row[0]);
-            int year = stoi(row[1]);
-            int circuitId = stoi(row[3]);
-            string name = row[4];
-            string date = row[5];
-            const Circuit* circuitPtr = nullptr;  // Cambiado a const Circuit*
-
-            if (circuits.find(circuitId) != circuits.end()) {
-                circuitPtr = &circuits.at(circuitId);
-            }
-
-            races[raceId] = Race(raceId, year, circuitPtr, name, date);
-        }
-    }
-
-    return races;
-}
-
-map<int, Driver> DataManager::loadDrivers(const string& filename) {
-    CSVReader reader;
-    map<int, Driver> drivers;
-    vector<vector<string>> data = reader.readCSV(filename);
-
-    for (size_t i = 1; i < data.size(); ++i) {  // Asumimos que la primera fila son encabezados
-        const auto& row = data[i];
-        if (row.size() >= 7) {
-            int driverId = stoi(row[0]);
-            string code = row[3];
-            string fullName = row[4] + " " + row[5]; // Assuming first name and last name are split
-            string dob = row[6];
-            string nationality = row[7];
-            drivers[driverId] = Driver(driverId, code, fullName, dob, nationality);
-        }
-    }
-
-    return drivers;
-}
-
-map<int, Team> DataManager::loadTeams(const string& filename) {
-    CSVReader reader;
-    map<int, Team> teams;
-    vector<vector<string>> data = reader.readCSV(filename);
-
-    for (size_t i = 1; i < data.size(); ++i) {  // Asumiendo que la primera fila son encabezados
-        const auto& row = data[i];
-        if (row.size() >= 3) {
-            int constructorId = stoi(row[0]);
-            string name = row[2];
-            string nationality = row[3];
-            teams[constructorId] = Team(constructorId, name, nationality);
-        }
-    }
-
-    return teams;
-}
-
-map<int, DriverStandings> DataManager::loadDriverStandings(const string& filename, const map<int, Race>& races, const map<int, Driver>& drivers) {
-    CSVReader reader;
-    map<int, DriverStandings> standings;
-    vector<vector<string>> data = reader.readCSV(filename);
-
-    for (size_t i = 1; i < data.size(); ++i) {
-        const auto& row = data[i];
-        if (row.size() >= 6) {
-            int driverStandingsId = stoi(row[0]);
-            int raceId = stoi(row[1]);
-            int driverId = stoi(row[2]);
-            int points = stoi(row[3]);
-            int position = stoi(row[4]);
-            int winsNumber = stoi(row[6]);
-
-            const Race* race = races.count(raceId) ? &races.at(raceId) : nullptr;
-            const Driver* driver = drivers.count(driverId) ? &drivers.at(driverId) : nullptr;
-
-            standings[driverStandingsId] = DriverStandings(driverStandingsId, race, driver, points, position, winsNumber);
-        }
-    }
-
-    return standings;
-}
-
-map<int, TeamStandings> DataManager::loadTeamStandings(const string& filename, const map<int, Race>& races, const map<int, Team>& teams) {
-    CSVReader reader;
-    map<int, TeamStandings> standings;
-    vector<vector<string>> data = reader.readCSV(filename);
-    for (size_t i = 1; i < data.size(); ++i) {
-        const auto& row = data[i];
-        if (row.size() >= 6) {
-            int teamStandingsId = stoi(row[0]);
-            int raceId = stoi(row[1]);
-            int teamId = stoi(row[2]);
-            int points = stoi(row[3]);
-            int position = stoi(row[4]);
-            int winsNumber = stoi(row[6]);
-
-            const Race* race = races.count(raceId) ? &races.at(raceId) : nullptr;
-            const Team* team = teams.count(teamId) ? &teams.at(teamId) : nullptr;
-
-            standings[teamStandingsId] = TeamStandings(teamStandingsId, race, team, points, position, winsNumber);
-        }
-    }
-
-    return standings;
-}
-
-
-
-
-map<int, ResultsInfo_driver> DataManager::loadDriverResults(const string& filename, const map<int, Driver>& drivers, const map<int, Race>& races) {
-    CSVReader reader;
-    map<int, ResultsInfo_driver> results;
-    vector<vector<string>> data = reader.readCSV(filename);
-
-    for (size_t i = 1; i < data.size(); ++i) {
-        const auto& row = data[i];
-        if (row.size() >= 10) {
-            if (row[1] == "\\N" || row[2] == "\\N" || row[5] == "\\N" || row[6] == "\\N" || row[9] == "\\N") {
-                continue;
-            }
-
-            int resultId = stoi(row[0]);
-            int raceId = stoi(row[1]);
-            int driverId = stoi(row[2]);
-            int grid = stoi(row[5]);
-            int position = stoi(row[6]);
-            int points = stoi(row[9]);
-
-            const Driver* driver = drivers.count(driverId) ? &drivers.at(driverId) : nullptr;
-            const Race* race = races.count(raceId) ? &races.at(raceId) : nullptr;
-
-            if (driver && race) {
-                results[resultId] = ResultsInfo_driver(resultId, driver, race, grid, position, points);
-            }
-        }
-    }
-
-    return results;
-}
-
-map<int, ResultsInfo_team> DataManager::loadTeamResults(const string& filename, const map<int, Team>& teams, const map<int, Race>& races) {
-    CSVReader reader;
-    map<int, ResultsInfo_team> results;
-    vector<vector<string>> data = reader.readCSV(filename);
-
-    for (size_t i = 1; i < data.size(); ++i) {
-        const auto& row = data[i];
-        if (row.size() >= 10) {
-            if (row[1] == "\\N" || row[3] == "\\N" || row[5] == "\\N" || row[6] == "\\N" || row[9] == "\\N") {
-                continue;
-            }
-
-            int resultId = stoi(row[0]);
-            int raceId = stoi(row[1]);
-            int teamId = stoi(row[3]);
-            int grid = stoi(row[5]);
-            int position = stoi(row[6]);
-            int points = stoi(row[9]);
-
-            const Team* team = teams.count(teamId) ? &teams.at(teamId) : nullptr;
-            const Race* race = races.count(raceId) ? &races.at(raceId) : nullptr;
-
-            if (team && race) {
-                results[resultId] = ResultsInfo_team(resultId, team, race, grid, position, points);
-            }
-        }
-    }
-
-    return results;
-}
\ No newline at end of file
+#include "DataManager.hpp"
+#include "ThreadPool.hpp"
+#include "DataSnapshot.hpp"
+#include "FieldParser.hpp"
+#include <filesystem>
+#include <unordered_set>
+#include <set>
+#include <tuple>
+
+namespace {
+
+// Campo de texto del CSV; las comillas escapadas ("") solo se resuelven si las hay
+InternedString textField(string_view field) {
+    if (field.find('"') == string_view::npos) {
+        return InternedString(field);
+    }
+    return InternedString(MappedCSVReader::unescape(field));
+}
+
+// Inserta las entidades de 'loaded' que no existen en 'target' y llama a onAdded con cada una
+template <typename T, typename OnAdded>
+size_t mergeNew(map<int, T>& target, map<int, T>&& loaded, size_t& skipped, OnAdded onAdded) {
+    size_t added = 0;
+    for (auto& entry : loaded) {
+        auto inserted = target.emplace(entry.first, move(entry.second));
+        if (inserted.second) {
+            onAdded(inserted.first->second);
+            ++added;
+        } else {
+            ++skipped;
+        }
+    }
+    return added;
+}
+
+// Anade a 'target' las filas de 'delta' cuyo resultId no esta en 'loaded' (el indice
+// resultId -> fila de su sesion; carreras y sprints numeran sus resultId por separado)
+size_t appendNewResults(ResultsTable& target, ResultsTable& delta, const unordered_map<int32_t, uint32_t>& loaded, size_t& skipped) {
+    unordered_set<int32_t> seen;
+    size_t kept = 0;
+    for (size_t i = 0; i < delta.size(); ++i) {
+        if (loaded.count(delta.resultId[i]) || !seen.insert(delta.resultId[i]).second) {
+            ++skipped;
+            continue;
+        }
+        if (kept != i) {
+            delta.copyRow(i, kept);
+        }
+        ++kept;
+    }
+    delta.resize(kept);
+
+    target.appendRows(delta);
+    return kept;
+}
+
+}
+
+const DataManager::ResultLayout DataManager::RACE_LAYOUT = { 18, 15, 17, Session::Race };
+const DataManager::ResultLayout DataManager::SPRINT_LAYOUT = { 16, 14, 15, Session::Sprint };
+
+map<int, Circuit> DataManager::loadCircuits(const string& filename) {
+    MappedCSVReader reader(filename);
+    map<int, Circuit> circuits;
+    vector<string_view> row;
+
+    reader.skipRow();  // Cabecera
+    while (reader.nextRow(row)) {
+        if (row.size() >= 5) {
+            int id;
+            if (!FieldParser::parseInt(row[0], id)) {
+                cerr << "Error: identificador de circuito no valido: " << row[0] << endl;
+                continue;
+            }
+            InternedString name = textField(row[2]);
+            InternedString location = textField(row[3]);
+            InternedString country = textField(row[4]);
+            circuits[id] = Circuit(id, name, location, country, textField(row[1]));
+        }
+    }
+
+    return circuits;
+}
+
+map<int, Race> DataManager::loadRaces(const string& filename, const map<int, Circuit>& circuits) {
+    MappedCSVReader reader(filename);
+    reader.skipRow();  // Asumimos que la primera fila son encabezados
+    return joinRaces(parseRaces(reader), circuits);
+}
+
+vector<DataManager::RaceRow> DataManager::parseRaces(MappedCSVReader& reader) {
+    vector<RaceRow> rows;
+    vector<string_view> row;
+    while (reader.nextRow(row)) {
+        int raceId, year, circuitId;
+        if (row.size() >= 6 && FieldParser::parseInt(row[0], raceId) && FieldParser::parseInt(row[1], year)
+            && FieldParser::parseInt(row[3], circuitId)) {
+            rows.push_back({ raceId, year, circuitId, textField(row[4]), textField(row[5]) });
+        }
+    }
+    return rows;
+}
+
+map<int, Race> DataManager::joinRaces(const vector<RaceRow>& rows, const map<int, Circuit>& circuits) {
+    map<int, Race> races;
+    for (const RaceRow& row : rows) {
+        const Circuit* circuitPtr = nullptr;  // Cambiado a const Circuit*
+
+        if (circuits.find(row.circuitId) != circuits.end()) {
+            circuitPtr = &circuits.at(row.circuitId);
+        }
+
+        races[row.raceId] = Race(row.raceId, row.year, circuitPtr, row.name, row.date);
+    }
+    return races;
+}
+
+map<int, Driver> DataManager::loadDrivers(const string& filename) {
+    MappedCSVReader reader(filename);
+    map<int, Driver> drivers;
+    vector<string_view> row;
+
+    reader.skipRow();  // Asumimos que la primera fila son encabezados
+    while (reader.nextRow(row)) {
+        int driverId;
+        if (row.size() >= 8 && FieldParser::parseInt(row[0], driverId)) {
+            InternedString code = textField(row[3]);
+            InternedString fullName(MappedCSVReader::unescape(row[4]) + " " + MappedCSVReader::unescape(row[5])); // Assuming first name and last name are split
+            InternedString dob = textField(row[6]);
+            InternedString nationality = textField(row[7]);
+            drivers[driverId] = Driver(driverId, code, fullName, dob, nationality, textField(row[1]));
+        }
+    }
+
+    return drivers;
+}
+
+map<int, Team> DataManager::loadTeams(const string& filename) {
+    MappedCSVReader reader(filename);
+    map<int, Team> teams;
+    vector<string_view> row;
+
+    reader.skipRow();  // Asumiendo que la primera fila son encabezados
+    while (reader.nextRow(row)) {
+        int constructorId;
+        if (row.size() >= 4 && FieldParser::parseInt(row[0], constructorId)) {
+            InternedString name = textField(row[2]);
+            InternedString nationality = textField(row[3]);
+            teams[constructorId] = Team(constructorId, name, nationality, textField(row[1]));
+        }
+    }
+
+    return teams;
+}
+
+map<int, DriverStandings> DataManager::loadDriverStandings(const string& filename, const map<int, Race>& races, const map<int, Driver>& drivers) {
+    MappedCSVReader reader(filename);
+    vector<StandingRow> rows;
+
+    reader.skipRow();
+    parseStandingRange(reader, { reader.offset(), reader.fileSize() }, rows);
+    return joinDriverStandings(rows, races, drivers);
+}
+
+map<int, TeamStandings> DataManager::loadTeamStandings(const string& filename, const map<int, Race>& races, const map<int, Team>& teams) {
+    MappedCSVReader reader(filename);
+    vector<StandingRow> rows;
+
+    reader.skipRow();
+    parseStandingRange(reader, { reader.offset(), reader.fileSize() }, rows);
+    return joinTeamStandings(rows, races, teams);
+}
+
+// Lee results.csv una sola vez en la tabla columnar; el ano de cada carrera se desnormaliza aqui
+ResultsTable DataManager::loadResults(const string& filename, const map<int, Race>& races) {
+    MappedCSVReader reader(filename);
+    ResultsTable results;
+
+    results.reserve(reader.fileSize() / 64);
+    reader.skipRow();
+    parseResultRange(reader, { reader.offset(), reader.fileSize() }, results);
+    joinResults(results, races);
+    return results;
+}
+
+ResultsTable DataManager::loadSprintResults(const string& filename, const map<int, Race>& races) {
+    MappedCSVReader reader(filename);
+    ResultsTable results;
+
+    reader.skipRow();
+    parseResultRange(reader, { reader.offset(), reader.fileSize() }, results, SPRINT_LAYOUT);
+    joinResults(results, races);
+    return results;
+}
+
+PitStopTable DataManager::loadPitStops(const string& filename, const map<int, Race>& races, const ResultsTable& results,
+    const DataIndexes& indexes) {
+    MappedCSVReader reader(filename);
+    PitStopTable pitStops;
+
+    reader.skipRow();
+    parsePitStops(reader, pitStops);
+    joinPitStops(pitStops, races, results, indexes);
+    return pitStops;
+}
+
+QualifyingTable DataManager::loadQualifying(const string& filename, const map<int, Race>& races) {
+    MappedCSVReader reader(filename);
+    QualifyingTable qualifying;
+
+    reader.skipRow();
+    parseQualifying(reader, qualifying);
+    joinQualifying(qualifying, races);
+    return qualifying;
+}
+
+StatusDictionary DataManager::loadStatuses(const string& filename) {
+    MappedCSVReader reader(filename);
+    StatusDictionary statuses;
+    vector<string_view> row;
+
+    reader.skipRow();
+    while (reader.nextRow(row)) {
+        int statusId;
+        if (row.size() >= 2 && FieldParser::parseInt(row[0], statusId)) {
+            statuses.add(statusId, textField(row[1]));
+        }
+    }
+    return statuses;
+}
+
+// Lee las filas de un tramo de driver_standings.csv o constructor_standings.csv sin resolver punteros.
+// El tramo no debe incluir la cabecera.
+void DataManager::parseStandingRange(const MappedCSVReader& reader, pair<size_t, size_t> range, vector<StandingRow>& rows) {
+    vector<string_view> row;
+    size_t cursor = range.first;
+
+    while (reader.nextRowInRange(cursor, range.second, row)) {
+        StandingRow standing;
+        double points;
+        if (row.size() >= 7
+            && FieldParser::parseInt(row[0], standing.standingsId)
+            && FieldParser::parseInt(row[1], standing.raceId)
+            && FieldParser::parseInt(row[2], standing.entityId)
+            && FieldParser::parseDouble(row[3], points)
+            && FieldParser::parseInt(row[4], standing.position)
+            && FieldParser::parseInt(row[6], standing.winsNumber)) {
+            standing.points = points;
+            rows.push_back(standing);
+        }
+    }
+}
+
+map<int, DriverStandings> DataManager::joinDriverStandings(const vector<StandingRow>& rows, const map<int, Race>& races, const map<int, Driver>& drivers) {
+    map<int, DriverStandings> standings;
+    for (const auto& row : rows) {
+        auto raceIt = races.find(row.raceId);
+        auto driverIt = drivers.find(row.entityId);
+        const Race* race = raceIt != races.end() ? &raceIt->second : nullptr;
+        const Driver* driver = driverIt != drivers.end() ? &driverIt->second : nullptr;
+
+        standings[row.standingsId] = DriverStandings(row.standingsId, race, driver, row.points, row.position, row.winsNumber);
+    }
+    return standings;
+}
+
+map<int, TeamStandings> DataManager::joinTeamStandings(const vector<StandingRow>& rows, const map<int, Race>& races, const map<int, Team>& teams) {
+    map<int, TeamStandings> standings;
+    for (const auto& row : rows) {
+        auto raceIt = races.find(row.raceId);
+        auto teamIt = teams.find(row.entityId);
+        const Race* race = raceIt != races.end() ? &raceIt->second : nullptr;
+        const Team* team = teamIt != teams.end() ? &teamIt->second : nullptr;
+
+        standings[row.standingsId] = TeamStandings(row.standingsId, race, team, row.points, row.position, row.winsNumber);
+    }
+    return standings;
+}
+
+// Lee las filas de un tramo de results.csv (sin cabecera); el ano se rellena despues en joinResults
+void DataManager::parseResultRange(const MappedCSVReader& reader, pair<size_t, size_t> range, ResultsTable& results,
+    const ResultLayout& layout) {
+    vector<string_view> row;
+    size_t cursor = range.first;
+
+    while (reader.nextRowInRange(cursor, range.second, row)) {
+        // Obligatorias: raceId, grid y points. position es \N en las retiradas,
+        // descalificaciones y no salidas: se guarda como -1 y el motivo queda en statusId
+        int resultId, raceId, grid;
+        int32_t points;
+        if (row.size() >= layout.columns
+            && FieldParser::parseInt(row[0], resultId)
+            && FieldParser::parseInt(row[1], raceId)
+            && FieldParser::parseInt(row[5], grid)
+            && FieldParser::parsePoints(row[9], points)) {
+            int position = FieldParser::parseIntOr(row[6], -1);
+            // Opcionales: \N se guarda como -1
+            int32_t fastestLapMs;
+            if (!FieldParser::parseLapTime(row[layout.fastestLapTime], fastestLapMs)) {
+                fastestLapMs = -1;
+            }
+            results.append(resultId, raceId, FieldParser::parseIntOr(row[2], -1), FieldParser::parseIntOr(row[3], -1),
+                grid, position, points, 0,
+                FieldParser::parseIntOr(row[10], -1), FieldParser::parseIntOr(row[12], -1),
+                FieldParser::parseIntOr(row[13], -1), fastestLapMs, FieldParser::parseIntOr(row[layout.statusId], -1), layout.session);
+        }
+    }
+}
+
+// Rellena el ano de cada resultado y descarta los de carreras desconocidas
+void DataManager::joinResults(ResultsTable& results, const map<int, Race>& races) {
+    size_t kept = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        auto raceIt = races.find(results.raceId[i]);
+        if (raceIt == races.end()) {
+            continue;
+        }
+        results.year[i] = raceIt->second.year;
+        if (kept != i) {
+            results.copyRow(i, kept);
+        }
+        ++kept;
+    }
+    results.resize(kept);
+}
+
+// Lee qualifying.csv desde la posicion actual del lector (sin cabecera)
+void DataManager::parseQualifying(MappedCSVReader& reader, QualifyingTable& qualifying) {
+    vector<string_view> row;
+    qualifying.reserve(reader.fileSize() / 48);
+    while (reader.nextRow(row)) {
+        // qualifyId, raceId, driverId, constructorId, number, position, q1, q2, q3
+        int qualifyId, raceId, driverId;
+        if (row.size() >= 9
+            && FieldParser::parseInt(row[0], qualifyId)
+            && FieldParser::parseInt(row[1], raceId)
+            && FieldParser::parseInt(row[2], driverId)) {
+            // Sin tiempo (vacio o \N) se guarda como -1
+            int32_t times[3];
+            for (size_t session = 0; session < 3; ++session) {
+                if (!FieldParser::parseLapTime(row[6 + session], times[session])) {
+                    times[session] = -1;
+                }
+            }
+            qualifying.append(qualifyId, raceId, driverId, FieldParser::parseIntOr(row[3], -1),
+                FieldParser::parseIntOr(row[5], -1), times[0], times[1], times[2]);
+        }
+    }
+}
+
+// Rellena ano y circuito de cada fila y descarta las de carreras desconocidas
+void DataManager::joinQualifying(QualifyingTable& qualifying, const map<int, Race>& races) {
+    size_t kept = 0;
+    for (size_t i = 0; i < qualifying.size(); ++i) {
+        auto raceIt = races.find(qualifying.raceId[i]);
+        if (raceIt == races.end()) {
+            continue;
+        }
+        qualifying.year[i] = raceIt->second.year;
+        qualifying.circuitId[i] = raceIt->second.circuit ? raceIt->second.circuit->circuitId : -1;
+        if (kept != i) {
+            qualifying.copyRow(i, kept);
+        }
+        ++kept;
+    }
+    qualifying.resize(kept);
+}
+
+// Lee pit_stops.csv desde la posicion actual del lector (sin cabecera)
+void DataManager::parsePitStops(MappedCSVReader& reader, PitStopTable& pitStops) {
+    vector<string_view> row;
+    pitStops.reserve(reader.fileSize() / 40);
+    while (reader.nextRow(row)) {
+        // raceId, driverId, stop, lap, time, duration, milliseconds
+        int raceId, driverId, stop, lap, milliseconds;
+        if (row.size() >= 7
+            && FieldParser::parseInt(row[0], raceId)
+            && FieldParser::parseInt(row[1], driverId)
+            && FieldParser::parseInt(row[2], stop)
+            && FieldParser::parseInt(row[3], lap)
+            && FieldParser::parseInt(row[6], milliseconds)) {
+            pitStops.append(raceId, driverId, stop, lap, milliseconds);
+        }
+    }
+}
+
+// Rellena ano, circuito y equipo de cada parada y descarta las de carreras desconocidas
+void DataManager::joinPitStops(PitStopTable& pitStops, const map<int, Race>& races, const ResultsTable& results,
+    const DataIndexes& indexes) {
+    size_t kept = 0;
+    for (size_t i = 0; i < pitStops.size(); ++i) {
+        auto raceIt = races.find(pitStops.raceId[i]);
+        if (raceIt == races.end()) {
+            continue;
+        }
+        pitStops.year[i] = raceIt->second.year;
+        pitStops.circuitId[i] = raceIt->second.circuit ? raceIt->second.circuit->circuitId : -1;
+
+        // Las paradas son recientes, asi que se busca desde el final de las filas del piloto
+        auto driverRows = indexes.resultsByDriver.find(pitStops.driverId[i]);
+        if (driverRows != indexes.resultsByDriver.end()) {
+            for (auto row = driverRows->second.rbegin(); row != driverRows->second.rend(); ++row) {
+                if (results.raceId[*row] == pitStops.raceId[i]) {
+                    pitStops.constructorId[i] = results.constructorId[*row];
+                    break;
+                }
+            }
+        }
+
+        if (kept != i) {
+            pitStops.copyRow(i, kept);
+        }
+        ++kept;
+    }
+    pitStops.resize(kept);
+}
+
+// Carga todos los ficheros en paralelo respetando sus dependencias:
+//  - circuits, drivers y constructors no dependen de nada;
+//  - races necesita circuits;
+//  - las clasificaciones y los resultados se trocean y se analizan en paralelo
+//    desde el principio, y sus punteros se resuelven en una fase de union
+//    cuando races, drivers y teams ya estan listos.
+Dataset DataManager::loadAll(const string& directory, size_t threads) {
+    Dataset data;
+    string prefix = directory.empty() ? "" : directory + "/";
+
+    // Los ficheros grandes se reparten por tramos entre los hilos
+    MappedCSVReader driverStandingsReader(prefix + "driver_standings.csv");
+    MappedCSVReader teamStandingsReader(prefix + "constructor_standings.csv");
+    MappedCSVReader resultsReader(prefix + "results.csv");
+    driverStandingsReader.skipRow();
+    teamStandingsReader.skipRow();
+    resultsReader.skipRow();
+
+    // Todo lo que las tareas usan por referencia se declara antes del pool: si
+    // una excepcion sale de aqui, el destructor del pool aun ejecuta las
+    // tareas pendientes y estos objetos deben seguir vivos
+    vector<future<vector<StandingRow>>> driverStandingChunks;
+    vector<future<vector<StandingRow>>> teamStandingChunks;
+    vector<future<ResultsTable>> resultChunks;
+    future<ResultsTable> sprintsParsed;
+    ThreadPool pool(threads == 0 ? thread::hardware_concurrency() : threads);
+
+    // Fase 1: ficheros independientes
+    // Las dependencias son shared_future: cada hilo espera sobre su propia copia
+    shared_future<void> circuitsDone = pool.submit([&]() { data.circuits = loadCircuits(prefix + "circuits.csv"); }).share();
+    shared_future<void> driversDone = pool.submit([&]() { data.drivers = loadDrivers(prefix + "drivers.csv"); }).share();
+    shared_future<void> teamsDone = pool.submit([&]() { data.teams = loadTeams(prefix + "constructors.csv"); }).share();
+
+    for (auto range : driverStandingsReader.splitRanges(pool.size())) {
+        driverStandingChunks.push_back(pool.submit([&, range]() {
+            vector<StandingRow> rows;
+            parseStandingRange(driverStandingsReader, range, rows);
+            return rows;
+        }));
+    }
+
+    for (auto range : teamStandingsReader.splitRanges(pool.size())) {
+        teamStandingChunks.push_back(pool.submit([&, range]() {
+            vector<StandingRow> rows;
+            parseStandingRange(teamStandingsReader, range, rows);
+            return rows;
+        }));
+    }
+
+    // pit_stops.csv es pequeno: se lee entero en un solo hilo
+    auto pitStopsParsed = pool.submit([&]() {
+        MappedCSVReader reader(prefix + "pit_stops.csv");
+        PitStopTable pitStops;
+        reader.skipRow();
+        parsePitStops(reader, pitStops);
+        return pitStops;
+    });
+
+    // sprint_results.csv tambien es pequeno; sus filas se anaden a data.results como sesion Sprint
+    sprintsParsed = pool.submit([&]() {
+        MappedCSVReader reader(prefix + "sprint_results.csv");
+        ResultsTable sprints;
+        reader.skipRow();
+        parseResultRange(reader, { reader.offset(), reader.fileSize() }, sprints, SPRINT_LAYOUT);
+        return sprints;
+    });
+
+    // status.csv es un diccionario de unas 140 filas
+    auto statusesParsed = pool.submit([&]() { return loadStatuses(prefix + "status.csv"); });
+
+    // qualifying.csv tambien es pequeno
+    auto qualifyingParsed = pool.submit([&]() {
+        MappedCSVReader reader(prefix + "qualifying.csv");
+        QualifyingTable qualifying;
+        reader.skipRow();
+        parseQualifying(reader, qualifying);
+        return qualifying;
+    });
+
+    for (auto range : resultsReader.splitRanges(pool.size())) {
+        resultChunks.push_back(pool.submit([&, range]() {
+            ResultsTable chunk;
+            chunk.reserve((range.second - range.first) / 64);
+            parseResultRange(resultsReader, range, chunk);
+            return chunk;
+        }));
+    }
+
+    // races depende de circuits (enviado antes, por lo que la espera no bloquea el pool)
+    shared_future<void> racesDone = pool.submit([&, circuitsDone]() {
+        circuitsDone.wait();
+        data.races = loadRaces(prefix + "races.csv", data.circuits);
+    }).share();
+
+    // Fase 2: union de los tramos y resolucion de punteros
+    auto driverStandingsDone = pool.submit([&, racesDone, driversDone]() {
+        vector<StandingRow> rows;
+        for (auto& chunk : driverStandingChunks) {
+            vector<StandingRow> part = chunk.get();
+            rows.insert(rows.end(), part.begin(), part.end());
+        }
+        racesDone.wait();
+        driversDone.wait();
+        data.driverStandings = joinDriverStandings(rows, data.races, data.drivers);
+    });
+
+    auto teamStandingsDone = pool.submit([&, racesDone, teamsDone]() {
+        vector<StandingRow> rows;
+        for (auto& chunk : teamStandingChunks) {
+            vector<StandingRow> part = chunk.get();
+            rows.insert(rows.end(), part.begin(), part.end());
+        }
+        racesDone.wait();
+        teamsDone.wait();
+        data.teamStandings = joinTeamStandings(rows, data.races, data.teams);
+    });
+
+    auto resultsDone = pool.submit([&, racesDone]() {
+        ResultsTable merged;
+        for (auto& chunk : resultChunks) {
+            merged.appendRows(chunk.get());
+        }
+        merged.appendRows(sprintsParsed.get());
+        racesDone.wait();
+        joinResults(merged, data.races);
+        data.results = move(merged);
+    });
+
+    // get() propaga cualquier excepcion lanzada en los hilos
+    circuitsDone.get();
+    driversDone.get();
+    teamsDone.get();
+    racesDone.get();
+    driverStandingsDone.get();
+    teamStandingsDone.get();
+    resultsDone.get();
+
+    data.indexes = buildIndexes(data.races, data.results, data.driverStandings, data.teamStandings);
+    data.indexes.indexNames(data.circuits, data.drivers, data.teams);
+
+    // Las paradas se unen al final porque necesitan el indice de resultados
+    data.pitStops = pitStopsParsed.get();
+    joinPitStops(data.pitStops, data.races, data.results, data.indexes);
+    data.indexes.indexPitStops(data.pitStops);
+
+    data.qualifying = qualifyingParsed.get();
+    joinQualifying(data.qualifying, data.races);
+    data.indexes.indexQualifying(data.qualifying);
+
+    data.statuses = statusesParsed.get();
+    data.indexes.indexReliability(data.results, data.statuses, data.races);
+    return data;
+}
+
+Dataset DataManager::loadCached(const string& directory, const string& snapshotPath) {
+    Dataset data;
+    if (DataSnapshot::read(snapshotPath, directory, data)) {
+        return data;
+    }
+
+    data = loadAll(directory);
+    if (!DataSnapshot::write(data, directory, snapshotPath)) {
+        cerr << "Aviso: no se pudo escribir la instantanea " << snapshotPath << endl;
+    }
+    return data;
+}
+
+// Construye los indices secundarios una vez cargadas todas las tablas
+DataIndexes DataManager::buildIndexes(const map<int, Race>& races, const ResultsTable& results,
+    const map<int, DriverStandings>& driverStandings, const map<int, TeamStandings>& teamStandings) {
+    DataIndexes indexes;
+    indexes.indexResults(results);
+    indexes.indexStandings(driverStandings, teamStandings);
+    indexes.indexRaces(races);
+    indexes.indexCircuits(races);
+    return indexes;
+}
+
+DeltaSummary DataManager::appendDelta(Dataset& data, const string& directory) {
+    return applyDelta(data, readDelta(directory));
+}
+
+// Solo lee y analiza los CSV; nada depende todavia de 'data'
+DataManager::DeltaFiles DataManager::readDelta(const string& directory) {
+    DeltaFiles delta;
+    string prefix = directory.empty() ? "" : directory + "/";
+    auto present = [&](const char* name) {
+        error_code error;
+        return filesystem::is_regular_file(prefix + name, error);
+    };
+
+    if (present("circuits.csv")) {
+        delta.circuits = loadCircuits(prefix + "circuits.csv");
+    }
+    if (present("drivers.csv")) {
+        delta.drivers = loadDrivers(prefix + "drivers.csv");
+    }
+    if (present("constructors.csv")) {
+        delta.teams = loadTeams(prefix + "constructors.csv");
+    }
+    if (present("status.csv")) {
+        delta.statuses = loadStatuses(prefix + "status.csv");
+    }
+    if (present("races.csv")) {
+        MappedCSVReader reader(prefix + "races.csv");
+        reader.skipRow();
+        delta.races = parseRaces(reader);
+    }
+    if (present("driver_standings.csv")) {
+        MappedCSVReader reader(prefix + "driver_standings.csv");
+        reader.skipRow();
+        parseStandingRange(reader, { reader.offset(), reader.fileSize() }, delta.driverStandings);
+    }
+    if (present("constructor_standings.csv")) {
+        MappedCSVReader reader(prefix + "constructor_standings.csv");
+        reader.skipRow();
+        parseStandingRange(reader, { reader.offset(), reader.fileSize() }, delta.teamStandings);
+    }
+    if (present("results.csv")) {
+        MappedCSVReader reader(prefix + "results.csv");
+        reader.skipRow();
+        parseResultRange(reader, { reader.offset(), reader.fileSize() }, delta.results);
+    }
+    if (present("sprint_results.csv")) {
+        MappedCSVReader reader(prefix + "sprint_results.csv");
+        reader.skipRow();
+        parseResultRange(reader, { reader.offset(), reader.fileSize() }, delta.sprintResults, SPRINT_LAYOUT);
+    }
+    if (present("pit_stops.csv")) {
+        MappedCSVReader reader(prefix + "pit_stops.csv");
+        reader.skipRow();
+        parsePitStops(reader, delta.pitStops);
+    }
+    if (present("qualifying.csv")) {
+        MappedCSVReader reader(prefix + "qualifying.csv");
+        reader.skipRow();
+        parseQualifying(reader, delta.qualifying);
+    }
+    return delta;
+}
+
+// Carga incremental: el coste depende del tamano del delta, no del historico.
+// Orden: entidades sin dependencias, carreras, y despues clasificaciones y
+// resultados, que se enlazan con los map ya ampliados de 'data'.
+DeltaSummary DataManager::applyDelta(Dataset& data, DeltaFiles&& delta) {
+    DeltaSummary summary;
+    summary.firstNewResult = data.results.size();
+    summary.firstNewQualifying = data.qualifying.size();
+    DataIndexes& indexes = data.indexes;
+
+    summary.circuits = mergeNew(data.circuits, move(delta.circuits), summary.skipped,
+        [&](const Circuit& circuit) { indexes.names.addCircuit(circuit); });
+    summary.drivers = mergeNew(data.drivers, move(delta.drivers), summary.skipped,
+        [&](const Driver& driver) { indexes.names.addDriver(driver); });
+    summary.teams = mergeNew(data.teams, move(delta.teams), summary.skipped,
+        [&](const Team& team) { indexes.names.addTeam(team); });
+
+    vector<int> addedStatuses;
+    for (size_t statusId = 0; statusId < delta.statuses.size(); ++statusId) {
+        if (!delta.statuses.contains(static_cast<int>(statusId))) {
+            continue;
+        }
+        if (data.statuses.contains(static_cast<int>(statusId))) {
+            ++summary.skipped;
+        } else {
+            data.statuses.add(static_cast<int>(statusId), delta.statuses.names[statusId]);
+            addedStatuses.push_back(static_cast<int>(statusId));
+            ++summary.statuses;
+        }
+    }
+
+    vector<const Race*> racesAdded;
+    summary.races = mergeNew(data.races, joinRaces(delta.races, data.circuits), summary.skipped,
+        [&](const Race& race) { racesAdded.push_back(&race); });
+    indexes.appendRaces(racesAdded);
+
+    vector<const DriverStandings*> driverAdded;
+    vector<const TeamStandings*> teamAdded;
+    summary.driverStandings = mergeNew(data.driverStandings,
+        joinDriverStandings(delta.driverStandings, data.races, data.drivers), summary.skipped,
+        [&](const DriverStandings& standing) { driverAdded.push_back(&standing); });
+    summary.teamStandings = mergeNew(data.teamStandings,
+        joinTeamStandings(delta.teamStandings, data.races, data.teams), summary.skipped,
+        [&](const TeamStandings& standing) { teamAdded.push_back(&standing); });
+    indexes.appendStandings(driverAdded, teamAdded);
+
+    joinResults(delta.results, data.races);
+    summary.results = appendNewResults(data.results, delta.results,
+        indexes.resultRowById[static_cast<size_t>(Session::Race)], summary.skipped);
+    joinResults(delta.sprintResults, data.races);
+    summary.sprintResults = appendNewResults(data.results, delta.sprintResults,
+        indexes.resultRowById[static_cast<size_t>(Session::Sprint)], summary.skipped);
+    indexes.appendResults(data.results, summary.firstNewResult);
+
+    // Despues de los resultados, para encontrar el equipo de las paradas nuevas
+    if (!delta.pitStops.empty()) {
+        PitStopTable& pitStops = delta.pitStops;
+        joinPitStops(pitStops, data.races, data.results, indexes);
+
+        // Una parada se identifica por (carrera, piloto, numero de parada)
+        set<tuple<int32_t, int32_t, int32_t>> seen;
+        size_t kept = 0;
+        for (size_t i = 0; i < pitStops.size(); ++i) {
+            bool duplicate = !seen.emplace(pitStops.raceId[i], pitStops.driverId[i], pitStops.stop[i]).second;
+            auto raceRows = indexes.pitStopsByRace.find(pitStops.raceId[i]);
+            if (!duplicate && raceRows != indexes.pitStopsByRace.end()) {
+                for (uint32_t row : raceRows->second) {
+                    if (data.pitStops.driverId[row] == pitStops.driverId[i] && data.pitStops.stop[row] == pitStops.stop[i]) {
+                        duplicate = true;
+                        break;
+                    }
+                }
+            }
+            if (duplicate) {
+                ++summary.skipped;
+                continue;
+            }
+            if (kept != i) {
+                pitStops.copyRow(i, kept);
+            }
+            ++kept;
+        }
+        pitStops.resize(kept);
+
+        size_t firstNewStop = data.pitStops.size();
+        data.pitStops.appendRows(pitStops);
+        summary.pitStops = kept;
+        indexes.indexPitStops(data.pitStops, firstNewStop);
+    }
+
+    if (!delta.qualifying.empty()) {
+        QualifyingTable& qualifying = delta.qualifying;
+        joinQualifying(qualifying, data.races);
+
+        // Mismo criterio que los resultados: qualifyId ya cargado se descarta
+        unordered_set<int32_t> seen;
+        size_t kept = 0;
+        for (size_t i = 0; i < qualifying.size(); ++i) {
+            if (indexes.qualifyingRowById.count(qualifying.qualifyId[i]) || !seen.insert(qualifying.qualifyId[i]).second) {
+                ++summary.skipped;
+                continue;
+            }
+            if (kept != i) {
+                qualifying.copyRow(i, kept);
+            }
+            ++kept;
+        }
+        qualifying.resize(kept);
+
+        size_t firstNewRow = data.qualifying.size();
+        data.qualifying.appendRows(qualifying);
+        summary.qualifying = kept;
+        indexes.indexQualifying(data.qualifying, firstNewRow);
+    }
+
+    if (summary.statuses || data.results.size() > summary.firstNewResult) {
+        indexes.appendReliability(data.results, data.statuses, data.races, summary.firstNewResult, addedStatuses);
+    }
+    return summary;
+}
@@ -1,31 +1,140 @@
-#ifndef DATAMANAGER_HPP
-#define DATAMANAGER_HPP
-
-#include <map>
-#include <string>
-#include <iostream>
-#include "Circuit.hpp"
-#include "Race.hpp"
-#include "Driver.hpp"
-#include "Team.hpp"
-#include "TeamStandings.hpp"
-#include "DriverStandings.hpp"
-#include "ResultsInfo_driver.hpp"
-#include "ResultsInfo_team.hpp"
-#include "CSVReader.hpp"
-
-using namespace std;
-
-class DataManager {
-public:
-    map<int, Circuit> loadCircuits(const string& filename);
-    map<int, Race> loadRaces(const string& filename, const map<int, Circuit>& circuits);
-    map<int, Driver> loadDrivers(const string& filename);
-    map<int, Team> loadTeams(const string& filename);
-    map<int, DriverStandings> loadDriverStandings(const string& filename, const map<int, Race>& races, const map<int, Driver>& drivers);
-    map<int, TeamStandings> loadTeamStandings(const string& filename, const map<int, Race>& races, const map<int, Team>& teams);
-    map<int, ResultsInfo_driver> loadDriverResults(const string& filename, const map<int, Driver>& drivers, const map<int, Race>& races);
-    map<int, ResultsInfo_team> loadTeamResults(const string& filename, const map<int, Team>& teams, const map<int, Race>& races);
-};
-
+#ifndef DATAMANAGER_HPP
+#define DATAMANAGER_HPP
+
+#include <map>
+#include <string>
+#include <iostream>
+#include "Circuit.hpp"
+#include "Race.hpp"
+#include "Driver.hpp"
+#include "Team.hpp"
+#include "TeamStandings.hpp"
+#include "DriverStandings.hpp"
+#include "ResultsTable.hpp"
+#include "DataIndexes.hpp"
+#include "Dataset.hpp"
+#include "MappedCSVReader.hpp"
+
+using namespace std;
+
+// Filas incorporadas por DataManager::appendDelta
+struct DeltaSummary {
+    size_t circuits = 0;
+    size_t races = 0;
+    size_t drivers = 0;
+    size_t teams = 0;
+    size_t driverStandings = 0;
+    size_t teamStandings = 0;
+    size_t results = 0;
+    size_t sprintResults = 0;
+    size_t pitStops = 0;
+    size_t qualifying = 0;
+    size_t statuses = 0;
+    size_t skipped = 0;         // Filas cuyo id ya estaba cargado
+    size_t firstNewResult = 0;  // Primera fila nueva de data.results (carreras y sprints)
+    size_t firstNewQualifying = 0;  // Primera fila nueva de data.qualifying
+
+    size_t added() const { return circuits + races + drivers + teams + driverStandings + teamStandings + results + sprintResults + pitStops + qualifying + statuses; }
+};
+
+class DataManager {
+private:
+    // Fila de clasificacion sin resolver (comun a pilotos y equipos)
+    struct StandingRow {
+        int standingsId;
+        int raceId;
+        int entityId;
+        double points;
+        int position;
+        int winsNumber;
+    };
+
+    // Fila de races.csv sin resolver el circuito
+    struct RaceRow {
+        int raceId;
+        int year;
+        int circuitId;
+        InternedString name;
+        InternedString date;
+    };
+
+public:
+    // CSV de un directorio delta ya leidos y sin enlazar con ningun Dataset
+    // (readDelta); los ficheros que no estan quedan vacios
+    struct DeltaFiles {
+        map<int, Circuit> circuits;
+        map<int, Driver> drivers;
+        map<int, Team> teams;
+        StatusDictionary statuses;
+        vector<RaceRow> races;
+        vector<StandingRow> driverStandings;
+        vector<StandingRow> teamStandings;
+        ResultsTable results;
+        ResultsTable sprintResults;
+        PitStopTable pitStops;
+        QualifyingTable qualifying;
+    };
+
+    map<int, Circuit> loadCircuits(const string& filename);
+    map<int, Race> loadRaces(const string& filename, const map<int, Circuit>& circuits);
+    map<int, Driver> loadDrivers(const string& filename);
+    map<int, Team> loadTeams(const string& filename);
+    map<int, DriverStandings> loadDriverStandings(const string& filename, const map<int, Race>& races, const map<int, Driver>& drivers);
+    map<int, TeamStandings> loadTeamStandings(const string& filename, const map<int, Race>& races, const map<int, Team>& teams);
+    ResultsTable loadResults(const string& filename, const map<int, Race>& races);
+    // sprint_results.csv: mismas columnas que results.csv salvo 'rank'; filas de sesion Sprint
+    ResultsTable loadSprintResults(const string& filename, const map<int, Race>& races);
+    // Necesita los resultados ya indexados para saber el equipo de cada piloto en cada carrera
+    PitStopTable loadPitStops(const string& filename, const map<int, Race>& races, const ResultsTable& results,
+        const DataIndexes& indexes);
+    QualifyingTable loadQualifying(const string& filename, const map<int, Race>& races);
+    StatusDictionary loadStatuses(const string& filename);
+    DataIndexes buildIndexes(const map<int, Race>& races, const ResultsTable& results,
+        const map<int, DriverStandings>& driverStandings, const map<int, TeamStandings>& teamStandings);
+
+    // Carga todo el directorio en paralelo (threads = 0 usa todos los nucleos)
+    Dataset loadAll(const string& directory, size_t threads = 0);
+
+    // Usa la instantanea binaria si sigue al dia con los CSV; si no, carga los
+    // CSV y vuelve a escribir la instantanea para el siguiente arranque
+    Dataset loadCached(const string& directory, const string& snapshotPath);
+
+    // Anade a 'data' las filas de los CSV presentes en 'directory' (mismos
+    // nombres y cabeceras que Database/; los que falten se ignoran). Solo se
+    // leen los ficheros del delta y los indices se actualizan con las filas
+    // nuevas; las filas con un id ya cargado se descartan, asi que aplicar el
+    // mismo delta dos veces no duplica nada. Despues hay que llamar a
+    // RankingEngine::appendResults(summary.firstNewResult).
+    // Equivale a applyDelta(data, readDelta(directory)): la lectura, que es la
+    // parte cara, no necesita 'data' y puede hacerse sin bloquear a quien lo use.
+    DeltaSummary appendDelta(Dataset& data, const string& directory);
+    DeltaFiles readDelta(const string& directory);
+    DeltaSummary applyDelta(Dataset& data, DeltaFiles&& delta);
+
+private:
+    static vector<RaceRow> parseRaces(MappedCSVReader& reader);
+    static map<int, Race> joinRaces(const vector<RaceRow>& rows, const map<int, Circuit>& circuits);
+    static void parseStandingRange(const MappedCSVReader& reader, pair<size_t, size_t> range, vector<StandingRow>& rows);
+    static map<int, DriverStandings> joinDriverStandings(const vector<StandingRow>& rows, const map<int, Race>& races, const map<int, Driver>& drivers);
+    static map<int, TeamStandings> joinTeamStandings(const vector<StandingRow>& rows, const map<int, Race>& races, const map<int, Team>& teams);
+    // Posicion de las columnas que cambian entre results.csv y sprint_results.csv
+    struct ResultLayout {
+        size_t columns;
+        size_t fastestLapTime;
+        size_t statusId;
+        Session session;
+    };
+    static const ResultLayout RACE_LAYOUT;
+    static const ResultLayout SPRINT_LAYOUT;
+
+    static void parseResultRange(const MappedCSVReader& reader, pair<size_t, size_t> range, ResultsTable& results,
+        const ResultLayout& layout = RACE_LAYOUT);
+    static void joinResults(ResultsTable& results, const map<int, Race>& races);
+    static void parseQualifying(MappedCSVReader& reader, QualifyingTable& qualifying);
+    static void joinQualifying(QualifyingTable& qualifying, const map<int, Race>& races);
+    static void parsePitStops(MappedCSVReader& reader, PitStopTable& pitStops);
+    static void joinPitStops(PitStopTable& pitStops, const map<int, Race>& races, const ResultsTable& results,
+        const DataIndexes& indexes);
+};
+
 #endif //DATAMANAGER_HPP
\ No newline at end of file
@@ -0,0 +1,506 @@
+#include "DataSnapshot.hpp"
+#include "MappedFile.hpp"
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+#include <cstring>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = { 'F', '1', 'S', 'N', 'A', 'P', 0, 0 };
+
+uint64_t fnv1a(const char* bytes, size_t length) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<unsigned char>(bytes[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Tamano y fecha de modificacion de un fichero fuente
+struct SourceStamp {
+    string name;
+    uint64_t size;
+    int64_t mtime;
+};
+
+bool stampSource(const string& directory, const string& name, SourceStamp& stamp) {
+    error_code error;
+    filesystem::path path = filesystem::path(directory) / name;
+    uint64_t size = filesystem::file_size(path, error);
+    if (error) {
+        return false;
+    }
+    auto mtime = filesystem::last_write_time(path, error);
+    if (error) {
+        return false;
+    }
+    stamp.name = name;
+    stamp.size = size;
+    stamp.mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+    return true;
+}
+
+// Buffer de escritura con cadenas internadas
+class SnapshotWriter {
+public:
+    vector<char> bytes;
+
+    template <typename T>
+    void put(T value) {
+        const char* raw = reinterpret_cast<const char*>(&value);
+        bytes.insert(bytes.end(), raw, raw + sizeof(T));
+    }
+
+    void putColumn(const vector<int32_t>& column) {
+        put<uint32_t>(static_cast<uint32_t>(column.size()));
+        const char* raw = reinterpret_cast<const char*>(column.data());
+        bytes.insert(bytes.end(), raw, raw + column.size() * sizeof(int32_t));
+    }
+
+    void putString(const string& text) {
+        put<uint32_t>(static_cast<uint32_t>(text.size()));
+        bytes.insert(bytes.end(), text.begin(), text.end());
+    }
+
+    // Devuelve el indice de la cadena en la tabla, anadiendola si es nueva
+    int32_t intern(InternedString text) {
+        auto it = stringIds.find(text.index());
+        if (it != stringIds.end()) {
+            return it->second;
+        }
+        int32_t id = static_cast<int32_t>(strings.size());
+        strings.push_back(text);
+        stringIds.emplace(text.index(), id);
+        return id;
+    }
+
+    vector<InternedString> strings;
+
+private:
+    unordered_map<uint32_t, int32_t> stringIds; // id en StringPool -> indice en la tabla
+};
+
+// Lector con comprobacion de limites sobre los bytes proyectados
+class SnapshotReader {
+public:
+    SnapshotReader(const char* data, size_t size) : data(data), size(size), pos(0), failed(false) {}
+
+    bool ok() const { return !failed; }
+    size_t offset() const { return pos; }
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (pos + sizeof(T) > size) {
+            failed = true;
+            return value;
+        }
+        memcpy(&value, data + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    vector<int32_t> getColumn() {
+        uint32_t count = get<uint32_t>();
+        vector<int32_t> column;
+        if (failed || pos + static_cast<size_t>(count) * sizeof(int32_t) > size) {
+            failed = true;
+            return column;
+        }
+        column.resize(count);
+        memcpy(column.data(), data + pos, count * sizeof(int32_t));
+        pos += count * sizeof(int32_t);
+        return column;
+    }
+
+    string getString() {
+        uint32_t length = get<uint32_t>();
+        if (failed || pos + length > size) {
+            failed = true;
+            return "";
+        }
+        string text(data + pos, length);
+        pos += length;
+        return text;
+    }
+
+private:
+    const char* data;
+    size_t size;
+    size_t pos;
+    bool failed;
+};
+
+}
+
+vector<string> DataSnapshot::sourceFiles() {
+    return { "circuits.csv", "races.csv", "drivers.csv", "constructors.csv",
+             "driver_standings.csv", "constructor_standings.csv", "results.csv", "pit_stops.csv",
+             "qualifying.csv", "sprint_results.csv", "status.csv" };
+}
+
+bool DataSnapshot::write(const Dataset& data, const string& directory, const string& snapshotPath) {
+    SnapshotWriter payload;
+
+    // Entidades: columnas de enteros con indices a la tabla de cadenas
+    vector<int32_t> circuitIds, circuitNames, circuitLocations, circuitCountries, circuitRefs;
+    for (const auto& entry : data.circuits) {
+        circuitIds.push_back(entry.first);
+        circuitNames.push_back(payload.intern(entry.second.name));
+        circuitLocations.push_back(payload.intern(entry.second.location));
+        circuitCountries.push_back(payload.intern(entry.second.country));
+        circuitRefs.push_back(payload.intern(entry.second.circuitRef));
+    }
+
+    vector<int32_t> raceIds, raceYears, raceCircuits, raceNames, raceDates;
+    for (const auto& entry : data.races) {
+        raceIds.push_back(entry.first);
+        raceYears.push_back(entry.second.year);
+        raceCircuits.push_back(entry.second.circuit ? entry.second.circuit->circuitId : -1);
+        raceNames.push_back(payload.intern(entry.second.name));
+        raceDates.push_back(payload.intern(entry.second.date));
+    }
+
+    vector<int32_t> driverIds, driverCodes, driverNames, driverDobs, driverNationalities, driverRefs;
+    for (const auto& entry : data.drivers) {
+        driverIds.push_back(entry.first);
+        driverCodes.push_back(payload.intern(entry.second.code));
+        driverNames.push_back(payload.intern(entry.second.fullName));
+        driverDobs.push_back(payload.intern(entry.second.dob));
+        driverNationalities.push_back(payload.intern(entry.second.nationality));
+        driverRefs.push_back(payload.intern(entry.second.driverRef));
+    }
+
+    vector<int32_t> teamIds, teamNames, teamNationalities, teamRefs;
+    for (const auto& entry : data.teams) {
+        teamIds.push_back(entry.first);
+        teamNames.push_back(payload.intern(entry.second.name));
+        teamNationalities.push_back(payload.intern(entry.second.nationality));
+        teamRefs.push_back(payload.intern(entry.second.teamRef));
+    }
+
+    // Diccionario de estados (la clase se vuelve a deducir del texto al leer)
+    vector<int32_t> statusIds, statusNames;
+    for (size_t statusId = 0; statusId < data.statuses.size(); ++statusId) {
+        if (data.statuses.contains(static_cast<int>(statusId))) {
+            statusIds.push_back(static_cast<int32_t>(statusId));
+            statusNames.push_back(payload.intern(data.statuses.names[statusId]));
+        }
+    }
+
+    // Tabla de cadenas
+    payload.put<uint32_t>(static_cast<uint32_t>(payload.strings.size()));
+    for (InternedString text : payload.strings) {
+        payload.putString(text.str());
+    }
+
+    payload.putColumn(circuitIds);
+    payload.putColumn(circuitNames);
+    payload.putColumn(circuitLocations);
+    payload.putColumn(circuitCountries);
+    payload.putColumn(circuitRefs);
+
+    payload.putColumn(raceIds);
+    payload.putColumn(raceYears);
+    payload.putColumn(raceCircuits);
+    payload.putColumn(raceNames);
+    payload.putColumn(raceDates);
+
+    payload.putColumn(driverIds);
+    payload.putColumn(driverCodes);
+    payload.putColumn(driverNames);
+    payload.putColumn(driverDobs);
+    payload.putColumn(driverNationalities);
+    payload.putColumn(driverRefs);
+
+    payload.putColumn(teamIds);
+    payload.putColumn(teamNames);
+    payload.putColumn(teamNationalities);
+    payload.putColumn(teamRefs);
+
+    payload.putColumn(statusIds);
+    payload.putColumn(statusNames);
+
+    // Clasificaciones
+    vector<int32_t> sIds, sRaces, sEntities, sPoints, sPositions, sWins;
+    for (const auto& entry : data.driverStandings) {
+        sIds.push_back(entry.first);
+        sRaces.push_back(entry.second.race ? entry.second.race->raceId : -1);
+        sEntities.push_back(entry.second.driver ? entry.second.driver->driverId : -1);
+        sPoints.push_back(static_cast<int32_t>(llround(entry.second.points * 100)));
+        sPositions.push_back(entry.second.position);
+        sWins.push_back(entry.second.winsNumber);
+    }
+    for (const auto* column : { &sIds, &sRaces, &sEntities, &sPoints, &sPositions, &sWins }) {
+        payload.putColumn(*column);
+    }
+
+    sIds.clear(); sRaces.clear(); sEntities.clear(); sPoints.clear(); sPositions.clear(); sWins.clear();
+    for (const auto& entry : data.teamStandings) {
+        sIds.push_back(entry.first);
+        sRaces.push_back(entry.second.race ? entry.second.race->raceId : -1);
+        sEntities.push_back(entry.second.team ? entry.second.team->teamId : -1);
+        sPoints.push_back(static_cast<int32_t>(llround(entry.second.points * 100)));
+        sPositions.push_back(entry.second.position);
+        sWins.push_back(entry.second.winsNumber);
+    }
+    for (const auto* column : { &sIds, &sRaces, &sEntities, &sPoints, &sPositions, &sWins }) {
+        payload.putColumn(*column);
+    }
+
+    // Resultados de carreras y sprints: las columnas se copian tal cual (la sesion se ensancha a 32 bits)
+    const ResultsTable& results = data.results;
+    for (const auto* column : { &results.resultId, &results.raceId, &results.driverId, &results.constructorId,
+                                &results.grid, &results.position, &results.points, &results.year,
+                                &results.laps, &results.milliseconds, &results.fastestLap, &results.fastestLapMs,
+                                &results.statusId }) {
+        payload.putColumn(*column);
+    }
+    payload.putColumn(vector<int32_t>(results.session.begin(), results.session.end()));
+
+    // Indices de resultados en formato CSR (claves, desplazamientos, filas)
+    for (const auto* index : { &data.indexes.resultsByDriver, &data.indexes.resultsByTeam }) {
+        vector<int32_t> keys, offsets, rows;
+        offsets.push_back(0);
+        for (const auto& entry : *index) {
+            keys.push_back(entry.first);
+            rows.insert(rows.end(), entry.second.begin(), entry.second.end());
+            offsets.push_back(static_cast<int32_t>(rows.size()));
+        }
+        payload.putColumn(keys);
+        payload.putColumn(offsets);
+        payload.putColumn(rows);
+    }
+    payload.putColumn(data.indexes.weekendPartner);
+
+    vector<int32_t> raceOrder;
+    for (const Race* race : data.indexes.racesByDate) {
+        raceOrder.push_back(race->raceId);
+    }
+    payload.putColumn(raceOrder);
+
+    // Paradas en boxes, ya unidas con carreras y resultados
+    const PitStopTable& pitStops = data.pitStops;
+    for (const auto* column : { &pitStops.raceId, &pitStops.driverId, &pitStops.constructorId, &pitStops.circuitId,
+                                &pitStops.year, &pitStops.stop, &pitStops.lap, &pitStops.milliseconds }) {
+        payload.putColumn(*column);
+    }
+
+    const QualifyingTable& qualifying = data.qualifying;
+    for (const auto* column : { &qualifying.qualifyId, &qualifying.raceId, &qualifying.driverId, &qualifying.constructorId,
+                                &qualifying.circuitId, &qualifying.year, &qualifying.position,
+                                &qualifying.q1, &qualifying.q2, &qualifying.q3 }) {
+        payload.putColumn(*column);
+    }
+
+    // Cabecera
+    SnapshotWriter header;
+    header.bytes.insert(header.bytes.end(), SNAPSHOT_MAGIC, SNAPSHOT_MAGIC + sizeof(SNAPSHOT_MAGIC));
+    header.put<uint32_t>(SNAPSHOT_VERSION);
+    vector<string> sources = sourceFiles();
+    header.put<uint32_t>(static_cast<uint32_t>(sources.size()));
+    for (const auto& name : sources) {
+        SourceStamp stamp;
+        if (!stampSource(directory, name, stamp)) {
+            return false;
+        }
+        header.putString(stamp.name);
+        header.put<uint64_t>(stamp.size);
+        header.put<int64_t>(stamp.mtime);
+    }
+    header.put<uint64_t>(payload.bytes.size());
+    header.put<uint64_t>(fnv1a(payload.bytes.data(), payload.bytes.size()));
+
+    // Se escribe en un temporal y se renombra para no dejar nunca un fichero a medias
+    string temporary = snapshotPath + ".tmp";
+    {
+        ofstream file(temporary, ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(header.bytes.data(), static_cast<streamsize>(header.bytes.size()));
+        file.write(payload.bytes.data(), static_cast<streamsize>(payload.bytes.size()));
+        if (!file.good()) {
+            return false;
+        }
+    }
+    error_code error;
+    filesystem::rename(temporary, snapshotPath, error);
+    return !error;
+}
+
+bool DataSnapshot::read(const string& snapshotPath, const string& directory, Dataset& data) {
+    MappedFile file(snapshotPath);
+    if (!file.isOpen() || file.fileSize() < sizeof(SNAPSHOT_MAGIC)) {
+        return false;
+    }
+
+    SnapshotReader header(file.bytes(), file.fileSize());
+    if (memcmp(file.bytes(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(SNAPSHOT_MAGIC); ++i) {
+        header.get<char>();
+    }
+    if (header.get<uint32_t>() != SNAPSHOT_VERSION) {
+        return false;
+    }
+
+    // Algun CSV cambiado (o anadido/eliminado de la lista) invalida la instantanea
+    vector<string> sources = sourceFiles();
+    if (header.get<uint32_t>() != sources.size()) {
+        return false;
+    }
+    for (const auto& name : sources) {
+        string storedName = header.getString();
+        uint64_t storedSize = header.get<uint64_t>();
+        int64_t storedTime = header.get<int64_t>();
+        SourceStamp stamp;
+        if (!header.ok() || storedName != name || !stampSource(directory, name, stamp)
+            || stamp.size != storedSize || stamp.mtime != storedTime) {
+            return false;
+        }
+    }
+
+    uint64_t payloadSize = header.get<uint64_t>();
+    uint64_t checksum = header.get<uint64_t>();
+    if (!header.ok() || header.offset() + payloadSize != file.fileSize()) {
+        return false;
+    }
+    const char* payloadBytes = file.bytes() + header.offset();
+    if (fnv1a(payloadBytes, payloadSize) != checksum) {
+        return false;
+    }
+
+    SnapshotReader in(payloadBytes, payloadSize);
+    Dataset loaded;
+
+    // Las cadenas de la instantanea se internan una sola vez en StringPool
+    vector<InternedString> strings(in.get<uint32_t>());
+    for (auto& text : strings) {
+        text = InternedString(in.getString());
+    }
+    auto text = [&](int32_t id) {
+        return id >= 0 && static_cast<size_t>(id) < strings.size() ? strings[id] : InternedString();
+    };
+
+    vector<int32_t> circuitIds = in.getColumn(), circuitNames = in.getColumn(),
+        circuitLocations = in.getColumn(), circuitCountries = in.getColumn(), circuitRefs = in.getColumn();
+    vector<int32_t> raceIds = in.getColumn(), raceYears = in.getColumn(), raceCircuits = in.getColumn(),
+        raceNames = in.getColumn(), raceDates = in.getColumn();
+    vector<int32_t> driverIds = in.getColumn(), driverCodes = in.getColumn(), driverNames = in.getColumn(),
+        driverDobs = in.getColumn(), driverNationalities = in.getColumn(), driverRefs = in.getColumn();
+    vector<int32_t> teamIds = in.getColumn(), teamNames = in.getColumn(), teamNationalities = in.getColumn(),
+        teamRefs = in.getColumn();
+    vector<int32_t> statusIds = in.getColumn(), statusNames = in.getColumn();
+    if (!in.ok() || statusIds.size() != statusNames.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < circuitIds.size(); ++i) {
+        loaded.circuits[circuitIds[i]] = Circuit(circuitIds[i], text(circuitNames[i]), text(circuitLocations[i]), text(circuitCountries[i]),
+            text(circuitRefs[i]));
+    }
+    for (size_t i = 0; i < raceIds.size(); ++i) {
+        auto circuitIt = loaded.circuits.find(raceCircuits[i]);
+        const Circuit* circuit = circuitIt != loaded.circuits.end() ? &circuitIt->second : nullptr;
+        loaded.races[raceIds[i]] = Race(raceIds[i], raceYears[i], circuit, text(raceNames[i]), text(raceDates[i]));
+    }
+    for (size_t i = 0; i < driverIds.size(); ++i) {
+        loaded.drivers[driverIds[i]] = Driver(driverIds[i], text(driverCodes[i]), text(driverNames[i]), text(driverDobs[i]),
+            text(driverNationalities[i]), text(driverRefs[i]));
+    }
+    for (size_t i = 0; i < teamIds.size(); ++i) {
+        loaded.teams[teamIds[i]] = Team(teamIds[i], text(teamNames[i]), text(teamNationalities[i]), text(teamRefs[i]));
+    }
+    for (size_t i = 0; i < statusIds.size(); ++i) {
+        loaded.statuses.add(statusIds[i], text(statusNames[i]));
+    }
+
+    auto findRace = [&](int32_t id) -> const Race* {
+        auto it = loaded.races.find(id);
+        return it != loaded.races.end() ? &it->second : nullptr;
+    };
+
+    vector<int32_t> sIds = in.getColumn(), sRaces = in.getColumn(), sEntities = in.getColumn(),
+        sPoints = in.getColumn(), sPositions = in.getColumn(), sWins = in.getColumn();
+    for (size_t i = 0; i < sIds.size() && in.ok(); ++i) {
+        auto driverIt = loaded.drivers.find(sEntities[i]);
+        const Driver* driver = driverIt != loaded.drivers.end() ? &driverIt->second : nullptr;
+        loaded.driverStandings.emplace_hint(loaded.driverStandings.end(), sIds[i],
+            DriverStandings(sIds[i], findRace(sRaces[i]), driver, sPoints[i] / 100.0, sPositions[i], sWins[i]));
+    }
+
+    sIds = in.getColumn(); sRaces = in.getColumn(); sEntities = in.getColumn();
+    sPoints = in.getColumn(); sPositions = in.getColumn(); sWins = in.getColumn();
+    for (size_t i = 0; i < sIds.size() && in.ok(); ++i) {
+        auto teamIt = loaded.teams.find(sEntities[i]);
+        const Team* team = teamIt != loaded.teams.end() ? &teamIt->second : nullptr;
+        loaded.teamStandings.emplace_hint(loaded.teamStandings.end(), sIds[i],
+            TeamStandings(sIds[i], findRace(sRaces[i]), team, sPoints[i] / 100.0, sPositions[i], sWins[i]));
+    }
+
+    ResultsTable& results = loaded.results;
+    for (auto* column : { &results.resultId, &results.raceId, &results.driverId, &results.constructorId,
+                          &results.grid, &results.position, &results.points, &results.year,
+                          &results.laps, &results.milliseconds, &results.fastestLap, &results.fastestLapMs,
+                          &results.statusId }) {
+        *column = in.getColumn();
+    }
+    vector<int32_t> sessions = in.getColumn();
+    results.session.assign(sessions.begin(), sessions.end());
+
+    for (auto* index : { &loaded.indexes.resultsByDriver, &loaded.indexes.resultsByTeam }) {
+        vector<int32_t> keys = in.getColumn(), offsets = in.getColumn(), rows = in.getColumn();
+        if (!in.ok() || offsets.size() != keys.size() + 1) {
+            return false;
+        }
+        for (size_t k = 0; k < keys.size(); ++k) {
+            index->emplace_hint(index->end(), keys[k], vector<uint32_t>(rows.begin() + offsets[k], rows.begin() + offsets[k + 1]));
+        }
+    }
+    loaded.indexes.weekendPartner = in.getColumn();
+    if (results.session.size() != results.size() || loaded.indexes.weekendPartner.size() != results.size()) {
+        return false;
+    }
+
+    for (int32_t raceId : in.getColumn()) {
+        const Race* race = findRace(raceId);
+        if (race) {
+            loaded.indexes.racesByDate.push_back(race);
+        }
+    }
+
+    PitStopTable& pitStops = loaded.pitStops;
+    for (auto* column : { &pitStops.raceId, &pitStops.driverId, &pitStops.constructorId, &pitStops.circuitId,
+                          &pitStops.year, &pitStops.stop, &pitStops.lap, &pitStops.milliseconds }) {
+        *column = in.getColumn();
+    }
+    QualifyingTable& qualifying = loaded.qualifying;
+    for (auto* column : { &qualifying.qualifyId, &qualifying.raceId, &qualifying.driverId, &qualifying.constructorId,
+                          &qualifying.circuitId, &qualifying.year, &qualifying.position,
+                          &qualifying.q1, &qualifying.q2, &qualifying.q3 }) {
+        *column = in.getColumn();
+    }
+    if (!in.ok()) {
+        return false;
+    }
+
+    // Indices que guardan punteros: se rehacen sobre las tablas reconstruidas
+    loaded.indexes.indexRaceYears();
+    loaded.indexes.indexResultIds(loaded.results);
+    loaded.indexes.indexCircuits(loaded.races);
+    loaded.indexes.indexStandings(loaded.driverStandings, loaded.teamStandings);
+    loaded.indexes.indexNames(loaded.circuits, loaded.drivers, loaded.teams);
+    loaded.indexes.indexPitStops(loaded.pitStops);
+    loaded.indexes.indexQualifying(loaded.qualifying);
+    loaded.indexes.indexReliability(loaded.results, loaded.statuses, loaded.races);
+
+    data = move(loaded);
+    return true;
+}
@@ -0,0 +1,39 @@
+#ifndef DATA_SNAPSHOT_HPP
+#define DATA_SNAPSHOT_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Dataset.hpp"
+
+using namespace std;
+
+// Instantanea binaria del Dataset para arrancar sin analizar los CSV.
+//
+// Formato (little-endian, version SNAPSHOT_VERSION):
+//   cabecera  : "F1SNAP\0\0", version, lista de ficheros fuente (nombre, tamano, mtime),
+//               tamano y suma de comprobacion (FNV-1a) del contenido
+//   los puntos se guardan en centesimas (coma fija)
+//   contenido : tabla de cadenas internadas, entidades, diccionario de estados y tablas en columnas de
+//               ancho fijo (resultados de carreras y sprints, paradas en
+//               boxes y clasificaciones de sabado incluidos), y los
+//               indices de resultados ya calculados
+//
+// La instantanea solo es valida si todos los ficheros fuente conservan el
+// tamano y la fecha de modificacion con la que se escribio.
+class DataSnapshot {
+public:
+    static const uint32_t SNAPSHOT_VERSION = 8;
+
+    // Ficheros de Database/ que forman la instantanea
+    static vector<string> sourceFiles();
+
+    // Escribe la instantanea de 'data', cargada desde 'directory'
+    static bool write(const Dataset& data, const string& directory, const string& snapshotPath);
+
+    // Proyecta la instantanea y reconstruye 'data'. Devuelve false si no existe,
+    // esta corrupta, es de otra version o algun CSV de 'directory' ha cambiado.
+    static bool read(const string& snapshotPath, const string& directory, Dataset& data);
+};
+
+#endif // DATA_SNAPSHOT_HPP
@@ -0,0 +1,43 @@
+#ifndef DATASET_HPP
+#define DATASET_HPP
+
+#include <map>
+#include "Circuit.hpp"
+#include "Race.hpp"
+#include "Driver.hpp"
+#include "Team.hpp"
+#include "DriverStandings.hpp"
+#include "TeamStandings.hpp"
+#include "ResultsTable.hpp"
+#include "PitStopTable.hpp"
+#include "QualifyingTable.hpp"
+#include "StatusDictionary.hpp"
+#include "DataIndexes.hpp"
+
+using namespace std;
+
+// Conjunto completo de datos cargado por DataManager::loadAll.
+// Las entidades se enlazan con punteros a nodos de los map, que siguen siendo
+// validos al mover el Dataset, pero no al copiarlo.
+class Dataset {
+public:
+    map<int, Circuit> circuits;
+    map<int, Race> races;
+    map<int, Driver> drivers;
+    map<int, Team> teams;
+    map<int, DriverStandings> driverStandings;
+    map<int, TeamStandings> teamStandings;
+    ResultsTable results;  // results.csv y sprint_results.csv (columna session)
+    PitStopTable pitStops;
+    QualifyingTable qualifying;
+    StatusDictionary statuses;  // status.csv: texto y clase de cada statusId de results
+    DataIndexes indexes;
+
+    Dataset() = default;
+    Dataset(Dataset&&) = default;
+    Dataset& operator=(Dataset&&) = default;
+    Dataset(const Dataset&) = delete;
+    Dataset& operator=(const Dataset&) = delete;
+};
+
+#endif // DATASET_HPP
@@ -1,9 +1,10 @@
-#include "Driver.hpp"
-
-// Constructor predeterminado
-Driver::Driver()
-    : driverId(0), code(""), fullName(""), dob(""), nationality("") {}
-
-// Constructor con parámetros
-Driver::Driver(int driverId, string code, string fullName, string dob, string nationality)
-    : driverId(driverId), code(code), fullName(fullName), dob(dob), nationality(nationality) {}
\ No newline at end of file
+#include "Driver.hpp"
+
+// Constructor predeterminado
+Driver::Driver()
+    : driverId(0) {}
+
+// Constructor con parámetros
+Driver::Driver(int driverId, InternedString code, InternedString fullName, InternedString dob, InternedString nationality,
+    InternedString driverRef)
+    : driverId(driverId), code(code), fullName(fullName), dob(dob), nationality(nationality), driverRef(driverRef) {}
\ No newline at end of file
@@ -1,20 +1,22 @@
-#ifndef DRIVER_HPP
-#define DRIVER_HPP
-
-#include <string>
-
-using namespace std;
-
-class Driver {
-public:
-    int driverId;
-    string code;
-    string fullName;
-    string dob; // Date of birth as a string
-    string nationality;
-
-    Driver(); // Constructor predeterminado
-    Driver(int driverId, string code, string fullName, string dob, string nationality);
-};
-
+#ifndef DRIVER_HPP
+#define DRIVER_HPP
+
+#include "InternedString.hpp"
+
+using namespace std;
+
+class Driver {
+public:
+    int driverId;
+    InternedString code;
+    InternedString fullName;
+    InternedString dob; // Date of birth as a string
+    InternedString nationality;
+    InternedString driverRef; // Identificador textual de Ergast (p. ej. "hamilton")
+
+    Driver(); // Constructor predeterminado
+    Driver(int driverId, InternedString code, InternedString fullName, InternedString dob, InternedString nationality,
+        InternedString driverRef = InternedString());
+};
+
 #endif // DRIVER_HPP
\ No newline at end of file
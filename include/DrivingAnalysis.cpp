@@ -1,143 +1,161 @@
-#include "DrivingAnalysis.hpp"
-#include <iostream>
-#include <fstream>
-#include <algorithm>
-#include <numeric>
-#include <cmath>
-
-using namespace std;
-
-//Calcula los 5 mejores pilotos según sus puntos medios en un rango de años
-vector<pair<Driver, map<string, double>>> DrivingAnalysis::calculateTopDrivers(int startYear, int endYear,
-    const map<int, Driver>& drivers,
-    const map<int, ResultsInfo_driver>& results,
-    const map<int, Race>& races) {
-    vector<pair<Driver, map<string, double>>> driverStats;
-
-    for (const auto& driver : drivers) {
-        map<string, double> stats = calculateDriverStats(startYear, endYear, driver.second, results, races);
-        if (!stats.empty()) {
-            driverStats.push_back({ driver.second, stats });
-        }
-    }
-
-    sort(driverStats.begin(), driverStats.end(), [](const auto& a, const auto& b) {
-        return a.second.at("AveragePoints") > b.second.at("AveragePoints");
-        });
-
-    if (driverStats.size() > 5) {
-        driverStats.resize(5);
-    }
-
-    return driverStats;
-}
-
-// Calcula estadísticas básicas (max, min, promedio, desviación) de un piloto.
-map<string, double> DrivingAnalysis::calculateDriverStats(int startYear, int endYear, const Driver& driver,
-    const map<int, ResultsInfo_driver>& results,
-    const map<int, Race>& races) {
-    vector<double> points;
-
-    for (const auto& result : results) {
-        if (result.second.getDriver() && result.second.getDriver()->driverId == driver.driverId) {
-            auto raceIt = races.find(result.second.getRace()->raceId);
-            if (raceIt != races.end() && raceIt->second.year >= startYear && raceIt->second.year <= endYear) {
-                points.push_back(result.second.getPoints());
-            }
-        }
-    }
-
-    if (points.empty()) {
-        return {};
-    }
-
-    double maxPoints = *max_element(points.begin(), points.end());
-    double minPoints = *min_element(points.begin(), points.end());
-    double averagePoints = accumulate(points.begin(), points.end(), 0.0) / points.size();
-    double sum_sq = inner_product(points.begin(), points.end(), points.begin(), 0.0);
-    double stdDevPoints = sqrt(sum_sq / points.size() - averagePoints * averagePoints);
-
-    return { {"MaxPoints", maxPoints}, {"MinPoints", minPoints},
-            {"AveragePoints", averagePoints}, {"StdDevPoints", stdDevPoints} };
-}
-
-// Guarda las estadísticas de los pilotos en un fichero de texto.
-void DrivingAnalysis::saveDriverStatsToFile(const vector<pair<Driver, map<string, double>>>& driverStats, const string& filename) {
-    ofstream file(filename);
-    if (file.is_open()) {
-        for (const auto& item : driverStats) {
-            file << "Driver: " << item.first.fullName << "\n";
-            file << "DOB: " << item.first.dob << ", Nationality: " << item.first.nationality << "\n";
-            file << "Max Points: " << item.second.at("MaxPoints") << ", Min Points: " << item.second.at("MinPoints") << "\n";
-            file << "Average Points: " << item.second.at("AveragePoints") << ", Std. Deviation of Points: " << item.second.at("StdDevPoints") << "\n\n";
-        }
-        file.close();
-    }
-}
-
-// Muestra por consola las estadísticas de los pilotos.
-void DrivingAnalysis::printDriverStats(const vector<pair<Driver, map<string, double>>>& driverStats) {
-    for (const auto& item : driverStats) {
-        cout << "Driver: " << item.first.fullName << "\n";
-        cout << "DOB: " << item.first.dob << ", Nationality: " << item.first.nationality << "\n";
-        cout << "Max Points: " << item.second.at("MaxPoints") << ", Min Points: " << item.second.at("MinPoints") << "\n";
-        cout << "Average Points: " << item.second.at("AveragePoints") << ", Std. Deviation of Points: " << item.second.at("StdDevPoints") << "\n\n";
-    }
-}
-
-// Calcula los 5 mejores equipos según puntos medios en un rango de años.
-vector<pair<Team, map<string, double>>> DrivingAnalysis::calculateTopTeams(int startYear, int endYear, const map<int, Team>& teams, const map<int, TeamStandings>& teamStandings, const map<int, Race>& races) {
-    vector<pair<Team, map<string, double>>> teamStats;
-
-    for (const auto& team : teams) {
-        vector<double> points;
-        for (const auto& standing : teamStandings) {
-            if (standing.second.team->teamId == team.second.teamId && races.at(standing.second.race->raceId).year >= startYear && races.at(standing.second.race->raceId).year <= endYear) {
-                points.push_back(standing.second.points);
-            }
-        }
-
-        if (!points.empty()) {
-            double maxPoints = *max_element(points.begin(), points.end());
-            double minPoints = *min_element(points.begin(), points.end());
-            double averagePoints = accumulate(points.begin(), points.end(), 0.0) / points.size();
-            double stdDevPoints = sqrt(inner_product(points.begin(), points.end(), points.begin(), 0.0) / points.size() - averagePoints * averagePoints);
-            map<string, double> stats = {{"MaxPoints", maxPoints}, {"MinPoints", minPoints}, {"AveragePoints", averagePoints}, {"StdDevPoints", stdDevPoints}};
-            teamStats.push_back({team.second, stats});
-        }
-    }
-
-    sort(teamStats.begin(), teamStats.end(), [](const auto& a, const auto& b) {
-        return a.second.at("AveragePoints") > b.second.at("AveragePoints");
-    });
-
-    if (teamStats.size() > 5) {
-        teamStats.resize(5);
-    }
-
-    return teamStats;
-}
-
-// Muestra por consola las estadísticas de equipos.
-void DrivingAnalysis::printTeamStats(const vector<pair<Team, map<string, double>>>& teamStats) {
-    for (const auto& item : teamStats) {
-        cout << "Team: " << item.first.name << "\n";
-        cout << "Nationality: " << item.first.nationality << "\n";
-        cout << "Max Points: " << item.second.at("MaxPoints") << ", Min Points: " << item.second.at("MinPoints") << "\n";
-        cout << "Average Points: " << item.second.at("AveragePoints") << ", Std. Deviation of Points: " << item.second.at("StdDevPoints") << "\n\n";
-    }
-}
-
-// Guarda estadísticas de equipos en un fichero de texto
-void DrivingAnalysis::saveTeamStatsToFile(const vector<pair<Team, map<string, double>>>& teamStats, const string& filename) {
-    ofstream file(filename);
-    if (file.is_open()) {
-        for (const auto& item : teamStats) {
-            file << "Team: " << item.first.name << "\n";
-            file << "Nationality: " << item.first.nationality << "\n";
-            file << "Max Points: " << item.second.at("MaxPoints") << ", Min Points: " << item.second.at("MinPoints") << "\n";
-            file << "Average Points: " << item.second.at("AveragePoints") << ", Std. Deviation of Points: " << item.second.at("StdDevPoints") << "\n\n";
-        }
-        file.close();
-    }
+#include "DrivingAnalysis.hpp"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+// Deja en 'stats' los 'count' elementos con mayor media, ordenados de mayor a
+// menor. Ordena solo esos elementos (partial_sort) en lugar de toda la lista.
+// Los empates se resuelven por id para que el resultado sea estable.
+template <typename Entity, typename IdOf>
+void keepTop(vector<pair<Entity, PointStats>>& stats, size_t count, IdOf idOf) {
+    auto better = [&](const pair<Entity, PointStats>& a, const pair<Entity, PointStats>& b) {
+        if (a.second.averagePoints != b.second.averagePoints) {
+            return a.second.averagePoints > b.second.averagePoints;
+        }
+        return idOf(a.first) < idOf(b.first);
+    };
+    if (stats.size() > count) {
+        partial_sort(stats.begin(), stats.begin() + count, stats.end(), better);
+        stats.resize(count);
+    } else {
+        sort(stats.begin(), stats.end(), better);
+    }
+}
+
+}
+
+//Calcula los 5 mejores pilotos según sus puntos medios en un rango de años
+vector<pair<Driver, PointStats>> DrivingAnalysis::calculateTopDrivers(int startYear, int endYear,
+    const map<int, Driver>& drivers,
+    const ResultsTable& results, const StatusDictionary& statuses, const DataIndexes& indexes, SessionMask sessions) {
+    vector<pair<Driver, PointStats>> driverStats;
+
+    for (const auto& driver : drivers) {
+        auto rows = indexes.resultsByDriver.find(driver.first);
+        if (rows == indexes.resultsByDriver.end()) {
+            continue;
+        }
+        PointStats stats = calculateDriverStats(startYear, endYear, rows->second, results, statuses,
+            indexes.weekendPartner, sessions);
+        if (!stats.empty()) {
+            driverStats.push_back({ driver.second, stats });
+        }
+    }
+
+    keepTop(driverStats, TOP_COUNT, [](const Driver& driver) { return driver.driverId; });
+    return driverStats;
+}
+
+// Calcula estadísticas básicas (max, min, promedio, desviación) de un piloto.
+// Solo recorre las filas del piloto que indica el indice resultsByDriver.
+// El sprint se suma a la carrera del mismo fin de semana (weekendPartner);
+// un sprint sin carrera, o sin contar las carreras, es una muestra propia.
+// Los abandonos son muestras (como en RankingEngine); las no salidas, no.
+PointStats DrivingAnalysis::calculateDriverStats(int startYear, int endYear, const vector<uint32_t>& driverRows,
+    const ResultsTable& results, const StatusDictionary& statuses, const vector<int32_t>& weekendPartner,
+    SessionMask sessions) {
+    PointStats stats;
+
+    bool races = inSessions(sessions, static_cast<uint8_t>(Session::Race));
+    bool sprints = inSessions(sessions, static_cast<uint8_t>(Session::Sprint));
+    const int32_t* years = results.year.data();
+    const int32_t* resultPoints = results.points.data();
+    const uint8_t* rowSessions = results.session.data();
+    const int32_t* positions = results.position.data();
+    auto started = [&](int32_t row) {
+        return positions[row] >= 0 || statuses.outcome(results.statusId[row]) != Outcome::DidNotStart;
+    };
+    for (uint32_t row : driverRows) {
+        if (years[row] < startYear || years[row] > endYear || !started(row)) {
+            continue;
+        }
+        int32_t partner = weekendPartner[row];
+        if (rowSessions[row] == static_cast<uint8_t>(Session::Race)) {
+            if (races) {
+                stats.add((resultPoints[row] + (sprints && partner >= 0 ? resultPoints[partner] : 0)) / 100.0);
+            }
+        } else if (sprints && (!races || partner < 0 || !started(partner))) {
+            stats.add(resultPoints[row] / 100.0);
+        }
+    }
+
+    return stats;
+}
+
+// Guarda las estadísticas de los pilotos en un fichero de texto.
+void DrivingAnalysis::saveDriverStatsToFile(const vector<pair<Driver, PointStats>>& driverStats, const string& filename) {
+    ofstream file(filename);
+    if (file.is_open()) {
+        for (const auto& item : driverStats) {
+            file << "Driver: " << item.first.fullName << "\n";
+            file << "DOB: " << item.first.dob << ", Nationality: " << item.first.nationality << "\n";
+            file << "Max Points: " << item.second.maxPoints << ", Min Points: " << item.second.minPoints << "\n";
+            file << "Average Points: " << item.second.averagePoints << ", Std. Deviation of Points: " << item.second.stdDevPoints() << "\n\n";
+        }
+        file.close();
+    }
+}
+
+// Muestra por consola las estadísticas de los pilotos.
+void DrivingAnalysis::printDriverStats(const vector<pair<Driver, PointStats>>& driverStats) {
+    for (const auto& item : driverStats) {
+        cout << "Driver: " << item.first.fullName << "\n";
+        cout << "DOB: " << item.first.dob << ", Nationality: " << item.first.nationality << "\n";
+        cout << "Max Points: " << item.second.maxPoints << ", Min Points: " << item.second.minPoints << "\n";
+        cout << "Average Points: " << item.second.averagePoints << ", Std. Deviation of Points: " << item.second.stdDevPoints() << "\n\n";
+    }
+}
+
+// Calcula los 5 mejores equipos según puntos medios en un rango de años.
+vector<pair<Team, PointStats>> DrivingAnalysis::calculateTopTeams(int startYear, int endYear, const map<int, Team>& teams, const DataIndexes& indexes) {
+    vector<pair<Team, PointStats>> teamStats;
+
+    for (const auto& team : teams) {
+        auto teamRows = indexes.standingsByTeam.find(team.first);
+        if (teamRows == indexes.standingsByTeam.end()) {
+            continue;
+        }
+
+        PointStats stats;
+        for (const TeamStandings* standing : teamRows->second) {
+            if (standing->race->year >= startYear && standing->race->year <= endYear) {
+                stats.add(standing->points);
+            }
+        }
+
+        if (!stats.empty()) {
+            teamStats.push_back({team.second, stats});
+        }
+    }
+
+    keepTop(teamStats, TOP_COUNT, [](const Team& team) { return team.teamId; });
+    return teamStats;
+}
+
+// Muestra por consola las estadísticas de equipos.
+void DrivingAnalysis::printTeamStats(const vector<pair<Team, PointStats>>& teamStats) {
+    for (const auto& item : teamStats) {
+        cout << "Team: " << item.first.name << "\n";
+        cout << "Nationality: " << item.first.nationality << "\n";
+        cout << "Max Points: " << item.second.maxPoints << ", Min Points: " << item.second.minPoints << "\n";
+        cout << "Average Points: " << item.second.averagePoints << ", Std. Deviation of Points: " << item.second.stdDevPoints() << "\n\n";
+    }
+}
+
+// Guarda estadísticas de equipos en un fichero de texto
+void DrivingAnalysis::saveTeamStatsToFile(const vector<pair<Team, PointStats>>& teamStats, const string& filename) {
+    ofstream file(filename);
+    if (file.is_open()) {
+        for (const auto& item : teamStats) {
+            file << "Team: " << item.first.name << "\n";
+            file << "Nationality: " << item.first.nationality << "\n";
+            file << "Max Points: " << item.second.maxPoints << ", Min Points: " << item.second.minPoints << "\n";
+            file << "Average Points: " << item.second.averagePoints << ", Std. Deviation of Points: " << item.second.stdDevPoints() << "\n\n";
+        }
+        file.close();
+    }
 }
\ No newline at end of file
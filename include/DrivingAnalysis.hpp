@@ -1,34 +1,42 @@
-#ifndef DRIVING_ANALYSIS_HPP
-#define DRIVING_ANALYSIS_HPP
-
-#include <string>
-#include <vector>
-#include <map>
-#include "Driver.hpp"
-#include "ResultsInfo_driver.hpp"
-#include "Race.hpp"
-#include "Team.hpp"
-#include "TeamStandings.hpp"
-
-using namespace std;
-
-class DrivingAnalysis {
-public:
-    // En DrivingAnalysis.hpp
-    vector<pair<Driver, map<string, double>>> calculateTopDrivers(int startYear, int endYear, 
-        const map<int, Driver>& drivers, 
-        const map<int, ResultsInfo_driver>& results,  // Cambiado
-        const map<int, Race>& races);
-    void saveDriverStatsToFile(const vector<pair<Driver, map<string, double>>>& driverStats, const string& filename);
-    void printDriverStats(const vector<pair<Driver, map<string, double>>>& driverStats);
-    vector<pair<Team, map<string, double>>> calculateTopTeams(int startYear, int endYear, const map<int, Team>& teams,
-        const map<int, TeamStandings>& teamStandings, const map<int, Race>& races);
-    void printTeamStats(const vector<pair<Team, map<string, double>>>& teamStats);
-    void saveTeamStatsToFile(const vector<pair<Team, map<string, double>>>& teamStats, const string& filename);
-
-private:
-    map<string, double> calculateDriverStats(int startYear, int endYear, const Driver& driver,
-        const map<int, ResultsInfo_driver>& results, const map<int, Race>& races);
-};
-
+#ifndef DRIVING_ANALYSIS_HPP
+#define DRIVING_ANALYSIS_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include "Driver.hpp"
+#include "ResultsTable.hpp"
+#include "StatusDictionary.hpp"
+#include "Race.hpp"
+#include "Team.hpp"
+#include "TeamStandings.hpp"
+#include "DataIndexes.hpp"
+#include "PointStats.hpp"
+
+using namespace std;
+
+class DrivingAnalysis {
+public:
+    // En DrivingAnalysis.hpp
+    // Cada muestra son los puntos de un fin de semana en las sesiones de 'sessions'
+    vector<pair<Driver, PointStats>> calculateTopDrivers(int startYear, int endYear, 
+        const map<int, Driver>& drivers, 
+        const ResultsTable& results, const StatusDictionary& statuses, const DataIndexes& indexes,
+        SessionMask sessions = ALL_SESSIONS);
+    void saveDriverStatsToFile(const vector<pair<Driver, PointStats>>& driverStats, const string& filename);
+    void printDriverStats(const vector<pair<Driver, PointStats>>& driverStats);
+    vector<pair<Team, PointStats>> calculateTopTeams(int startYear, int endYear, const map<int, Team>& teams,
+        const DataIndexes& indexes);
+    void printTeamStats(const vector<pair<Team, PointStats>>& teamStats);
+    void saveTeamStatsToFile(const vector<pair<Team, PointStats>>& teamStats, const string& filename);
+
+private:
+    // Numero de pilotos o equipos que se devuelven en cada ranking
+    static const size_t TOP_COUNT = 5;
+
+    PointStats calculateDriverStats(int startYear, int endYear, const vector<uint32_t>& driverRows,
+        const ResultsTable& results, const StatusDictionary& statuses, const vector<int32_t>& weekendPartner,
+        SessionMask sessions);
+};
+
 #endif // DRIVING_ANALYSIS_HPP
\ No newline at end of file
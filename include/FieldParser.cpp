@@ -0,0 +1,154 @@
+#include "FieldParser.hpp"
+#include <charconv>
+
+bool FieldParser::parseInt(string_view field, int& value) {
+    if (field.empty() || isNull(field)) {
+        return false;
+    }
+    const char* first = field.data();
+    const char* last = field.data() + field.size();
+    if (*first == '+') {
+        ++first;
+    }
+    auto result = from_chars(first, last, value);
+    return result.ec == errc() && result.ptr == last;
+}
+
+optional<int> FieldParser::parseNullableInt(string_view field) {
+    int value;
+    if (parseInt(field, value)) {
+        return value;
+    }
+    return nullopt;
+}
+
+int FieldParser::parseIntOr(string_view field, int fallback) {
+    int value;
+    return parseInt(field, value) ? value : fallback;
+}
+
+bool FieldParser::parseDouble(string_view field, double& value) {
+    if (field.empty() || isNull(field)) {
+        return false;
+    }
+    const char* last = field.data() + field.size();
+    auto result = from_chars(field.data(), last, value);
+    return result.ec == errc() && result.ptr == last;
+}
+
+// Analiza "[-]entero[.decimales]" sin pasar por double para no perder precision
+bool FieldParser::parsePoints(string_view field, int32_t& hundredths) {
+    if (field.empty() || isNull(field)) {
+        return false;
+    }
+
+    size_t i = 0;
+    bool negative = false;
+    if (field[i] == '-' || field[i] == '+') {
+        negative = field[i] == '-';
+        ++i;
+    }
+
+    int64_t whole = 0;
+    size_t digits = 0;
+    while (i < field.size() && field[i] >= '0' && field[i] <= '9') {
+        whole = whole * 10 + (field[i] - '0');
+        if (whole > INT32_MAX / 100) {
+            return false;
+        }
+        ++i;
+        ++digits;
+    }
+
+    int64_t fraction = 0;
+    if (i < field.size() && field[i] == '.') {
+        ++i;
+        int scale = 10;
+        bool roundUp = false;
+        size_t fractionDigits = 0;
+        while (i < field.size() && field[i] >= '0' && field[i] <= '9') {
+            if (fractionDigits < 2) {
+                fraction += (field[i] - '0') * scale;
+                scale /= 10;
+            } else if (fractionDigits == 2) {
+                roundUp = field[i] >= '5';
+            }
+            ++i;
+            ++fractionDigits;
+        }
+        digits += fractionDigits;
+        if (roundUp) {
+            ++fraction;
+        }
+    }
+
+    if (digits == 0 || i != field.size()) {
+        return false;
+    }
+
+    int64_t value = whole * 100 + fraction;
+    hundredths = static_cast<int32_t>(negative ? -value : value);
+    return true;
+}
+
+// Recorre el campo una sola vez: grupos de cifras separados por ':' y una parte decimal opcional
+bool FieldParser::parseLapTime(string_view field, int32_t& milliseconds) {
+    if (field.empty() || isNull(field)) {
+        return false;
+    }
+
+    int64_t total = 0;      // Segundos de los grupos anteriores al actual
+    int64_t group = 0;
+    size_t groupDigits = 0;
+    size_t groups = 1;
+    size_t i = 0;
+    for (; i < field.size() && field[i] != '.'; ++i) {
+        char c = field[i];
+        if (c == ':') {
+            // Los grupos posteriores a ':' son minutos o segundos: dos cifras y menos de 60
+            if (groupDigits == 0 || groups == 3 || (groups > 1 && (groupDigits != 2 || group >= 60))) {
+                return false;
+            }
+            total = (total + group) * 60;
+            group = 0;
+            groupDigits = 0;
+            ++groups;
+        } else if (c >= '0' && c <= '9') {
+            group = group * 10 + (c - '0');
+            if (++groupDigits > 6) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    if (groupDigits == 0 || (groups > 1 && (groupDigits != 2 || group >= 60))) {
+        return false;
+    }
+    total += group;
+
+    int64_t fraction = 0;
+    if (i < field.size()) {
+        ++i;  // '.'
+        size_t fractionDigits = field.size() - i;
+        if (fractionDigits == 0 || fractionDigits > 3) {
+            return false;
+        }
+        for (; i < field.size(); ++i) {
+            if (field[i] < '0' || field[i] > '9') {
+                return false;
+            }
+            fraction = fraction * 10 + (field[i] - '0');
+        }
+        for (; fractionDigits < 3; ++fractionDigits) {
+            fraction *= 10;
+        }
+    }
+
+    int64_t value = total * 1000 + fraction;
+    if (value > INT32_MAX) {
+        return false;
+    }
+    milliseconds = static_cast<int32_t>(value);
+    return true;
+}
@@ -0,0 +1,35 @@
+#ifndef FIELD_PARSER_HPP
+#define FIELD_PARSER_HPP
+
+#include <string_view>
+#include <optional>
+#include <cstdint>
+
+using namespace std;
+
+// Conversion de campos CSV (string_view) a numeros sin excepciones ni locale,
+// basada en from_chars. Todas las funciones devuelven false (o nullopt) si el
+// campo esta vacio, es \N o no es un numero completo.
+class FieldParser {
+public:
+    // Valor nulo de los CSV de Ergast
+    static bool isNull(string_view field) { return field == "\\N"; }
+
+    static bool parseInt(string_view field, int& value);
+    static optional<int> parseNullableInt(string_view field);
+    // Devuelve 'fallback' si el campo es nulo o no es valido
+    static int parseIntOr(string_view field, int fallback);
+
+    static bool parseDouble(string_view field, double& value);
+
+    // Puntos en coma fija con dos decimales: "4.5" -> 450, "1.33" -> 133.
+    // Los decimales a partir del tercero se redondean.
+    static bool parsePoints(string_view field, int32_t& hundredths);
+
+    // Tiempos de vuelta "[[h:]m:]ss[.mmm]" en milisegundos: "1:26.572" -> 86572.
+    // Admite de 0 a 3 decimales ("1:26.5" -> 86500); minutos y segundos
+    // intermedios deben tener dos cifras y ser menores que 60.
+    static bool parseLapTime(string_view field, int32_t& milliseconds);
+};
+
+#endif // FIELD_PARSER_HPP
@@ -0,0 +1,189 @@
+#include "HeadToHeadEngine.hpp"
+#include <algorithm>
+#include <climits>
+#include <tuple>
+
+HeadToHead HeadToHead::flipped() const {
+    HeadToHead other = *this;
+    swap(other.driverId, other.teammateId);
+    swap(other.raceAhead, other.raceBehind);
+    swap(other.qualifyingAhead, other.qualifyingBehind);
+    swap(other.points, other.teammatePoints);
+    return other;
+}
+
+void HeadToHead::merge(const HeadToHead& other) {
+    races += other.races;
+    raceAhead += other.raceAhead;
+    raceBehind += other.raceBehind;
+    qualifyingAhead += other.qualifyingAhead;
+    qualifyingBehind += other.qualifyingBehind;
+    points += other.points;
+    teammatePoints += other.teammatePoints;
+}
+
+HeadToHeadEngine::HeadToHeadEngine(const Dataset& data) : data(data), seasons(buildSeasons(nullptr)) {}
+
+map<int, vector<HeadToHead>> HeadToHeadEngine::buildSeasons(const vector<bool>* years) const {
+    const ResultsTable& results = data.results;
+    const vector<int32_t>& partner = data.indexes.weekendPartner;
+
+    vector<uint32_t> rows;
+    for (size_t row = 0; row < results.size(); ++row) {
+        int year = results.year[row];
+        if (results.session[row] == static_cast<uint8_t>(Session::Race) && results.driverId[row] >= 0
+            && results.constructorId[row] >= 0
+            && (!years || (year >= 0 && static_cast<size_t>(year) < years->size() && (*years)[year]))) {
+            rows.push_back(static_cast<uint32_t>(row));
+        }
+    }
+    // Grupos (carrera, equipo); dentro, por piloto y con su mejor llegada primero (coches compartidos)
+    auto finish = [&](uint32_t row) { return results.position[row] > 0 ? results.position[row] : INT_MAX; };
+    sort(rows.begin(), rows.end(), [&](uint32_t a, uint32_t b) {
+        return make_tuple(results.raceId[a], results.constructorId[a], results.driverId[a], finish(a), a)
+            < make_tuple(results.raceId[b], results.constructorId[b], results.driverId[b], finish(b), b);
+    });
+
+    map<int, map<pair<int, int>, HeadToHead>> pairs;
+    vector<uint32_t> group;
+    vector<int> qualifyingPosition;
+    for (size_t begin = 0; begin < rows.size();) {
+        int raceId = results.raceId[rows[begin]];
+        int teamId = results.constructorId[rows[begin]];
+        group.clear();
+        size_t end = begin;
+        for (; end < rows.size() && results.raceId[rows[end]] == raceId && results.constructorId[rows[end]] == teamId; ++end) {
+            if (group.empty() || results.driverId[group.back()] != results.driverId[rows[end]]) {
+                group.push_back(rows[end]);
+            }
+        }
+        begin = end;
+        if (group.size() < 2) {
+            continue;
+        }
+
+        // Posicion en qualifying.csv de cada piloto del grupo; -1 si no hay
+        qualifyingPosition.assign(group.size(), -1);
+        auto qualifyingRows = data.indexes.qualifyingByRace.find(raceId);
+        if (qualifyingRows != data.indexes.qualifyingByRace.end()) {
+            for (uint32_t qualifyingRow : qualifyingRows->second) {
+                for (size_t i = 0; i < group.size(); ++i) {
+                    if (data.qualifying.driverId[qualifyingRow] == results.driverId[group[i]] && data.qualifying.position[qualifyingRow] > 0) {
+                        qualifyingPosition[i] = data.qualifying.position[qualifyingRow];
+                    }
+                }
+            }
+        }
+
+        map<pair<int, int>, HeadToHead>& season = pairs[results.year[group.front()]];
+        for (size_t i = 0; i < group.size(); ++i) {
+            for (size_t j = i + 1; j < group.size(); ++j) {
+                uint32_t a = group[i];
+                uint32_t b = group[j];
+                HeadToHead& duel = season[{ results.driverId[a], results.driverId[b] }];
+                duel.driverId = results.driverId[a];
+                duel.teammateId = results.driverId[b];
+                ++duel.races;
+
+                int positionA = results.position[a];
+                int positionB = results.position[b];
+                if (positionA > 0 && (positionB <= 0 || positionA < positionB)) {
+                    ++duel.raceAhead;
+                } else if (positionB > 0 && (positionA <= 0 || positionB < positionA)) {
+                    ++duel.raceBehind;
+                }
+
+                // Antes de qualifying.csv (1994) se compara la parrilla
+                int startA = qualifyingPosition[i];
+                int startB = qualifyingPosition[j];
+                if (startA < 0 || startB < 0) {
+                    startA = results.grid[a];
+                    startB = results.grid[b];
+                }
+                if (startA > 0 && startB > 0 && startA != startB) {
+                    ++(startA < startB ? duel.qualifyingAhead : duel.qualifyingBehind);
+                }
+
+                duel.points += results.points[a] + (partner[a] >= 0 ? results.points[partner[a]] : 0);
+                duel.teammatePoints += results.points[b] + (partner[b] >= 0 ? results.points[partner[b]] : 0);
+            }
+        }
+    }
+
+    map<int, vector<HeadToHead>> built;
+    for (auto& season : pairs) {
+        vector<HeadToHead>& duels = built[season.first];
+        duels.reserve(season.second.size());
+        for (auto& entry : season.second) {
+            duels.push_back(entry.second);
+        }
+    }
+    return built;
+}
+
+void HeadToHeadEngine::appendResults(size_t firstResult, size_t firstQualifying) {
+    vector<bool> years;
+    auto mark = [&](int year) {
+        if (year >= 0) {
+            if (static_cast<size_t>(year) >= years.size()) {
+                years.resize(static_cast<size_t>(year) + 1, false);
+            }
+            years[year] = true;
+        }
+    };
+    for (size_t row = firstResult; row < data.results.size(); ++row) {
+        mark(data.results.year[row]);
+    }
+    for (size_t row = firstQualifying; row < data.qualifying.size(); ++row) {
+        mark(data.qualifying.year[row]);
+    }
+    if (years.empty()) {
+        return;
+    }
+
+    map<int, vector<HeadToHead>> rebuilt = buildSeasons(&years);
+    for (size_t year = 0; year < years.size(); ++year) {
+        if (years[year]) {
+            seasons.erase(static_cast<int>(year));
+        }
+    }
+    for (auto& season : rebuilt) {
+        seasons[season.first] = move(season.second);
+    }
+}
+
+vector<HeadToHead> HeadToHeadEngine::window(int startYear, int endYear) const {
+    vector<HeadToHead> duels;
+    for (auto season = seasons.lower_bound(startYear); season != seasons.end() && season->first <= endYear; ++season) {
+        duels.insert(duels.end(), season->second.begin(), season->second.end());
+    }
+    // Cada temporada ya esta ordenada; se juntan los pares repetidos entre temporadas
+    sort(duels.begin(), duels.end(), [](const HeadToHead& a, const HeadToHead& b) {
+        return tie(a.driverId, a.teammateId) < tie(b.driverId, b.teammateId);
+    });
+    size_t kept = 0;
+    for (size_t i = 0; i < duels.size(); ++i) {
+        if (kept > 0 && duels[kept - 1].driverId == duels[i].driverId && duels[kept - 1].teammateId == duels[i].teammateId) {
+            duels[kept - 1].merge(duels[i]);
+        } else {
+            duels[kept++] = duels[i];
+        }
+    }
+    duels.resize(kept);
+    return duels;
+}
+
+vector<HeadToHead> HeadToHeadEngine::forDriver(int driverId, int startYear, int endYear) const {
+    vector<HeadToHead> duels;
+    for (const HeadToHead& duel : window(startYear, endYear)) {
+        if (duel.driverId == driverId) {
+            duels.push_back(duel);
+        } else if (duel.teammateId == driverId) {
+            duels.push_back(duel.flipped());
+        }
+    }
+    sort(duels.begin(), duels.end(), [](const HeadToHead& a, const HeadToHead& b) {
+        return a.races != b.races ? a.races > b.races : a.teammateId < b.teammateId;
+    });
+    return duels;
+}
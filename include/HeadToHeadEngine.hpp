@@ -0,0 +1,63 @@
+#ifndef HEAD_TO_HEAD_ENGINE_HPP
+#define HEAD_TO_HEAD_ENGINE_HPP
+
+#include <map>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Dataset.hpp"
+
+using namespace std;
+
+// Duelo entre dos pilotos del mismo equipo, desde el punto de vista de driverId
+struct HeadToHead {
+    int driverId;
+    int teammateId;
+    uint32_t races = 0;             // Carreras con el mismo equipo
+    uint32_t raceAhead = 0;         // Acabo delante (o clasificado y el companero no)
+    uint32_t raceBehind = 0;
+    uint32_t qualifyingAhead = 0;   // Salio mejor clasificado (qualifying.csv, o la parrilla si no hay)
+    uint32_t qualifyingBehind = 0;
+    int64_t points = 0;             // Centesimas de driverId en esas carreras, sprint incluido
+    int64_t teammatePoints = 0;
+
+    // Parte de los puntos de los dos que hizo driverId; 0.5 si ninguno puntuo
+    double pointsShare() const {
+        return points + teammatePoints > 0 ? static_cast<double>(points) / (points + teammatePoints) : 0.5;
+    }
+    HeadToHead flipped() const;
+    void merge(const HeadToHead& other);
+};
+
+// Tabla dispersa piloto x piloto de duelos entre companeros. Una sola pasada:
+// las filas de carrera se ordenan por (raceId, constructorId) y cada grupo
+// aporta sus parejas a la tabla de su temporada. Las temporadas se guardan
+// ya calculadas (pares con driverId < teammateId, ordenados), asi que una
+// ventana de anos solo mezcla las temporadas que abarca.
+class HeadToHeadEngine {
+public:
+    // 'data' debe seguir vivo mientras se use el motor
+    explicit HeadToHeadEngine(const Dataset& data);
+
+    HeadToHeadEngine(const HeadToHeadEngine&) = delete;
+    HeadToHeadEngine& operator=(const HeadToHeadEngine&) = delete;
+
+    // Recalcula las temporadas de las filas nuevas de data.results y
+    // data.qualifying (DataManager::appendDelta). No debe coincidir con consultas en curso.
+    void appendResults(size_t firstResult, size_t firstQualifying);
+
+    // Todos los pares de [startYear, endYear], con driverId < teammateId
+    vector<HeadToHead> window(int startYear, int endYear) const;
+
+    // Duelos de un piloto con cada companero en [startYear, endYear], desde su punto de vista
+    vector<HeadToHead> forDriver(int driverId, int startYear, int endYear) const;
+
+private:
+    const Dataset& data;
+    map<int, vector<HeadToHead>> seasons;
+
+    // Calcula las temporadas marcadas en 'years' (indexado por ano); todas si es nullptr
+    map<int, vector<HeadToHead>> buildSeasons(const vector<bool>* years) const;
+};
+
+#endif // HEAD_TO_HEAD_ENGINE_HPP
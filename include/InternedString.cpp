@@ -0,0 +1,56 @@
+#include "InternedString.hpp"
+#include <stdexcept>
+
+StringPool& StringPool::instance() {
+    static StringPool pool;
+    return pool;
+}
+
+// El id 0 es siempre la cadena vacia
+StringPool::StringPool() : count(0) {
+    intern("");
+}
+
+uint32_t StringPool::intern(string_view text) {
+    lock_guard<mutex> lock(poolMutex);
+    auto it = ids.find(text);
+    if (it != ids.end()) {
+        return it->second;
+    }
+
+    size_t block = count / BLOCK_SIZE;
+    if (block >= MAX_BLOCKS) {
+        throw length_error("StringPool: demasiadas cadenas distintas");
+    }
+    if (!blocks[block]) {
+        blocks[block] = make_unique<string[]>(BLOCK_SIZE);
+    }
+
+    string& stored = blocks[block][count % BLOCK_SIZE];
+    stored.assign(text.data(), text.size());
+    uint32_t id = count++;
+    ids.emplace(string_view(stored), id);
+    return id;
+}
+
+optional<uint32_t> StringPool::find(string_view text) const {
+    lock_guard<mutex> lock(poolMutex);
+    auto it = ids.find(text);
+    if (it == ids.end()) {
+        return nullopt;
+    }
+    return it->second;
+}
+
+size_t StringPool::size() const {
+    lock_guard<mutex> lock(poolMutex);
+    return count;
+}
+
+optional<InternedString> InternedString::find(string_view text) {
+    optional<uint32_t> id = StringPool::instance().find(text);
+    if (!id) {
+        return nullopt;
+    }
+    return InternedString(*id);
+}
@@ -0,0 +1,79 @@
+#ifndef INTERNED_STRING_HPP
+#define INTERNED_STRING_HPP
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <ostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// Tabla global de cadenas internadas. Cada texto distinto se guarda una sola
+// vez y se identifica con un entero; los identificadores no cambian durante
+// la ejecucion. Solo se anaden cadenas, nunca se borran.
+class StringPool {
+public:
+    static StringPool& instance();
+
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    // Devuelve el id de 'text', anadiendolo si es nuevo (seguro entre hilos)
+    uint32_t intern(string_view text);
+
+    // Busca 'text' sin anadirlo
+    optional<uint32_t> find(string_view text) const;
+
+    // Texto de un id devuelto por intern(). No bloquea: los bloques ya
+    // reservados no se mueven al crecer la tabla.
+    const string& get(uint32_t id) const { return blocks[id / BLOCK_SIZE][id % BLOCK_SIZE]; }
+
+    size_t size() const;
+
+private:
+    StringPool();
+
+    static const size_t BLOCK_SIZE = 4096;
+    static const size_t MAX_BLOCKS = 4096;
+
+    unique_ptr<string[]> blocks[MAX_BLOCKS];
+    uint32_t count;
+    unordered_map<string_view, uint32_t> ids; // Vistas sobre las cadenas de 'blocks'
+    mutable mutex poolMutex;
+};
+
+// Referencia de 4 bytes a una cadena de StringPool. Se copia como un entero y
+// dos cadenas internadas son iguales si y solo si sus ids lo son.
+class InternedString {
+public:
+    InternedString() : id(0) {} // Cadena vacia
+    explicit InternedString(string_view text) : id(StringPool::instance().intern(text)) {}
+
+    // Handle de 'text' si ya esta en la tabla; nullopt si no (ninguna entidad lo usa)
+    static optional<InternedString> find(string_view text);
+
+    const string& str() const { return StringPool::instance().get(id); }
+    bool empty() const { return id == 0; }
+    uint32_t index() const { return id; }
+
+    bool operator==(InternedString other) const { return id == other.id; }
+    bool operator!=(InternedString other) const { return id != other.id; }
+    // Orden por id (para usar como clave); para orden alfabetico usar str()
+    bool operator<(InternedString other) const { return id < other.id; }
+
+private:
+    explicit InternedString(uint32_t id) : id(id) {}
+
+    uint32_t id;
+};
+
+inline ostream& operator<<(ostream& out, InternedString text) {
+    return out << text.str();
+}
+
+#endif // INTERNED_STRING_HPP
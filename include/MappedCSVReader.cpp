@@ -0,0 +1,104 @@
+#include "MappedCSVReader.hpp"
+
+MappedCSVReader::MappedCSVReader(const string& filename)
+    : file(filename), data(file.bytes()), size(file.fileSize()), pos(0) {}
+
+bool MappedCSVReader::nextRow(vector<string_view>& fields) {
+    return nextRowInRange(pos, size, fields);
+}
+
+// Separa la siguiente fila en campos respetando las comillas
+bool MappedCSVReader::nextRowInRange(size_t& cursor, size_t limit, vector<string_view>& fields) const {
+    fields.clear();
+    if (cursor >= limit) {
+        return false;
+    }
+
+    const char* p = data + cursor;
+    const char* end = data + limit;
+
+    while (true) {
+        if (p < end && *p == '"') {
+            // Campo entre comillas: puede contener comas y saltos de linea
+            const char* start = ++p;
+            while (p < end) {
+                if (*p == '"') {
+                    if (p + 1 < end && p[1] == '"') {
+                        p += 2;
+                        continue;
+                    }
+                    break;
+                }
+                ++p;
+            }
+            fields.emplace_back(start, static_cast<size_t>(p - start));
+            if (p < end) {
+                ++p; // Comilla de cierre
+            }
+            // Ignora cualquier texto suelto entre la comilla y el separador
+            while (p < end && *p != ',' && *p != '\n' && *p != '\r') {
+                ++p;
+            }
+        } else {
+            const char* start = p;
+            while (p < end && *p != ',' && *p != '\n' && *p != '\r') {
+                ++p;
+            }
+            fields.emplace_back(start, static_cast<size_t>(p - start));
+        }
+
+        if (p < end && *p == ',') {
+            ++p;
+            continue;
+        }
+
+        // Fin de linea (acepta \n y \r\n)
+        if (p < end && *p == '\r') ++p;
+        if (p < end && *p == '\n') ++p;
+        break;
+    }
+
+    cursor = static_cast<size_t>(p - data);
+    return true;
+}
+
+vector<pair<size_t, size_t>> MappedCSVReader::splitRanges(size_t count) const {
+    vector<pair<size_t, size_t>> ranges;
+    if (pos >= size || count == 0) {
+        return ranges;
+    }
+
+    size_t chunk = (size - pos) / count + 1;
+    size_t start = pos;
+    while (start < size) {
+        size_t cut = start + chunk;
+        if (cut >= size) {
+            cut = size;
+        } else {
+            // Avanza hasta el siguiente salto de linea
+            while (cut < size && data[cut - 1] != '\n') {
+                ++cut;
+            }
+        }
+        ranges.emplace_back(start, cut);
+        start = cut;
+    }
+    return ranges;
+}
+
+bool MappedCSVReader::skipRow() {
+    vector<string_view> ignored;
+    return nextRow(ignored);
+}
+
+string MappedCSVReader::unescape(string_view field) {
+    string result;
+    result.reserve(field.size());
+    for (size_t i = 0; i < field.size(); ++i) {
+        result.push_back(field[i]);
+        if (field[i] == '"' && i + 1 < field.size() && field[i + 1] == '"') {
+            ++i;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,56 @@
+#ifndef MAPPED_CSV_READER_HPP
+#define MAPPED_CSV_READER_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include "MappedFile.hpp"
+
+using namespace std;
+
+// Lector CSV sobre el fichero proyectado en memoria (ver MappedFile).
+// Cada campo se devuelve como string_view sobre los bytes del fichero, sin
+// copias ni reservas de memoria por celda. Soporta campos entre comillas con
+// comas en su interior; las comillas dobles escapadas ("") se dejan tal cual
+// en la vista y se resuelven con unescape() al copiar los campos de texto.
+class MappedCSVReader {
+public:
+    explicit MappedCSVReader(const string& filename);
+
+    MappedCSVReader(const MappedCSVReader&) = delete;
+    MappedCSVReader& operator=(const MappedCSVReader&) = delete;
+
+    bool isOpen() const { return file.isOpen(); }
+    size_t fileSize() const { return size; }
+    size_t offset() const { return pos; }
+
+    // Lee la siguiente fila en 'fields' (se reutiliza el vector entre filas).
+    // Las vistas son validas mientras el lector siga vivo.
+    // Devuelve false al llegar al final del fichero.
+    bool nextRow(vector<string_view>& fields);
+
+    // Salta una fila completa (normalmente la cabecera).
+    bool skipRow();
+
+    // Divide el resto del fichero (desde la fila actual) en hasta 'count' tramos
+    // [inicio, fin) que empiezan en principio de linea, para leerlos en paralelo.
+    // Supone que ningun campo entre comillas contiene saltos de linea.
+    vector<pair<size_t, size_t>> splitRanges(size_t count) const;
+
+    // Lee la siguiente fila del tramo [cursor, end). No modifica el lector, por lo
+    // que varios hilos pueden recorrer tramos distintos a la vez.
+    bool nextRowInRange(size_t& cursor, size_t end, vector<string_view>& fields) const;
+
+    // Convierte un campo con comillas escapadas ("") en un string normal.
+    static string unescape(string_view field);
+
+private:
+    MappedFile file;
+    const char* data;
+    size_t size;
+    size_t pos;
+};
+
+#endif // MAPPED_CSV_READER_HPP
@@ -0,0 +1,36 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+// Fichero proyectado en memoria de solo lectura (mmap / MapViewOfFile).
+// La proyeccion se libera al destruir el objeto.
+class MappedFile {
+public:
+    explicit MappedFile(const string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return opened; }
+    const char* bytes() const { return data; }
+    size_t fileSize() const { return size; }
+
+private:
+    const char* data;
+    size_t size;
+    bool opened;
+
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+    void close();
+};
+
+#endif // MAPPED_FILE_HPP
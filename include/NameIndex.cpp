@@ -0,0 +1,121 @@
+#include "NameIndex.hpp"
+#include <algorithm>
+
+namespace {
+
+// Letra base de U+00C0..U+00FF (el bloque en minusculas es igual salvo x/÷ y ÿ)
+const char LATIN1_BASE[] = "aaaaaa\0ceeeeiiiidnooooo\0ouuuuy\0\0";
+// Letra base de U+0100..U+017F (Latin Extended-A)
+const char LATIN_EXTENDED_A_BASE[] =
+    "aaaaaaccccccccdd" "ddeeeeeeeeeegggg" "gggghhhhiiiiiiii" "iiiijjkkklllllll"
+    "lllnnnnnnnnnoooo" "oooorrrrrrssssss" "ssttttttuuuuuuuu" "uuuuwwyyyzzzzzzs";
+static_assert(sizeof(LATIN1_BASE) == 33 && sizeof(LATIN_EXTENDED_A_BASE) == 129, "tablas de transliteracion incompletas");
+
+// Anade a 'out' la transliteracion de un caracter latino; false si no se conoce
+bool appendBaseLetter(unsigned codePoint, string& out) {
+    if (codePoint >= 0xC0 && codePoint <= 0xFF) {
+        switch (codePoint) {
+        case 0xC6: case 0xE6: out += "ae"; return true;
+        case 0xDE: case 0xFE: out += "th"; return true;
+        case 0xDF: out += "ss"; return true;
+        case 0xFF: out += 'y'; return true;
+        case 0xD7: case 0xF7: return false;
+        }
+        char base = LATIN1_BASE[(codePoint & ~0x20u) - 0xC0];
+        if (base != '\0') {
+            out += base;
+            return true;
+        }
+        return false;
+    }
+    if (codePoint >= 0x100 && codePoint <= 0x17F) {
+        if (codePoint == 0x152 || codePoint == 0x153) {
+            out += "oe";
+            return true;
+        }
+        out += LATIN_EXTENDED_A_BASE[codePoint - 0x100];
+        return true;
+    }
+    return false;
+}
+
+}
+
+string NameIndex::normalize(string_view text) {
+    string result;
+    result.reserve(text.size());
+    bool pendingSpace = false;
+
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c == ' ' || c == '\t' || c == '_' || c == '-') {
+            pendingSpace = !result.empty();
+            continue;
+        }
+        if (pendingSpace) {
+            result += ' ';
+            pendingSpace = false;
+        }
+
+        // Secuencias UTF-8 de dos bytes de los bloques latinos (lead 0xC3..0xC5)
+        if (c >= 0xC3 && c <= 0xC5 && i + 1 < text.size()) {
+            unsigned char next = static_cast<unsigned char>(text[i + 1]);
+            unsigned codePoint = ((c & 0x1Fu) << 6) | (next & 0x3Fu);
+            if ((next & 0xC0) == 0x80 && appendBaseLetter(codePoint, result)) {
+                ++i;
+                continue;
+            }
+        }
+        result += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : static_cast<char>(c);
+    }
+    return result;
+}
+
+void NameIndex::build(const map<int, Circuit>& circuitMap, const map<int, Driver>& driverMap, const map<int, Team>& teamMap) {
+    circuits.clear();
+    drivers.clear();
+    teams.clear();
+
+    for (const auto& entry : circuitMap) {
+        addCircuit(entry.second);
+    }
+    for (const auto& entry : driverMap) {
+        addDriver(entry.second);
+    }
+    for (const auto& entry : teamMap) {
+        addTeam(entry.second);
+    }
+}
+
+void NameIndex::addCircuit(const Circuit& circuit) {
+    addKey(circuits, circuit.name, circuit.circuitId);
+    addKey(circuits, circuit.circuitRef, circuit.circuitId);
+}
+
+void NameIndex::addDriver(const Driver& driver) {
+    addKey(drivers, driver.fullName, driver.driverId);
+    addKey(drivers, driver.code, driver.driverId);
+    addKey(drivers, driver.driverRef, driver.driverId);
+}
+
+void NameIndex::addTeam(const Team& team) {
+    addKey(teams, team.name, team.teamId);
+    addKey(teams, team.teamRef, team.teamId);
+}
+
+// Mantiene cada lista de ids ordenada aunque el id llegue tarde (cargas incrementales)
+void NameIndex::addKey(KeyMap& keys, InternedString text, int id) {
+    if (text.empty() || text.str() == "\\N") {
+        return;
+    }
+    vector<int>& ids = keys[normalize(text.str())];
+    auto position = lower_bound(ids.begin(), ids.end(), id);
+    if (position == ids.end() || *position != id) {
+        ids.insert(position, id);
+    }
+}
+
+vector<int> NameIndex::find(const KeyMap& keys, string_view name) {
+    auto it = keys.find(normalize(name));
+    return it != keys.end() ? it->second : vector<int>();
+}
@@ -0,0 +1,50 @@
+#ifndef NAME_INDEX_HPP
+#define NAME_INDEX_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include "Circuit.hpp"
+#include "Driver.hpp"
+#include "Team.hpp"
+
+using namespace std;
+
+// Indice hash de nombres -> ids, construido al cargar los datos.
+// Las claves se normalizan (minusculas, sin acentos, espacios simples), asi que
+// "PEREZ", "Pérez" y "perez" encuentran lo mismo. Claves de cada entidad:
+//   pilotos   : nombre completo, codigo (HAM) y driverRef (hamilton)
+//   equipos   : nombre y constructorRef
+//   circuitos : nombre y circuitRef
+// Una clave puede corresponder a varios ids (p. ej. pilotos homonimos).
+class NameIndex {
+public:
+    void build(const map<int, Circuit>& circuits, const map<int, Driver>& drivers, const map<int, Team>& teams);
+
+    // Anaden las claves de una entidad nueva (para cargas incrementales)
+    void addCircuit(const Circuit& circuit);
+    void addDriver(const Driver& driver);
+    void addTeam(const Team& team);
+
+    // Ids que coinciden con 'name', en orden ascendente; vacio si no hay ninguno
+    vector<int> findDrivers(string_view name) const { return find(drivers, name); }
+    vector<int> findTeams(string_view name) const { return find(teams, name); }
+    vector<int> findCircuits(string_view name) const { return find(circuits, name); }
+
+    // Minusculas, acentos latinos eliminados (UTF-8) y espacios colapsados
+    static string normalize(string_view text);
+
+private:
+    typedef unordered_map<string, vector<int>> KeyMap;
+
+    KeyMap drivers;
+    KeyMap teams;
+    KeyMap circuits;
+
+    static void addKey(KeyMap& keys, InternedString text, int id);
+    static vector<int> find(const KeyMap& keys, string_view name);
+};
+
+#endif // NAME_INDEX_HPP
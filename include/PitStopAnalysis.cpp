@@ -0,0 +1,154 @@
+#include "PitStopAnalysis.hpp"
+#include <algorithm>
+#include <map>
+#include <numeric>
+
+using namespace std;
+
+namespace {
+
+// Percentil (0..1) por seleccion parcial; 'values' se reordena
+template <typename T>
+T percentile(vector<T>& values, double fraction) {
+    size_t index = static_cast<size_t>(fraction * (values.size() - 1) + 0.5);
+    nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+}
+
+vector<TeamPitSummary> PitStopAnalysis::teamStopTimes(const PitStopTable& pitStops, int startYear, int endYear) {
+    map<int, vector<int32_t>> times;
+    for (size_t i = 0; i < pitStops.size(); ++i) {
+        if (pitStops.constructorId[i] >= 0 && pitStops.year[i] >= startYear && pitStops.year[i] <= endYear
+            && pitStops.milliseconds[i] <= MAX_STOP_MS) {
+            times[pitStops.constructorId[i]].push_back(pitStops.milliseconds[i]);
+        }
+    }
+
+    vector<TeamPitSummary> summaries;
+    for (auto& entry : times) {
+        vector<int32_t>& stops = entry.second;
+        int32_t best = *min_element(stops.begin(), stops.end());
+        summaries.push_back({ entry.first, stops.size(), percentile(stops, 0.5) / 1000.0, best / 1000.0 });
+    }
+    sort(summaries.begin(), summaries.end(), [](const TeamPitSummary& a, const TeamPitSummary& b) {
+        if (a.medianSeconds != b.medianSeconds) {
+            return a.medianSeconds < b.medianSeconds;
+        }
+        return a.teamId < b.teamId;
+    });
+    return summaries;
+}
+
+vector<CircuitPitProfile> PitStopAnalysis::circuitProfiles(const PitStopTable& pitStops, const ResultsTable& results,
+    optional<int> circuitId) {
+    // Agrupa por circuito: paradas por (carrera, piloto), vueltas por numero de parada y tiempos
+    struct Accumulator {
+        map<pair<int, int>, int> stopsPerEntry;
+        map<pair<int, int>, int> stopsPerLap;  // (carrera, vuelta) -> paradas
+        vector<vector<int32_t>> lapsByStop;
+        vector<int32_t> times;
+    };
+    map<int, Accumulator> circuits;
+    map<int, int> raceCircuit;
+    for (size_t i = 0; i < pitStops.size(); ++i) {
+        int circuit = pitStops.circuitId[i];
+        if (circuit < 0 || (circuitId && circuit != *circuitId) || pitStops.stop[i] <= 0) {
+            continue;
+        }
+        Accumulator& acc = circuits[circuit];
+        int& stops = acc.stopsPerEntry[{ pitStops.raceId[i], pitStops.driverId[i] }];
+        stops = max(stops, pitStops.stop[i]);
+        if (acc.lapsByStop.size() < static_cast<size_t>(pitStops.stop[i])) {
+            acc.lapsByStop.resize(pitStops.stop[i]);
+        }
+        acc.lapsByStop[pitStops.stop[i] - 1].push_back(pitStops.lap[i]);
+        if (pitStops.lap[i] > 1) {
+            ++acc.stopsPerLap[{ pitStops.raceId[i], pitStops.lap[i] }];
+        }
+        if (pitStops.milliseconds[i] <= MAX_STOP_MS) {
+            acc.times.push_back(pitStops.milliseconds[i]);
+        }
+        raceCircuit[pitStops.raceId[i]] = circuit;
+    }
+
+    // Distancia de cada carrera con paradas (vueltas del ganador o maximo completado)
+    // y vuelta media del ganador
+    map<int, int> raceLaps;
+    map<int, double> winnerLapSeconds;
+    for (size_t row = 0; row < results.size(); ++row) {
+        if (results.session[row] == static_cast<uint8_t>(Session::Race) && raceCircuit.count(results.raceId[row])) {
+            int& laps = raceLaps[results.raceId[row]];
+            laps = max(laps, results.laps[row]);
+            if (results.position[row] == 1 && results.milliseconds[row] > 0 && results.laps[row] > 0) {
+                winnerLapSeconds[results.raceId[row]] = results.milliseconds[row] / 1000.0 / results.laps[row];
+            }
+        }
+    }
+
+    vector<CircuitPitProfile> profiles;
+    for (auto& entry : circuits) {
+        Accumulator& acc = entry.second;
+        CircuitPitProfile profile;
+        profile.circuitId = entry.first;
+
+        vector<int> counts;
+        vector<int> distances;
+        vector<double> lapTimes;
+        int lastRace = -1;
+        for (const auto& stops : acc.stopsPerEntry) {
+            counts.push_back(stops.second);
+            if (stops.first.first != lastRace) {
+                lastRace = stops.first.first;
+                ++profile.races;
+                auto laps = raceLaps.find(lastRace);
+                if (laps != raceLaps.end() && laps->second > 0) {
+                    distances.push_back(laps->second);
+                }
+                auto lapTime = winnerLapSeconds.find(lastRace);
+                if (lapTime != winnerLapSeconds.end()) {
+                    lapTimes.push_back(lapTime->second);
+                }
+            }
+            if (profile.stopCounts.size() <= static_cast<size_t>(stops.second)) {
+                profile.stopCounts.resize(stops.second + 1);
+            }
+            ++profile.stopCounts[stops.second];
+        }
+        profile.entries = counts.size();
+        profile.averageStops = static_cast<double>(accumulate(counts.begin(), counts.end(), 0LL)) / counts.size();
+        profile.typicalStops = percentile(counts, 0.5);
+        profile.raceLaps = distances.empty() ? 0 : percentile(distances, 0.5);
+        profile.lapSeconds = lapTimes.empty() ? 0.0 : percentile(lapTimes, 0.5);
+        profile.medianSeconds = acc.times.empty() ? 0.0 : percentile(acc.times, 0.5) / 1000.0;
+
+        size_t neutralised = 0;
+        int countedRace = -1;
+        for (const auto& lap : acc.stopsPerLap) {
+            if (lap.second >= NEUTRALISED_STOPS && lap.first.first != countedRace) {
+                countedRace = lap.first.first;
+                ++neutralised;
+            }
+        }
+        profile.safetyCarRate = profile.races ? static_cast<double>(neutralised) / profile.races : 0.0;
+
+        for (size_t stop = 0; stop < acc.lapsByStop.size(); ++stop) {
+            vector<int32_t>& laps = acc.lapsByStop[stop];
+            if (laps.empty()) {
+                continue;
+            }
+            int lower = percentile(laps, 0.25);
+            int median = percentile(laps, 0.5);
+            int upper = percentile(laps, 0.75);
+            profile.stopLaps.push_back({ static_cast<int>(stop) + 1, laps.size(), lower, median, upper });
+        }
+        if (!profile.stopLaps.empty()) {
+            const StopLapSummary& first = profile.stopLaps.front();
+            profile.undercutStart = first.lowerLap;
+            profile.undercutEnd = max(first.lowerLap, first.medianLap - 1);
+        }
+        profiles.push_back(move(profile));
+    }
+    return profiles;
+}
@@ -0,0 +1,65 @@
+#ifndef PIT_STOP_ANALYSIS_HPP
+#define PIT_STOP_ANALYSIS_HPP
+
+#include <vector>
+#include <optional>
+#include <cstddef>
+#include "PitStopTable.hpp"
+#include "ResultsTable.hpp"
+
+using namespace std;
+
+// Tiempo en boxes de un equipo. pit_stops.csv solo trae el tiempo total en el
+// pit lane, que es la mejor aproximacion disponible al tiempo detenido.
+struct TeamPitSummary {
+    int teamId;
+    size_t stops;
+    double medianSeconds;
+    double bestSeconds;
+};
+
+// Distribucion de la vuelta de la parada numero 'stop'
+struct StopLapSummary {
+    int stop;
+    size_t count;
+    int lowerLap;   // percentil 25
+    int medianLap;
+    int upperLap;   // percentil 75
+};
+
+// Historico de paradas de un circuito
+struct CircuitPitProfile {
+    int circuitId = -1;
+    size_t races = 0;                  // Carreras con datos de paradas
+    size_t entries = 0;                // Participaciones (piloto y carrera) con alguna parada
+    int typicalStops = 0;              // Mediana de paradas por participacion
+    double averageStops = 0.0;
+    vector<size_t> stopCounts;         // stopCounts[k] = participaciones con k paradas
+    vector<StopLapSummary> stopLaps;   // Por numero de parada (1, 2, ...)
+    int raceLaps = 0;                  // Mediana de vueltas completadas por el ganador
+    double lapSeconds = 0.0;           // Mediana de la vuelta media del ganador (0 si no hay tiempos)
+    // Fraccion de carreras con una neutralizacion aparente: al menos
+    // NEUTRALISED_STOPS pilotos parando en la misma vuelta (no hay datos de safety car)
+    double safetyCarRate = 0.0;
+    // Ventana de undercut: del percentil 25 de la vuelta de la primera parada a
+    // la vuelta anterior a la mediana, es decir, antes que la mayoria de rivales
+    int undercutStart = 0;
+    int undercutEnd = 0;
+    double medianSeconds = 0.0;
+};
+
+class PitStopAnalysis {
+public:
+    // Paradas mas largas que esto (banderas rojas, reparaciones) no cuentan en los tiempos
+    static const int MAX_STOP_MS = 60000;
+    static const int NEUTRALISED_STOPS = 6;
+
+    // Mediana del tiempo en boxes de cada equipo entre startYear y endYear, de menor a mayor
+    vector<TeamPitSummary> teamStopTimes(const PitStopTable& pitStops, int startYear, int endYear);
+
+    // Perfil de cada circuito con paradas (o solo de 'circuitId') en una pasada por la tabla
+    vector<CircuitPitProfile> circuitProfiles(const PitStopTable& pitStops, const ResultsTable& results,
+        optional<int> circuitId = nullopt);
+};
+
+#endif // PIT_STOP_ANALYSIS_HPP
@@ -0,0 +1,57 @@
+#include "PitStopTable.hpp"
+
+void PitStopTable::reserve(size_t rows) {
+    raceId.reserve(rows);
+    driverId.reserve(rows);
+    constructorId.reserve(rows);
+    circuitId.reserve(rows);
+    year.reserve(rows);
+    stop.reserve(rows);
+    lap.reserve(rows);
+    milliseconds.reserve(rows);
+}
+
+void PitStopTable::resize(size_t rows) {
+    raceId.resize(rows);
+    driverId.resize(rows);
+    constructorId.resize(rows);
+    circuitId.resize(rows);
+    year.resize(rows);
+    stop.resize(rows);
+    lap.resize(rows);
+    milliseconds.resize(rows);
+}
+
+void PitStopTable::copyRow(size_t from, size_t to) {
+    raceId[to] = raceId[from];
+    driverId[to] = driverId[from];
+    constructorId[to] = constructorId[from];
+    circuitId[to] = circuitId[from];
+    year[to] = year[from];
+    stop[to] = stop[from];
+    lap[to] = lap[from];
+    milliseconds[to] = milliseconds[from];
+}
+
+void PitStopTable::appendRows(const PitStopTable& other) {
+    raceId.insert(raceId.end(), other.raceId.begin(), other.raceId.end());
+    driverId.insert(driverId.end(), other.driverId.begin(), other.driverId.end());
+    constructorId.insert(constructorId.end(), other.constructorId.begin(), other.constructorId.end());
+    circuitId.insert(circuitId.end(), other.circuitId.begin(), other.circuitId.end());
+    year.insert(year.end(), other.year.begin(), other.year.end());
+    stop.insert(stop.end(), other.stop.begin(), other.stop.end());
+    lap.insert(lap.end(), other.lap.begin(), other.lap.end());
+    milliseconds.insert(milliseconds.end(), other.milliseconds.begin(), other.milliseconds.end());
+}
+
+// Anade una fila; equipo, circuito y ano se rellenan al unir con carreras y resultados
+void PitStopTable::append(int raceId, int driverId, int stop, int lap, int milliseconds) {
+    this->raceId.push_back(raceId);
+    this->driverId.push_back(driverId);
+    this->constructorId.push_back(-1);
+    this->circuitId.push_back(-1);
+    this->year.push_back(0);
+    this->stop.push_back(stop);
+    this->lap.push_back(lap);
+    this->milliseconds.push_back(milliseconds);
+}
@@ -0,0 +1,36 @@
+#ifndef PIT_STOP_TABLE_HPP
+#define PIT_STOP_TABLE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// Paradas en boxes de pit_stops.csv en formato columnar, como ResultsTable.
+// El ano, el circuito y el equipo se desnormalizan al cargar (a partir de
+// races.csv y results.csv) para agrupar sin seguir punteros.
+class PitStopTable {
+public:
+    vector<int32_t> raceId;
+    vector<int32_t> driverId;
+    vector<int32_t> constructorId;  // -1 si el piloto no tiene resultado en la carrera
+    vector<int32_t> circuitId;      // -1 si la carrera no tiene circuito
+    vector<int32_t> year;
+    vector<int32_t> stop;           // 1 = primera parada del piloto en la carrera
+    vector<int32_t> lap;
+    vector<int32_t> milliseconds;   // Tiempo en el pit lane
+
+    size_t size() const { return raceId.size(); }
+    bool empty() const { return raceId.empty(); }
+
+    void reserve(size_t rows);
+    void resize(size_t rows);
+    // Copia la fila 'from' sobre la fila 'to' (para compactar la tabla)
+    void copyRow(size_t from, size_t to);
+    // Anade al final todas las filas de otra tabla
+    void appendRows(const PitStopTable& other);
+    void append(int raceId, int driverId, int stop, int lap, int milliseconds);
+};
+
+#endif // PIT_STOP_TABLE_HPP
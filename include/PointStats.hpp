@@ -0,0 +1,38 @@
+#ifndef POINT_STATS_HPP
+#define POINT_STATS_HPP
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+// Estadisticas de una serie de puntos calculadas en una sola pasada:
+// maximo, minimo, media y desviacion tipica (poblacional) con el metodo de
+// Welford, sin guardar los valores.
+struct PointStats {
+    size_t count = 0;
+    double maxPoints = 0.0;
+    double minPoints = 0.0;
+    double averagePoints = 0.0;
+    double m2 = 0.0; // Suma de cuadrados de las diferencias con la media
+
+    void add(double points) {
+        if (count == 0) {
+            maxPoints = minPoints = points;
+        } else {
+            maxPoints = max(maxPoints, points);
+            minPoints = min(minPoints, points);
+        }
+        ++count;
+        double delta = points - averagePoints;
+        averagePoints += delta / count;
+        m2 += delta * (points - averagePoints);
+    }
+
+    bool empty() const { return count == 0; }
+    double variance() const { return count > 0 ? m2 / count : 0.0; }
+    double stdDevPoints() const { return sqrt(variance()); }
+};
+
+#endif // POINT_STATS_HPP
@@ -0,0 +1,122 @@
+#include "PredictionKernel.hpp"
+#include <algorithm>
+#include <cmath>
+
+// AVX2 se compila solo para x86. Con GCC/Clang se elige en tiempo de ejecucion;
+// con MSVC solo si el proyecto se compila con /arch:AVX2.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define PREDICTION_HAS_AVX2 1
+#define PREDICTION_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(__AVX2__)
+#include <immintrin.h>
+#define PREDICTION_HAS_AVX2 1
+#define PREDICTION_AVX2_TARGET
+#endif
+
+vector<double> PredictionKernel::buildWeightTable(const PredictionSettings& settings, int firstYear, int lastYear) {
+    vector<double> weights;
+    if (lastYear < firstYear) {
+        return weights;
+    }
+
+    int referenceYear = settings.referenceYear > 0 ? settings.referenceYear : lastYear;
+    weights.reserve(static_cast<size_t>(lastYear - firstYear + 1));
+    for (int year = firstYear; year <= lastYear; ++year) {
+        // Las carreras posteriores al ano de referencia cuentan como las mas recientes
+        double age = max(0, referenceYear - year);
+        double weight = 1.0;
+        switch (settings.weighting) {
+        case WeightingMode::LogDecay:
+            weight = 1.0 / max(1.0, log(age + 1));  // Uso de logaritmo para suavizar la penalización
+            break;
+        case WeightingMode::HalfLife:
+            weight = settings.halfLifeYears > 0 ? pow(0.5, age / settings.halfLifeYears) : (age == 0 ? 1.0 : 0.0);
+            break;
+        case WeightingMode::Linear:
+            weight = settings.linearSpanYears > 0 ? max(0.0, 1.0 - age / settings.linearSpanYears) : (age == 0 ? 1.0 : 0.0);
+            break;
+        }
+        weights.push_back(weight);
+    }
+    return weights;
+}
+
+void PredictionKernel::accumulateScalar(const double* points, const int32_t* yearSlots, size_t count, const double* weights,
+    double& weightedPoints, double& totalWeight) {
+    for (size_t i = 0; i < count; ++i) {
+        double weight = weights[yearSlots[i]];
+        weightedPoints += points[i] * weight;
+        totalWeight += weight;
+    }
+}
+
+#ifdef PREDICTION_HAS_AVX2
+PREDICTION_AVX2_TARGET
+void PredictionKernel::accumulateAvx2(const double* points, const int32_t* yearSlots, size_t count, const double* weights,
+    double& weightedPoints, double& totalWeight) {
+    __m256d sumPoints = _mm256_setzero_pd();
+    __m256d sumWeights = _mm256_setzero_pd();
+    // Gather con mascara completa y origen a cero (la version sin mascara deja el origen sin inicializar)
+    const __m256d allLanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i slots = _mm_loadu_si128(reinterpret_cast<const __m128i*>(yearSlots + i));
+        __m256d weight = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), weights, slots, allLanes, 8);
+        __m256d value = _mm256_loadu_pd(points + i);
+        sumPoints = _mm256_add_pd(sumPoints, _mm256_mul_pd(value, weight));
+        sumWeights = _mm256_add_pd(sumWeights, weight);
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, sumPoints);
+    weightedPoints += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    _mm256_storeu_pd(lanes, sumWeights);
+    totalWeight += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+    accumulateScalar(points + i, yearSlots + i, count - i, weights, weightedPoints, totalWeight);
+}
+#else
+void PredictionKernel::accumulateAvx2(const double* points, const int32_t* yearSlots, size_t count, const double* weights,
+    double& weightedPoints, double& totalWeight) {
+    accumulateScalar(points, yearSlots, count, weights, weightedPoints, totalWeight);
+}
+#endif
+
+bool PredictionKernel::usesAvx2() {
+#if defined(PREDICTION_HAS_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#elif defined(PREDICTION_HAS_AVX2)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PredictionKernel::accumulate(const double* points, const int32_t* yearSlots, size_t count, const double* weights,
+    double& weightedPoints, double& totalWeight) {
+    if (usesAvx2()) {
+        accumulateAvx2(points, yearSlots, count, weights, weightedPoints, totalWeight);
+    } else {
+        accumulateScalar(points, yearSlots, count, weights, weightedPoints, totalWeight);
+    }
+}
+
+optional<WeightingMode> PredictionKernel::parseWeighting(const string& name) {
+    for (WeightingMode mode : { WeightingMode::LogDecay, WeightingMode::HalfLife, WeightingMode::Linear }) {
+        if (name == weightingName(mode)) {
+            return mode;
+        }
+    }
+    return nullopt;
+}
+
+const char* PredictionKernel::weightingName(WeightingMode mode) {
+    switch (mode) {
+    case WeightingMode::LogDecay: return "log";
+    case WeightingMode::HalfLife: return "half-life";
+    case WeightingMode::Linear: return "linear";
+    }
+    return "";
+}
@@ -0,0 +1,57 @@
+#ifndef PREDICTION_KERNEL_HPP
+#define PREDICTION_KERNEL_HPP
+
+#include <vector>
+#include <string>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// Funcion de peso segun la antiguedad de la carrera
+enum class WeightingMode {
+    LogDecay,   // 1 / max(1, log(anos + 1)) (el modelo original)
+    HalfLife,   // 0.5 ^ (anos / halfLifeYears)
+    Linear      // max(0, 1 - anos / linearSpanYears)
+};
+
+struct PredictionSettings {
+    WeightingMode weighting = WeightingMode::LogDecay;
+    int referenceYear = 0;          // 0 = ultimo ano presente en los datos
+    double halfLifeYears = 5.0;
+    double linearSpanYears = 20.0;
+    // Ritmo a una vuelta: los puntos se multiplican por exp(-qualifyingWeight * d), con d
+    // la distancia media a la pole (%) ponderada con la misma funcion. 0 = sin este factor
+    double qualifyingWeight = 0.0;
+    // Fiabilidad: los puntos se multiplican por (1 - f)^reliabilityWeight, con f la tasa
+    // de averias por salida ponderada igual. 0 = sin este factor
+    double reliabilityWeight = 0.0;
+};
+
+// Nucleo de la media ponderada de ResultsPredictor.
+// El peso de cada ano se calcula una vez en una tabla pequena; despues las
+// sumas se hacen sobre columnas contiguas (puntos y posicion del ano en la
+// tabla), con AVX2 cuando la CPU lo permite y con un bucle escalar si no.
+class PredictionKernel {
+public:
+    // Pesos de los anos [firstYear, lastYear]; la posicion i es el ano firstYear + i
+    static vector<double> buildWeightTable(const PredictionSettings& settings, int firstYear, int lastYear);
+
+    // Suma points[i] * weights[yearSlots[i]] y weights[yearSlots[i]] para i < count
+    static void accumulate(const double* points, const int32_t* yearSlots, size_t count, const double* weights,
+        double& weightedPoints, double& totalWeight);
+
+    static bool usesAvx2();
+
+    static optional<WeightingMode> parseWeighting(const string& name);  // log, half-life, linear
+    static const char* weightingName(WeightingMode mode);
+
+private:
+    static void accumulateScalar(const double* points, const int32_t* yearSlots, size_t count, const double* weights,
+        double& weightedPoints, double& totalWeight);
+    static void accumulateAvx2(const double* points, const int32_t* yearSlots, size_t count, const double* weights,
+        double& weightedPoints, double& totalWeight);
+};
+
+#endif // PREDICTION_KERNEL_HPP
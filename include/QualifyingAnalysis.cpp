@@ -0,0 +1,153 @@
+#include "QualifyingAnalysis.hpp"
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+using namespace std;
+
+namespace {
+
+// Mediana por seleccion parcial; 'values' se reordena
+double median(vector<double>& values) {
+    size_t middle = values.size() / 2;
+    nth_element(values.begin(), values.begin() + middle, values.end());
+    double upper = values[middle];
+    if (values.size() % 2 == 1) {
+        return upper;
+    }
+    return (*max_element(values.begin(), values.begin() + middle) + upper) / 2.0;
+}
+
+// Mejor tiempo de la pole en una carrera; -1 si nadie marco tiempo
+int32_t poleTime(const QualifyingTable& qualifying, const vector<uint32_t>& rows) {
+    int32_t pole = -1;
+    for (uint32_t row : rows) {
+        int32_t best = qualifying.bestMs(row);
+        if (best > 0 && (pole < 0 || best < pole)) {
+            pole = best;
+        }
+    }
+    return pole;
+}
+
+// Recorre las filas de clasificacion de cada carrera entre startYear y endYear
+template <typename Visit>
+void forEachRace(const DataIndexes& indexes, int startYear, int endYear, Visit visit) {
+    pair<size_t, size_t> range = indexes.racesBetween(startYear, endYear);
+    for (size_t i = range.first; i < range.second; ++i) {
+        auto rows = indexes.qualifyingByRace.find(indexes.racesByDate[i]->raceId);
+        if (rows != indexes.qualifyingByRace.end()) {
+            visit(rows->second);
+        }
+    }
+}
+
+}
+
+vector<QualifyingGap> QualifyingAnalysis::gapToPole(const QualifyingTable& qualifying, const ResultsTable& results,
+    const DataIndexes& indexes, int raceId) {
+    vector<QualifyingGap> gaps;
+    auto rows = indexes.qualifyingByRace.find(raceId);
+    if (rows == indexes.qualifyingByRace.end()) {
+        return gaps;
+    }
+
+    int32_t pole = poleTime(qualifying, rows->second);
+    for (uint32_t row : rows->second) {
+        int32_t best = qualifying.bestMs(row);
+        if (best <= 0) {
+            continue;
+        }
+        QualifyingGap gap{ qualifying.driverId[row], qualifying.constructorId[row], qualifying.position[row],
+            best, best - pole, (best - pole) * 100.0 / pole, -1 };
+
+        auto driverRows = indexes.resultsByDriver.find(gap.driverId);
+        if (driverRows != indexes.resultsByDriver.end()) {
+            for (auto result = driverRows->second.rbegin(); result != driverRows->second.rend(); ++result) {
+                if (results.raceId[*result] == raceId && results.session[*result] == static_cast<uint8_t>(Session::Race)) {
+                    gap.raceFastestLapMs = results.fastestLapMs[*result];
+                    break;
+                }
+            }
+        }
+        gaps.push_back(gap);
+    }
+
+    sort(gaps.begin(), gaps.end(), [](const QualifyingGap& a, const QualifyingGap& b) {
+        return a.bestMs != b.bestMs ? a.bestMs < b.bestMs : a.position < b.position;
+    });
+    return gaps;
+}
+
+vector<TeammateDelta> QualifyingAnalysis::teammateDeltas(const QualifyingTable& qualifying, const DataIndexes& indexes,
+    int startYear, int endYear) {
+    // (piloto, companero, equipo) -> deltas en %
+    map<tuple<int, int, int>, vector<double>> deltas;
+    forEachRace(indexes, startYear, endYear, [&](const vector<uint32_t>& rows) {
+        for (uint32_t a : rows) {
+            for (uint32_t b : rows) {
+                if (a == b || qualifying.constructorId[a] < 0 || qualifying.constructorId[a] != qualifying.constructorId[b]) {
+                    continue;
+                }
+                // Ultima sesion en la que ambos marcaron tiempo
+                const vector<int32_t>* sessions[] = { &qualifying.q3, &qualifying.q2, &qualifying.q1 };
+                for (const vector<int32_t>* session : sessions) {
+                    int32_t timeA = (*session)[a];
+                    int32_t timeB = (*session)[b];
+                    if (timeA > 0 && timeB > 0) {
+                        deltas[{ qualifying.driverId[a], qualifying.driverId[b], qualifying.constructorId[a] }]
+                            .push_back((timeA - timeB) * 100.0 / timeB);
+                        break;
+                    }
+                }
+            }
+        }
+    });
+
+    vector<TeammateDelta> duels;
+    for (auto& entry : deltas) {
+        vector<double>& values = entry.second;
+        size_t ahead = count_if(values.begin(), values.end(), [](double delta) { return delta < 0; });
+        duels.push_back({ get<0>(entry.first), get<1>(entry.first), get<2>(entry.first), values.size(), ahead, median(values) });
+    }
+    sort(duels.begin(), duels.end(), [](const TeammateDelta& a, const TeammateDelta& b) {
+        if (a.medianDeltaPercent != b.medianDeltaPercent) {
+            return a.medianDeltaPercent < b.medianDeltaPercent;
+        }
+        return tie(a.driverId, a.teammateId, a.teamId) < tie(b.driverId, b.teammateId, b.teamId);
+    });
+    return duels;
+}
+
+vector<QualifyingPace> QualifyingAnalysis::seasonPace(const QualifyingTable& qualifying, const DataIndexes& indexes, int year) {
+    struct Accumulator {
+        vector<double> gaps;
+        long long positions = 0;
+        size_t poles = 0;
+    };
+    map<int, Accumulator> drivers;
+    forEachRace(indexes, year, year, [&](const vector<uint32_t>& rows) {
+        int32_t pole = poleTime(qualifying, rows);
+        for (uint32_t row : rows) {
+            int32_t best = qualifying.bestMs(row);
+            if (best <= 0) {
+                continue;
+            }
+            Accumulator& driver = drivers[qualifying.driverId[row]];
+            driver.gaps.push_back((best - pole) * 100.0 / pole);
+            driver.positions += qualifying.position[row];
+            driver.poles += qualifying.position[row] == 1 ? 1 : 0;
+        }
+    });
+
+    vector<QualifyingPace> ranking;
+    for (auto& entry : drivers) {
+        size_t races = entry.second.gaps.size();
+        ranking.push_back({ entry.first, races, median(entry.second.gaps),
+            static_cast<double>(entry.second.positions) / races, entry.second.poles });
+    }
+    sort(ranking.begin(), ranking.end(), [](const QualifyingPace& a, const QualifyingPace& b) {
+        return a.medianGapPercent != b.medianGapPercent ? a.medianGapPercent < b.medianGapPercent : a.driverId < b.driverId;
+    });
+    return ranking;
+}
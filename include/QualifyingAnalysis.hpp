@@ -0,0 +1,59 @@
+#ifndef QUALIFYING_ANALYSIS_HPP
+#define QUALIFYING_ANALYSIS_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "QualifyingTable.hpp"
+#include "ResultsTable.hpp"
+#include "DataIndexes.hpp"
+
+using namespace std;
+
+// Distancia de un piloto a la pole en una carrera (mejor tiempo de Q1-Q3)
+struct QualifyingGap {
+    int driverId;
+    int teamId;
+    int position;
+    int32_t bestMs;
+    int32_t gapMs;
+    double gapPercent;
+    int32_t raceFastestLapMs;  // Vuelta rapida del piloto en la carrera; -1 si no hay
+};
+
+// Duelo a una vuelta de un piloto con un companero de equipo. Cada carrera se
+// compara en la ultima sesion en la que ambos marcaron tiempo; un delta
+// negativo significa que el piloto fue mas rapido.
+struct TeammateDelta {
+    int driverId;
+    int teammateId;
+    int teamId;
+    size_t races;
+    size_t ahead;
+    double medianDeltaPercent;
+};
+
+// Ritmo de un piloto en una temporada
+struct QualifyingPace {
+    int driverId;
+    size_t races;
+    double medianGapPercent;
+    double averagePosition;
+    size_t poles;
+};
+
+class QualifyingAnalysis {
+public:
+    // Pilotos con tiempo en la carrera 'raceId', del mas rapido al mas lento
+    vector<QualifyingGap> gapToPole(const QualifyingTable& qualifying, const ResultsTable& results,
+        const DataIndexes& indexes, int raceId);
+
+    // Duelos entre companeros en las carreras de [startYear, endYear], del mejor delta al peor
+    vector<TeammateDelta> teammateDeltas(const QualifyingTable& qualifying, const DataIndexes& indexes,
+        int startYear, int endYear);
+
+    // Ranking de ritmo de la temporada por mediana de la distancia a la pole
+    vector<QualifyingPace> seasonPace(const QualifyingTable& qualifying, const DataIndexes& indexes, int year);
+};
+
+#endif // QUALIFYING_ANALYSIS_HPP
@@ -0,0 +1,67 @@
+#include "QualifyingTable.hpp"
+
+void QualifyingTable::reserve(size_t rows) {
+    qualifyId.reserve(rows);
+    raceId.reserve(rows);
+    driverId.reserve(rows);
+    constructorId.reserve(rows);
+    circuitId.reserve(rows);
+    year.reserve(rows);
+    position.reserve(rows);
+    q1.reserve(rows);
+    q2.reserve(rows);
+    q3.reserve(rows);
+}
+
+void QualifyingTable::resize(size_t rows) {
+    qualifyId.resize(rows);
+    raceId.resize(rows);
+    driverId.resize(rows);
+    constructorId.resize(rows);
+    circuitId.resize(rows);
+    year.resize(rows);
+    position.resize(rows);
+    q1.resize(rows);
+    q2.resize(rows);
+    q3.resize(rows);
+}
+
+void QualifyingTable::copyRow(size_t from, size_t to) {
+    qualifyId[to] = qualifyId[from];
+    raceId[to] = raceId[from];
+    driverId[to] = driverId[from];
+    constructorId[to] = constructorId[from];
+    circuitId[to] = circuitId[from];
+    year[to] = year[from];
+    position[to] = position[from];
+    q1[to] = q1[from];
+    q2[to] = q2[from];
+    q3[to] = q3[from];
+}
+
+void QualifyingTable::appendRows(const QualifyingTable& other) {
+    qualifyId.insert(qualifyId.end(), other.qualifyId.begin(), other.qualifyId.end());
+    raceId.insert(raceId.end(), other.raceId.begin(), other.raceId.end());
+    driverId.insert(driverId.end(), other.driverId.begin(), other.driverId.end());
+    constructorId.insert(constructorId.end(), other.constructorId.begin(), other.constructorId.end());
+    circuitId.insert(circuitId.end(), other.circuitId.begin(), other.circuitId.end());
+    year.insert(year.end(), other.year.begin(), other.year.end());
+    position.insert(position.end(), other.position.begin(), other.position.end());
+    q1.insert(q1.end(), other.q1.begin(), other.q1.end());
+    q2.insert(q2.end(), other.q2.begin(), other.q2.end());
+    q3.insert(q3.end(), other.q3.begin(), other.q3.end());
+}
+
+// Anade una fila; circuito y ano se rellenan al unir con las carreras
+void QualifyingTable::append(int qualifyId, int raceId, int driverId, int constructorId, int position, int q1, int q2, int q3) {
+    this->qualifyId.push_back(qualifyId);
+    this->raceId.push_back(raceId);
+    this->driverId.push_back(driverId);
+    this->constructorId.push_back(constructorId);
+    this->circuitId.push_back(-1);
+    this->year.push_back(0);
+    this->position.push_back(position);
+    this->q1.push_back(q1);
+    this->q2.push_back(q2);
+    this->q3.push_back(q3);
+}
@@ -0,0 +1,49 @@
+#ifndef QUALIFYING_TABLE_HPP
+#define QUALIFYING_TABLE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// Clasificaciones de qualifying.csv en formato columnar, como ResultsTable.
+// Los tiempos de Q1/Q2/Q3 se guardan en milisegundos (-1 si el piloto no
+// marco tiempo en esa sesion). El ano y el circuito se desnormalizan al cargar.
+class QualifyingTable {
+public:
+    vector<int32_t> qualifyId;
+    vector<int32_t> raceId;
+    vector<int32_t> driverId;
+    vector<int32_t> constructorId;
+    vector<int32_t> circuitId;  // -1 si la carrera no tiene circuito
+    vector<int32_t> year;
+    vector<int32_t> position;
+    vector<int32_t> q1;
+    vector<int32_t> q2;
+    vector<int32_t> q3;
+
+    size_t size() const { return qualifyId.size(); }
+    bool empty() const { return qualifyId.empty(); }
+
+    // Mejor tiempo de las tres sesiones; -1 si no marco ninguno
+    int32_t bestMs(size_t row) const {
+        int32_t best = -1;
+        for (int32_t time : { q1[row], q2[row], q3[row] }) {
+            if (time > 0 && (best < 0 || time < best)) {
+                best = time;
+            }
+        }
+        return best;
+    }
+
+    void reserve(size_t rows);
+    void resize(size_t rows);
+    // Copia la fila 'from' sobre la fila 'to' (para compactar la tabla)
+    void copyRow(size_t from, size_t to);
+    // Anade al final todas las filas de otra tabla
+    void appendRows(const QualifyingTable& other);
+    void append(int qualifyId, int raceId, int driverId, int constructorId, int position, int q1, int q2, int q3);
+};
+
+#endif // QUALIFYING_TABLE_HPP
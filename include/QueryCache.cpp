@@ -0,0 +1,94 @@
+#include "QueryCache.hpp"
+
+QueryCache::QueryCache(size_t capacityBytes)
+    : version(0), capacity(capacityBytes) {
+    counters.capacity = capacityBytes;
+}
+
+bool QueryCache::adoptVersion(uint64_t newVersion) {
+    if (newVersion < version) {
+        return false;
+    }
+    if (newVersion > version) {
+        if (!entries.empty()) {
+            ++counters.invalidations;
+        }
+        entries.clear();
+        positions.clear();
+        counters.bytes = 0;
+        version = newVersion;
+    }
+    return true;
+}
+
+shared_ptr<const BatchResult> QueryCache::find(const string& key, uint64_t queryVersion) {
+    lock_guard<mutex> guard(lock);
+    if (!adoptVersion(queryVersion)) {
+        ++counters.misses;
+        return nullptr;
+    }
+
+    auto it = positions.find(key);
+    if (it == positions.end()) {
+        ++counters.misses;
+        return nullptr;
+    }
+    ++counters.hits;
+    entries.splice(entries.begin(), entries, it->second);  // Pasa a ser la mas reciente
+    return it->second->result;
+}
+
+void QueryCache::insert(const string& key, uint64_t queryVersion, shared_ptr<const BatchResult> result) {
+    size_t bytes = estimateBytes(key, *result);
+    lock_guard<mutex> guard(lock);
+    // Un resultado calculado sobre datos ya sustituidos no se guarda
+    if (!adoptVersion(queryVersion) || bytes > capacity) {
+        return;
+    }
+
+    auto existing = positions.find(key);
+    if (existing != positions.end()) {
+        erase(existing->second);
+    }
+    entries.push_front({ key, move(result), bytes });
+    positions.emplace(entries.front().key, entries.begin());
+    counters.bytes += bytes;
+
+    while (counters.bytes > capacity) {
+        erase(prev(entries.end()));
+        ++counters.evictions;
+    }
+}
+
+void QueryCache::clear() {
+    lock_guard<mutex> guard(lock);
+    entries.clear();
+    positions.clear();
+    counters.bytes = 0;
+}
+
+QueryCacheStats QueryCache::stats() const {
+    lock_guard<mutex> guard(lock);
+    QueryCacheStats result = counters;
+    result.entries = entries.size();
+    return result;
+}
+
+void QueryCache::erase(list<Entry>::iterator entry) {
+    counters.bytes -= entry->bytes;
+    positions.erase(entry->key);
+    entries.erase(entry);
+}
+
+// Aproximacion: objetos, cadenas y nodos de la lista y del mapa
+size_t QueryCache::estimateBytes(const string& key, const BatchResult& result) {
+    size_t bytes = sizeof(Entry) + key.size() + 4 * sizeof(void*) + sizeof(BatchResult)
+        + result.type.size() + result.error.size();
+    for (const BatchRow& row : result.rows) {
+        bytes += sizeof(BatchRow) + row.name.size();
+        for (const auto& value : row.values) {
+            bytes += sizeof(value) + value.first.size();
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,67 @@
+#ifndef QUERY_CACHE_HPP
+#define QUERY_CACHE_HPP
+
+#include <string>
+#include <string_view>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+#include "BatchRunner.hpp"
+
+using namespace std;
+
+struct QueryCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t invalidations = 0;  // Veces que se vacio por un cambio de version
+    size_t entries = 0;
+    size_t bytes = 0;
+    size_t capacity = 0;
+};
+
+// Cache LRU de resultados de consultas, acotada por memoria (estimada).
+// Las claves son consultas normalizadas (ver BatchRunner) y todas las entradas
+// pertenecen a una version de los datos: una consulta con una version mayor
+// vacia la cache, y los resultados de versiones anteriores ya no se guardan.
+// Buscar e insertar es O(1); es segura entre hilos.
+class QueryCache {
+public:
+    static const size_t DEFAULT_CAPACITY = 16 * 1024 * 1024;
+
+    explicit QueryCache(size_t capacityBytes = DEFAULT_CAPACITY);
+
+    QueryCache(const QueryCache&) = delete;
+    QueryCache& operator=(const QueryCache&) = delete;
+
+    // Resultado guardado para 'key' con esa version, o nullptr
+    shared_ptr<const BatchResult> find(const string& key, uint64_t version);
+    void insert(const string& key, uint64_t version, shared_ptr<const BatchResult> result);
+    void clear();
+
+    QueryCacheStats stats() const;
+
+private:
+    struct Entry {
+        string key;
+        shared_ptr<const BatchResult> result;
+        size_t bytes;
+    };
+
+    mutable mutex lock;
+    list<Entry> entries;  // De la mas reciente a la menos reciente
+    unordered_map<string_view, list<Entry>::iterator> positions;  // Las claves apuntan a Entry::key
+    uint64_t version;
+    size_t capacity;
+    QueryCacheStats counters;
+
+    // Vacia la cache si 'newVersion' es mas reciente; false si es antigua
+    bool adoptVersion(uint64_t newVersion);
+    void erase(list<Entry>::iterator entry);
+    static size_t estimateBytes(const string& key, const BatchResult& result);
+};
+
+#endif // QUERY_CACHE_HPP
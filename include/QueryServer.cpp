@@ -0,0 +1,346 @@
+#include "QueryServer.hpp"
+#include "BatchRunner.hpp"
+#include "DataManager.hpp"
+#include "ThreadPool.hpp"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET SocketHandle;
+#define closeSocket closesocket
+#define SHUTDOWN_BOTH SD_BOTH
+#define SEND_FLAGS 0
+#else
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+typedef int SocketHandle;
+#define closeSocket close
+#define SHUTDOWN_BOTH SHUT_RDWR
+#define SEND_FLAGS MSG_NOSIGNAL
+#define INVALID_SOCKET (-1)
+#endif
+
+namespace {
+
+// Tamano maximo de una peticion; las lineas mas largas cierran la conexion
+const size_t MAX_LINE = 64 * 1024;
+// Peticiones en espera por conexion; con mas, se deja de leer de ella hasta que baje
+const size_t MAX_QUEUED = 64;
+// Conexiones abiertas a la vez (select() admite FD_SETSIZE sockets, incluido el de escucha)
+const size_t MAX_CONNECTIONS = FD_SETSIZE - 1;
+
+bool sendAll(SocketHandle socket, const string& text) {
+    size_t sent = 0;
+    while (sent < text.size()) {
+        auto count = send(socket, text.data() + sent, static_cast<int>(text.size() - sent), SEND_FLAGS);
+        if (count <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+// Extrae el valor de "query" de una peticion {"query": "..."}; devuelve la
+// linea tal cual si no es un objeto JSON
+string extractQuery(const string& line) {
+    size_t start = line.find_first_not_of(" \t");
+    if (start == string::npos || line[start] != '{') {
+        return line;
+    }
+    size_t key = line.find("\"query\"", start);
+    if (key == string::npos) {
+        return "";
+    }
+    size_t quote = line.find('"', line.find(':', key + 7));
+    string query;
+    for (size_t i = quote + 1; quote != string::npos && i < line.size() && line[i] != '"'; ++i) {
+        if (line[i] == '\\' && i + 1 < line.size()) {
+            char escaped = line[++i];
+            query.push_back(escaped == 'n' ? '\n' : escaped == 't' ? '\t' : escaped);
+        } else {
+            query.push_back(line[i]);
+        }
+    }
+    return query;
+}
+
+string errorLine(const string& type, const string& message) {
+    BatchResult result;
+    result.type = type;
+    result.error = message;
+    ostringstream out;
+    BatchRunner::writeJson(out, 0, result);
+    return out.str();
+}
+
+}
+
+ServerState::ServerState(Dataset&& loaded, uint64_t version)
+    : data(move(loaded)), ranking(data), ratings(data), headToHead(data), replay(data), version(version) {}
+
+QueryServer::QueryServer(const string& directory, const string& snapshotPath, Dataset&& initial)
+    : directory(directory), snapshotPath(snapshotPath),
+      state(make_shared<ServerState>(move(initial), 1)), running(false) {}
+
+bool QueryServer::reload(string& error) {
+    lock_guard<mutex> lock(reloadMutex);
+    try {
+        DataManager dataManager;
+        Dataset loaded = dataManager.loadCached(directory, snapshotPath);
+        if (loaded.races.empty() || loaded.results.empty()) {
+            error = "los datos cargados estan vacios";
+            return false;
+        }
+        uint64_t version = current()->version + 1;
+        // Se construye todo antes de publicarlo; el cambio es un unico atomic_store
+        atomic_store(&state, make_shared<ServerState>(move(loaded), version));
+        return true;
+    }
+    catch (const exception& e) {
+        error = e.what();
+        return false;
+    }
+}
+
+bool QueryServer::append(const string& deltaDirectory, DeltaSummary& summary, string& error) {
+    lock_guard<mutex> lock(reloadMutex);
+    shared_ptr<ServerState> target = atomic_load(&state);
+    try {
+        // Los CSV se leen sin bloquear; las consultas solo esperan a la fusion
+        DataManager dataManager;
+        DataManager::DeltaFiles delta = dataManager.readDelta(deltaDirectory);
+
+        // Espera a que terminen las consultas sobre este estado y bloquea las nuevas
+        unique_lock<shared_mutex> exclusive(target->appendMutex);
+        summary = dataManager.applyDelta(target->data, move(delta));
+        target->ranking.appendResults(summary.firstNewResult);
+        target->ratings.appendResults(summary.firstNewResult);
+        target->headToHead.appendResults(summary.firstNewResult, summary.firstNewQualifying);
+        target->replay.appendResults(target->data, summary.firstNewResult);
+        if (summary.added() > 0) {
+            ++target->version;
+        }
+        return true;
+    }
+    catch (const exception& e) {
+        error = e.what();
+        return false;
+    }
+}
+
+string QueryServer::handle(const string& line, size_t query, bool& closeConnection) {
+    string request = extractQuery(line);
+    if (request == "quit") {
+        closeConnection = true;
+        return "{\"type\":\"quit\"}\n";
+    }
+    if (request == "shutdown") {
+        // Las demas conexiones se cierran despues de enviar esta respuesta
+        closeConnection = true;
+        running = false;
+        return "{\"type\":\"shutdown\"}\n";
+    }
+    if (request == "ping") {
+        return "{\"type\":\"ping\",\"version\":" + to_string(current()->version) + "}\n";
+    }
+    if (request == "reload") {
+        auto start = chrono::steady_clock::now();
+        string error;
+        if (!reload(error)) {
+            return errorLine("reload", error);
+        }
+        auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+        return "{\"type\":\"reload\",\"version\":" + to_string(current()->version) + ",\"ms\":" + to_string(elapsed) + "}\n";
+    }
+    if (request.compare(0, 7, "append ") == 0) {
+        auto start = chrono::steady_clock::now();
+        DeltaSummary summary;
+        string error;
+        if (!append(request.substr(7), summary, error)) {
+            return errorLine("append", error);
+        }
+        auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+        return "{\"type\":\"append\",\"version\":" + to_string(current()->version) + ",\"races\":" + to_string(summary.races)
+            + ",\"results\":" + to_string(summary.results) + ",\"rows\":" + to_string(summary.added())
+            + ",\"skipped\":" + to_string(summary.skipped) + ",\"ms\":" + to_string(elapsed) + "}\n";
+    }
+    if (request.empty()) {
+        return errorLine("", "peticion vacia");
+    }
+
+    // La consulta mantiene vivo el estado actual aunque llegue una recarga
+    shared_ptr<const ServerState> snapshot = current();
+    shared_lock<shared_mutex> lock(snapshot->appendMutex);
+    BatchRunner batch(snapshot->data, snapshot->ranking, &cache, snapshot->version, &snapshot->ratings,
+        &snapshot->headToHead, &snapshot->replay);
+    ostringstream out;
+    out << setprecision(10);
+    BatchRunner::writeJson(out, query, batch.execute(request));
+    return out.str();
+}
+
+void QueryServer::receive(ThreadPool& pool, const shared_ptr<Connection>& connection) {
+    char buffer[4096];
+    auto count = recv(static_cast<SocketHandle>(connection->socket), buffer, sizeof(buffer), 0);
+
+    lock_guard<mutex> lock(connectionsMutex);
+    if (count <= 0) {
+        connection->closing = true;
+        return;
+    }
+    connection->pending.append(buffer, static_cast<size_t>(count));
+    size_t start = 0;
+    size_t newline;
+    while ((newline = connection->pending.find('\n', start)) != string::npos) {
+        size_t end = newline > start && connection->pending[newline - 1] == '\r' ? newline - 1 : newline;
+        if (end > start) {
+            connection->lines.push_back(connection->pending.substr(start, end - start));
+        }
+        start = newline + 1;
+    }
+    connection->pending.erase(0, start);
+    if (connection->pending.size() > MAX_LINE) {
+        // Se responde con un error despues de las peticiones anteriores y se cierra
+        connection->lines.push_back("");
+        connection->closing = true;
+    }
+
+    if (!connection->busy && !connection->lines.empty()) {
+        connection->busy = true;
+        pool.submit([this, &pool, connection]() { serveRequest(pool, connection); });
+    }
+}
+
+void QueryServer::serveRequest(ThreadPool& pool, const shared_ptr<Connection>& connection) {
+    string line;
+    size_t query;
+    {
+        lock_guard<mutex> lock(connectionsMutex);
+        line = move(connection->lines.front());
+        connection->lines.pop_front();
+        query = ++connection->queries;
+    }
+
+    SocketHandle socket = static_cast<SocketHandle>(connection->socket);
+    bool closeConnection = line.empty();
+    string response = line.empty() ? errorLine("", "peticion demasiado larga") : handle(line, query, closeConnection);
+    if (!sendAll(socket, response)) {
+        closeConnection = true;
+    }
+
+    lock_guard<mutex> lock(connectionsMutex);
+    if (closeConnection) {
+        // El cliente ve el cierre ya; el socket lo cierra el hilo de run()
+        connection->closing = true;
+        connection->lines.clear();
+        shutdown(socket, SHUTDOWN_BOTH);
+    }
+    if (running && !connection->lines.empty()) {
+        pool.submit([this, &pool, connection]() { serveRequest(pool, connection); });
+    } else {
+        connection->busy = false;
+    }
+}
+
+bool QueryServer::run(uint16_t port, size_t threads) {
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        cerr << "Error: no se pudo iniciar Winsock" << endl;
+        return false;
+    }
+#endif
+
+    SocketHandle listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener == INVALID_SOCKET) {
+        cerr << "Error: no se pudo crear el socket" << endl;
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);  // Solo conexiones locales
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 64) != 0) {
+        cerr << "Error: no se pudo escuchar en 127.0.0.1:" << port << endl;
+        closeSocket(listener);
+        return false;
+    }
+
+    cout << "Servidor escuchando en 127.0.0.1:" << port << endl;
+    running = true;
+    {
+        ThreadPool pool(threads == 0 ? thread::hardware_concurrency() : threads);
+        vector<shared_ptr<Connection>> polled;
+        while (running) {
+            fd_set readable;
+            FD_ZERO(&readable);
+            SocketHandle highest = listener;
+            polled.clear();
+            {
+                lock_guard<mutex> lock(connectionsMutex);
+                for (auto entry = connections.begin(); entry != connections.end();) {
+                    Connection& connection = *entry->second;
+                    if (connection.closing && !connection.busy) {
+                        closeSocket(static_cast<SocketHandle>(connection.socket));
+                        entry = connections.erase(entry);
+                        continue;
+                    }
+                    if (!connection.closing && connection.lines.size() < MAX_QUEUED) {
+                        FD_SET(static_cast<SocketHandle>(connection.socket), &readable);
+                        highest = max(highest, static_cast<SocketHandle>(connection.socket));
+                        polled.push_back(entry->second);
+                    }
+                    ++entry;
+                }
+                if (connections.size() < MAX_CONNECTIONS) {
+                    FD_SET(listener, &readable);
+                }
+            }
+
+            // Espera con limite para comprobar 'running' y las conexiones que terminan
+            timeval timeout = { 0, 200000 };
+            if (select(static_cast<int>(highest) + 1, &readable, nullptr, nullptr, &timeout) <= 0) {
+                continue;
+            }
+            for (const shared_ptr<Connection>& connection : polled) {
+                if (FD_ISSET(static_cast<SocketHandle>(connection->socket), &readable)) {
+                    receive(pool, connection);
+                }
+            }
+            if (FD_ISSET(listener, &readable)) {
+                SocketHandle client = accept(listener, nullptr, nullptr);
+                if (client != INVALID_SOCKET) {
+                    auto connection = make_shared<Connection>();
+                    connection->socket = static_cast<intptr_t>(client);
+                    lock_guard<mutex> lock(connectionsMutex);
+                    connections[connection->socket] = connection;
+                }
+            }
+        }
+    }  // El pool termina las peticiones ya encoladas
+
+    for (auto& entry : connections) {
+        closeSocket(static_cast<SocketHandle>(entry.first));
+    }
+    connections.clear();
+    closeSocket(listener);
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    cout << "Servidor detenido" << endl;
+    return true;
+}
@@ -0,0 +1,112 @@
+#ifndef QUERY_SERVER_HPP
+#define QUERY_SERVER_HPP
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <map>
+#include <deque>
+#include <cstdint>
+#include <cstddef>
+#include "Dataset.hpp"
+#include "RankingEngine.hpp"
+#include "RatingEngine.hpp"
+#include "HeadToHeadEngine.hpp"
+#include "ChampionshipReplay.hpp"
+#include "DataManager.hpp"
+#include "QueryCache.hpp"
+
+using namespace std;
+
+class ThreadPool;
+
+// Datos que sirve el servidor: un Dataset y sus motores de rankings, de
+// puntuaciones (uno por parametros, ver RatingEngineSet), de duelos entre
+// companeros y de campeonatos con otros sistemas, que duran lo que el estado.
+// Cada consulta trabaja sobre su propia copia del shared_ptr, asi que una
+// recarga no invalida las consultas en curso. Las cargas incrementales si
+// modifican el estado en servicio: leen el delta sin bloquear y solo la
+// fusion toma appendMutex en exclusiva; las consultas lo toman compartido.
+struct ServerState {
+    Dataset data;
+    RankingEngine ranking;
+    mutable RatingEngineSet ratings;  // Se amplia desde las consultas (tiene su propio mutex)
+    HeadToHeadEngine headToHead;
+    ChampionshipReplay replay;
+    atomic<uint64_t> version;
+    mutable shared_mutex appendMutex;
+
+    ServerState(Dataset&& loaded, uint64_t version);
+};
+
+// Servidor de consultas en 127.0.0.1 (TCP) que mantiene el Dataset en memoria.
+// Protocolo por lineas: cada peticion es una consulta del modo por lotes
+// (ver BatchRunner), sola o como {"query": "..."}, y cada respuesta es una
+// linea JSON. Comandos adicionales:
+//   ping      version de los datos en servicio
+//   reload    vuelve a cargar Database/ (instantanea o CSV) y la cambia de forma atomica
+//   append <directorio>
+//             anade los CSV de un directorio delta (DataManager::appendDelta) sin
+//             recargar el resto; no se escriben en Database/, asi que un reload
+//             posterior vuelve a los datos de Database/
+//   quit      cierra la conexion
+//   shutdown  detiene el servidor
+// El hilo de run() espera con select() en el socket de escucha y en todas las
+// conexiones, y separa las lineas recibidas; cada peticion completa es una
+// tarea del pool, de modo que una conexion abierta sin peticiones no ocupa
+// ningun hilo. Las peticiones de una misma conexion se atienden de una en una
+// y en orden. Los resultados se guardan en una QueryCache comun a todas las
+// conexiones; reload y append cambian la version de los datos, lo que la invalida.
+class QueryServer {
+public:
+    QueryServer(const string& directory, const string& snapshotPath, Dataset&& initial);
+
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    // Escucha en 'port' y atiende conexiones hasta recibir shutdown.
+    // Devuelve false si no se pudo abrir el puerto.
+    bool run(uint16_t port, size_t threads = 0);
+
+    // Responde a una linea de peticion (sin el salto de linea)
+    string handle(const string& line, size_t query, bool& closeConnection);
+
+    // Carga de nuevo los datos y los publica. Las consultas en curso siguen con los anteriores.
+    bool reload(string& error);
+
+    // Anade un directorio delta a los datos en servicio
+    bool append(const string& deltaDirectory, DeltaSummary& summary, string& error);
+
+    shared_ptr<const ServerState> current() const { return atomic_load(&state); }
+
+private:
+    string directory;
+    string snapshotPath;
+    shared_ptr<ServerState> state;
+    mutex reloadMutex;  // Solo serializa las recargas, nunca las consultas
+    atomic<bool> running;
+    QueryCache cache;
+
+    // Conexion abierta. El hilo de run() lee y encola las peticiones; como mucho
+    // hay una tarea del pool por conexion (busy), que al terminar lanza la siguiente
+    struct Connection {
+        intptr_t socket;
+        string pending;         // Bytes recibidos despues del ultimo salto de linea
+        deque<string> lines;    // Peticiones completas en espera; "" = linea demasiado larga
+        size_t queries = 0;
+        bool busy = false;
+        bool closing = false;   // No se leen mas peticiones; se cierra cuando no este busy
+    };
+
+    mutex connectionsMutex;  // Protege 'connections' y el contenido de cada Connection
+    map<intptr_t, shared_ptr<Connection>> connections;
+
+    // Lee lo disponible en la conexion y encola sus lineas completas (hilo de run())
+    void receive(ThreadPool& pool, const shared_ptr<Connection>& connection);
+    // Atiende la primera peticion en espera de la conexion (tarea del pool)
+    void serveRequest(ThreadPool& pool, const shared_ptr<Connection>& connection);
+};
+
+#endif // QUERY_SERVER_HPP
@@ -1,9 +1,9 @@
-#include "Race.hpp"
-
-// Constructor predeterminado
-Race::Race()
-    : raceId(0), year(0), circuit(nullptr), name(""), date("") {}
-
-// Constructor con parámetros
-Race::Race(int raceId, int year, const Circuit* circuit, std::string name, std::string date)
+#include "Race.hpp"
+
+// Constructor predeterminado
+Race::Race()
+    : raceId(0), year(0), circuit(nullptr) {}
+
+// Constructor con parámetros
+Race::Race(int raceId, int year, const Circuit* circuit, InternedString name, InternedString date)
     : raceId(raceId), year(year), circuit(circuit), name(name), date(date) {}
\ No newline at end of file
@@ -1,21 +1,21 @@
-#ifndef RACE_HPP
-#define RACE_HPP
-
-#include "Circuit.hpp"
-#include <string>
-
-using namespace std;
-
-class Race {
-public:
-    int raceId;
-    int year;
-    const Circuit* circuit;  // Cambio a puntero a const
-    string name;
-    string date;
-
-    Race();  // Constructor predeterminado
-    Race(int raceId, int year, const Circuit* circuit, string name, string date);
-};
-
+#ifndef RACE_HPP
+#define RACE_HPP
+
+#include "Circuit.hpp"
+#include "InternedString.hpp"
+
+using namespace std;
+
+class Race {
+public:
+    int raceId;
+    int year;
+    const Circuit* circuit;  // Cambio a puntero a const
+    InternedString name;
+    InternedString date;
+
+    Race();  // Constructor predeterminado
+    Race(int raceId, int year, const Circuit* circuit, InternedString name, InternedString date);
+};
+
 #endif // RACE_HPP
\ No newline at end of file
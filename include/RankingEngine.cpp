@@ -0,0 +1,343 @@
+#include "RankingEngine.hpp"
+#include <algorithm>
+#include <iostream>
+
+RankingEngine::RankingEngine(const Dataset& data)
+    : data(data), firstYear(0), yearCount(0) {
+    const ResultsTable& results = data.results;
+    if (!results.empty()) {
+        auto bounds = minmax_element(results.year.begin(), results.year.end());
+        firstYear = *bounds.first;
+        yearCount = *bounds.second - *bounds.first + 1;
+    }
+    for (const auto& race : data.races) {
+        if (race.second.circuit) {
+            circuitOfRace[race.first] = race.second.circuit->circuitId;
+        }
+    }
+
+    allDrivers = buildTable(RankingEntity::Driver, nullopt);
+    allTeams = buildTable(RankingEntity::Constructor, nullopt);
+}
+
+void RankingEngine::Totals::add(const Totals& other) {
+    starts += other.starts;
+    points += other.points;
+    sprintPoints += other.sprintPoints;
+    wins += other.wins;
+    podiums += other.podiums;
+    finishes += other.finishes;
+    positionSum += other.positionSum;
+    seasons += other.seasons;
+}
+
+// Aportacion de una fila de resultados (sin contar la temporada); un sprint solo aporta puntos.
+// Una carrera sin clasificar (abandono, descalificacion...) es una salida con sus
+// puntos pero no una llegada; una no salida no cuenta
+RankingEngine::Totals RankingEngine::rowTotals(const ResultsTable& results, const StatusDictionary& statuses, size_t row) {
+    Totals totals;
+    if (results.session[row] == static_cast<uint8_t>(Session::Sprint)) {
+        totals.sprintPoints = results.points[row];
+        return totals;
+    }
+    int position = results.position[row];
+    if (position < 0 && statuses.outcome(results.statusId[row]) == Outcome::DidNotStart) {
+        return totals;
+    }
+    totals.starts = 1;
+    totals.points = results.points[row];
+    totals.wins = position == 1;
+    totals.podiums = position >= 1 && position <= 3;
+    if (position > 0) {
+        totals.finishes = 1;
+        totals.positionSum = position;
+    }
+    return totals;
+}
+
+// Una pasada por los resultados: totales por entidad y ano, y luego suma acumulada por ano
+RankingEngine::PrefixTable RankingEngine::buildTable(RankingEntity entity, optional<int> circuitId) const {
+    const ResultsTable& results = data.results;
+    const vector<int32_t>& ids = entity == RankingEntity::Driver ? results.driverId : results.constructorId;
+
+    auto inCircuit = [&](size_t row) {
+        if (!circuitId) {
+            return true;
+        }
+        auto it = circuitOfRace.find(results.raceId[row]);
+        return it != circuitOfRace.end() && it->second == *circuitId;
+    };
+
+    PrefixTable table;
+    map<int, size_t>& slots = table.slots;
+    for (size_t row = 0; row < results.size(); ++row) {
+        if (ids[row] >= 0 && inCircuit(row)) {
+            slots.emplace(ids[row], 0);
+        }
+    }
+    for (auto& slot : slots) {
+        slot.second = table.entityIds.size();
+        table.entityIds.push_back(slot.first);
+    }
+
+    size_t stride = static_cast<size_t>(yearCount) + 1;
+    table.prefix.assign(table.entityIds.size() * stride, Totals());
+    for (size_t row = 0; row < results.size(); ++row) {
+        if (ids[row] < 0 || !inCircuit(row)) {
+            continue;
+        }
+        Totals& cell = table.prefix[slots[ids[row]] * stride + (results.year[row] - firstYear + 1)];
+        Totals totals = rowTotals(results, data.statuses, row);
+        cell.add(totals);
+        if (totals.starts) {
+            cell.seasons = 1;
+        }
+    }
+
+    for (size_t slot = 0; slot < table.entityIds.size(); ++slot) {
+        Totals* row = &table.prefix[slot * stride];
+        for (size_t y = 1; y < stride; ++y) {
+            row[y].add(row[y - 1]);
+        }
+    }
+    return table;
+}
+
+// Suma una fila a las celdas de su ano y de los siguientes: O(anos restantes)
+void RankingEngine::addRow(PrefixTable& table, RankingEntity entity, size_t row) {
+    const ResultsTable& results = data.results;
+    int id = entity == RankingEntity::Driver ? results.driverId[row] : results.constructorId[row];
+    if (id < 0) {
+        return;
+    }
+
+    size_t stride = static_cast<size_t>(yearCount) + 1;
+    auto slot = table.slots.emplace(id, table.entityIds.size());
+    if (slot.second) {
+        table.entityIds.push_back(id);
+        table.prefix.resize(table.prefix.size() + stride);
+    }
+
+    Totals* cells = &table.prefix[slot.first->second * stride];
+    size_t y = static_cast<size_t>(results.year[row] - firstYear + 1);
+    Totals delta = rowTotals(results, data.statuses, row);
+    delta.seasons = delta.starts && cells[y].starts == cells[y - 1].starts;  // Primera carrera de la temporada
+    for (; y < stride; ++y) {
+        cells[y].add(delta);
+    }
+}
+
+// Reparte las tablas sobre un nuevo rango de anos conservando las sumas acumuladas
+void RankingEngine::resizeYears(int newFirstYear, int newLastYear) {
+    size_t oldStride = static_cast<size_t>(yearCount) + 1;
+    int newCount = newLastYear - newFirstYear + 1;
+    size_t newStride = static_cast<size_t>(newCount) + 1;
+
+    auto relayout = [&](PrefixTable& table) {
+        vector<Totals> prefix(table.entityIds.size() * newStride);
+        for (size_t slot = 0; slot < table.entityIds.size(); ++slot) {
+            for (size_t j = 1; j < newStride; ++j) {
+                // Anos anteriores al rango viejo: cero; posteriores: el ultimo acumulado
+                int oldIndex = min(max(newFirstYear + static_cast<int>(j) - firstYear, 0), yearCount);
+                prefix[slot * newStride + j] = table.prefix[slot * oldStride + oldIndex];
+            }
+        }
+        table.prefix = move(prefix);
+    };
+
+    relayout(allDrivers);
+    relayout(allTeams);
+    for (auto& entry : circuitTables) {
+        relayout(*entry.second);
+    }
+    firstYear = newFirstYear;
+    yearCount = newCount;
+}
+
+void RankingEngine::appendResults(size_t firstRow) {
+    const ResultsTable& results = data.results;
+    if (firstRow >= results.size()) {
+        return;
+    }
+
+    auto bounds = minmax_element(results.year.begin() + firstRow, results.year.end());
+    int newFirstYear = yearCount == 0 ? *bounds.first : min(firstYear, *bounds.first);
+    int newLastYear = yearCount == 0 ? *bounds.second : max(firstYear + yearCount - 1, *bounds.second);
+    if (yearCount == 0 || newFirstYear != firstYear || newLastYear != firstYear + yearCount - 1) {
+        resizeYears(newFirstYear, newLastYear);
+    }
+
+    lock_guard<mutex> lock(circuitMutex);
+    for (size_t row = firstRow; row < results.size(); ++row) {
+        int raceId = results.raceId[row];
+        auto circuit = circuitOfRace.find(raceId);
+        if (circuit == circuitOfRace.end()) {
+            auto race = data.races.find(raceId);
+            if (race != data.races.end() && race->second.circuit) {
+                circuit = circuitOfRace.emplace(raceId, race->second.circuit->circuitId).first;
+            }
+        }
+
+        addRow(allDrivers, RankingEntity::Driver, row);
+        addRow(allTeams, RankingEntity::Constructor, row);
+        if (circuit == circuitOfRace.end()) {
+            continue;
+        }
+        // Solo las tablas de circuito ya creadas; las demas se construiran con los datos nuevos
+        for (RankingEntity entity : { RankingEntity::Driver, RankingEntity::Constructor }) {
+            auto cached = circuitTables.find({ circuit->second, entity });
+            if (cached != circuitTables.end()) {
+                addRow(*cached->second, entity, row);
+            }
+        }
+    }
+}
+
+const RankingEngine::PrefixTable& RankingEngine::tableFor(RankingEntity entity, optional<int> circuitId) const {
+    if (!circuitId) {
+        return entity == RankingEntity::Driver ? allDrivers : allTeams;
+    }
+
+    lock_guard<mutex> lock(circuitMutex);
+    unique_ptr<PrefixTable>& table = circuitTables[{ *circuitId, entity }];
+    if (!table) {
+        table = make_unique<PrefixTable>(buildTable(entity, circuitId));
+    }
+    return *table;
+}
+
+RankingEngine::Totals RankingEngine::window(const PrefixTable& table, size_t slot, int startYear, int endYear) const {
+    Totals totals;
+    startYear = max(startYear, firstYear);
+    endYear = min(endYear, firstYear + yearCount - 1);
+    if (startYear > endYear) {
+        return totals;
+    }
+
+    size_t stride = static_cast<size_t>(yearCount) + 1;
+    const Totals& upper = table.prefix[slot * stride + (endYear - firstYear + 1)];
+    const Totals& lower = table.prefix[slot * stride + (startYear - firstYear)];
+    totals.starts = upper.starts - lower.starts;
+    totals.points = upper.points - lower.points;
+    totals.sprintPoints = upper.sprintPoints - lower.sprintPoints;
+    totals.wins = upper.wins - lower.wins;
+    totals.podiums = upper.podiums - lower.podiums;
+    totals.finishes = upper.finishes - lower.finishes;
+    totals.positionSum = upper.positionSum - lower.positionSum;
+    totals.seasons = upper.seasons - lower.seasons;
+    return totals;
+}
+
+bool RankingEngine::matchesNationality(RankingEntity entity, int entityId, InternedString nationality) const {
+    if (entity == RankingEntity::Driver) {
+        auto it = data.drivers.find(entityId);
+        return it != data.drivers.end() && it->second.nationality == nationality;
+    }
+    auto it = data.teams.find(entityId);
+    return it != data.teams.end() && it->second.nationality == nationality;
+}
+
+double RankingEngine::metricValue(RankingMetric metric, const Totals& totals, SessionMask sessions) {
+    int64_t points = (inSessions(sessions, static_cast<uint8_t>(Session::Race)) ? totals.points : 0)
+        + (inSessions(sessions, static_cast<uint8_t>(Session::Sprint)) ? totals.sprintPoints : 0);
+    switch (metric) {
+    case RankingMetric::AveragePoints:
+        return points / 100.0 / totals.seasons;
+    case RankingMetric::TotalPoints:
+        return points / 100.0;
+    case RankingMetric::Wins:
+        return static_cast<double>(totals.wins);
+    case RankingMetric::Podiums:
+        return static_cast<double>(totals.podiums);
+    case RankingMetric::AverageFinish:
+        return static_cast<double>(totals.positionSum) / totals.finishes;
+    case RankingMetric::PointsPerStart:
+        return points / 100.0 / totals.starts;
+    }
+    return 0.0;
+}
+
+vector<RankingEntry> RankingEngine::rank(const RankingQuery& query) const {
+    vector<RankingEntry> entries;
+    if (query.topCount == 0 || yearCount == 0) {
+        return entries;
+    }
+
+    const PrefixTable& table = tableFor(query.entity, query.circuitId);
+    for (size_t slot = 0; slot < table.entityIds.size(); ++slot) {
+        int entityId = table.entityIds[slot];
+        if (query.nationality && !matchesNationality(query.entity, entityId, *query.nationality)) {
+            continue;
+        }
+        Totals totals = window(table, slot, query.startYear, query.endYear);
+        if (totals.starts == 0 || (query.metric == RankingMetric::AverageFinish && totals.finishes == 0)) {
+            continue;
+        }
+        entries.push_back({ entityId, metricValue(query.metric, totals, query.sessions), totals.starts });
+    }
+
+    // Solo se ordenan los K primeros; los empates se resuelven por id
+    bool ascending = lowerIsBetter(query.metric);
+    auto better = [ascending](const RankingEntry& a, const RankingEntry& b) {
+        if (a.value != b.value) {
+            return ascending ? a.value < b.value : a.value > b.value;
+        }
+        return a.entityId < b.entityId;
+    };
+    if (entries.size() > query.topCount) {
+        nth_element(entries.begin(), entries.begin() + query.topCount, entries.end(), better);
+        entries.resize(query.topCount);
+    }
+    sort(entries.begin(), entries.end(), better);
+    return entries;
+}
+
+const char* RankingEngine::metricName(RankingMetric metric) {
+    switch (metric) {
+    case RankingMetric::AveragePoints: return "Puntos por temporada";
+    case RankingMetric::TotalPoints: return "Puntos totales";
+    case RankingMetric::Wins: return "Victorias";
+    case RankingMetric::Podiums: return "Podios";
+    case RankingMetric::AverageFinish: return "Posicion media de llegada";
+    case RankingMetric::PointsPerStart: return "Puntos por carrera";
+    }
+    return "";
+}
+
+const char* RankingEngine::metricKey(RankingMetric metric) {
+    switch (metric) {
+    case RankingMetric::AveragePoints: return "season-average";
+    case RankingMetric::TotalPoints: return "total";
+    case RankingMetric::Wins: return "wins";
+    case RankingMetric::Podiums: return "podiums";
+    case RankingMetric::AverageFinish: return "average-finish";
+    case RankingMetric::PointsPerStart: return "per-start";
+    }
+    return "";
+}
+
+optional<RankingMetric> RankingEngine::parseMetric(string_view key) {
+    for (RankingMetric metric : { RankingMetric::AveragePoints, RankingMetric::TotalPoints, RankingMetric::Wins,
+        RankingMetric::Podiums, RankingMetric::AverageFinish, RankingMetric::PointsPerStart }) {
+        if (key == metricKey(metric)) {
+            return metric;
+        }
+    }
+    return nullopt;
+}
+
+void RankingEngine::printRanking(const RankingQuery& query, const vector<RankingEntry>& entries) const {
+    cout << "Ranking (" << metricName(query.metric) << ", " << query.startYear << "-" << query.endYear << "):\n";
+    int rank = 1;
+    for (const RankingEntry& entry : entries) {
+        cout << rank++ << ". ";
+        if (query.entity == RankingEntity::Driver) {
+            auto it = data.drivers.find(entry.entityId);
+            cout << (it != data.drivers.end() ? it->second.fullName.str() : to_string(entry.entityId));
+        } else {
+            auto it = data.teams.find(entry.entityId);
+            cout << (it != data.teams.end() ? it->second.name.str() : to_string(entry.entityId));
+        }
+        cout << ": " << entry.value << " (" << entry.starts << " carreras)\n";
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef RANKING_ENGINE_HPP
+#define RANKING_ENGINE_HPP
+
+#include <map>
+#include <vector>
+#include <optional>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include "Dataset.hpp"
+#include "InternedString.hpp"
+
+using namespace std;
+
+enum class RankingEntity { Driver, Constructor };
+
+enum class RankingMetric {
+    AveragePoints,   // puntos por temporada disputada
+    TotalPoints,
+    Wins,
+    Podiums,
+    AverageFinish,   // posicion media de llegada (menor es mejor)
+    PointsPerStart
+};
+
+// Consulta de ranking. Los filtros vacios no restringen nada.
+struct RankingQuery {
+    RankingEntity entity = RankingEntity::Driver;
+    RankingMetric metric = RankingMetric::PointsPerStart;
+    int startYear = 0;
+    int endYear = 0;
+    size_t topCount = 5;
+    optional<int> circuitId;
+    optional<InternedString> nationality;
+    // Sesiones cuyos puntos cuentan; salidas, victorias, podios y llegadas son siempre de carrera
+    SessionMask sessions = ALL_SESSIONS;
+};
+
+struct RankingEntry {
+    int entityId;
+    double value;
+    int64_t starts;
+};
+
+// Rankings top-K sobre ventanas de anos arbitrarias.
+// Para cada piloto o equipo guarda sumas acumuladas por ano (salidas, puntos,
+// puntos de sprint, victorias, podios, llegadas, suma de posiciones y
+// temporadas), de modo que una ventana [startYear, endYear] se resuelve
+// restando dos filas: O(entidades) por consulta en lugar de recorrer los
+// resultados. Incluir o no los sprints solo cambia que sumas se leen.
+// Las tablas filtradas por circuito se construyen la primera vez que se piden.
+class RankingEngine {
+public:
+    // 'data' debe seguir vivo mientras se use el motor
+    explicit RankingEngine(const Dataset& data);
+
+    RankingEngine(const RankingEngine&) = delete;
+    RankingEngine& operator=(const RankingEngine&) = delete;
+
+    // Incorpora las filas de data.results desde firstRow (anadidas por
+    // DataManager::appendDelta) sumandolas a las tablas ya construidas, incluidas
+    // las de circuito en cache. No debe coincidir con consultas en curso.
+    void appendResults(size_t firstRow);
+
+    // Devuelve hasta query.topCount entradas, de mejor a peor
+    vector<RankingEntry> rank(const RankingQuery& query) const;
+
+    // Muestra el ranking por consola con el nombre de cada piloto o equipo
+    void printRanking(const RankingQuery& query, const vector<RankingEntry>& entries) const;
+
+    static bool lowerIsBetter(RankingMetric metric) { return metric == RankingMetric::AverageFinish; }
+    static const char* metricName(RankingMetric metric);
+    // Nombre corto de la metrica para consultas por lotes: season-average, total,
+    // wins, podiums, average-finish, per-start
+    static const char* metricKey(RankingMetric metric);
+    static optional<RankingMetric> parseMetric(string_view key);
+
+private:
+    struct Totals {
+        int64_t starts = 0;        // Tambien los abandonos; no las no salidas
+        int64_t points = 0;        // centesimas, solo carreras
+        int64_t sprintPoints = 0;  // centesimas
+        int64_t wins = 0;
+        int64_t podiums = 0;
+        int64_t finishes = 0;
+        int64_t positionSum = 0;
+        int64_t seasons = 0;
+
+        void add(const Totals& other);
+    };
+
+    // Sumas acumuladas de un tipo de entidad: fila 'slot' y ano y en
+    // prefix[slot * (yearCount + 1) + (y - firstYear + 1)]
+    struct PrefixTable {
+        vector<int> entityIds;  // slot -> id
+        map<int, size_t> slots;  // id -> slot
+        vector<Totals> prefix;
+    };
+
+    const Dataset& data;
+    int firstYear;
+    int yearCount;
+    map<int, int> circuitOfRace;
+
+    PrefixTable allDrivers;
+    PrefixTable allTeams;
+    // (circuitId, entidad) -> tabla filtrada; creada bajo demanda
+    mutable map<pair<int, RankingEntity>, unique_ptr<PrefixTable>> circuitTables;
+    mutable mutex circuitMutex;
+
+    PrefixTable buildTable(RankingEntity entity, optional<int> circuitId) const;
+    void addRow(PrefixTable& table, RankingEntity entity, size_t row);
+    void resizeYears(int newFirstYear, int newLastYear);
+    const PrefixTable& tableFor(RankingEntity entity, optional<int> circuitId) const;
+    Totals window(const PrefixTable& table, size_t slot, int startYear, int endYear) const;
+    bool matchesNationality(RankingEntity entity, int entityId, InternedString nationality) const;
+    static Totals rowTotals(const ResultsTable& results, const StatusDictionary& statuses, size_t row);
+    static double metricValue(RankingMetric metric, const Totals& totals, SessionMask sessions);
+};
+
+#endif // RANKING_ENGINE_HPP
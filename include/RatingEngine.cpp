@@ -0,0 +1,357 @@
+#include "RatingEngine.hpp"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+const double GLICKO_Q = log(10.0) / 400.0;
+
+// Puesto para ordenar: clasificados por posicion, despues los que no terminaron
+// por vueltas completadas y al final los descalificados
+int finishOrder(const ResultsTable& results, size_t row, Outcome outcome) {
+    if (results.position[row] > 0) {
+        return results.position[row];
+    }
+    if (outcome == Outcome::Disqualified) {
+        return 3000;
+    }
+    return 2000 - min(max(results.laps[row], 0), 999);
+}
+
+}
+
+string RatingSettings::key() const {
+    ostringstream key;
+    key << setprecision(17) << modelName(model) << "|" << initialRating;
+    if (model == RatingModel::Elo) {
+        key << "|" << kFactor;
+    } else {
+        key << "|" << initialDeviation << "|" << minDeviation << "|" << deviationGrowth;
+    }
+    key << "|" << (excludeMechanical ? 1 : 0);
+    return key.str();
+}
+
+optional<RatingModel> RatingSettings::parseModel(const string& name) {
+    if (name == "elo") {
+        return RatingModel::Elo;
+    }
+    if (name == "glicko") {
+        return RatingModel::Glicko;
+    }
+    return nullopt;
+}
+
+const char* RatingSettings::modelName(RatingModel model) {
+    return model == RatingModel::Elo ? "elo" : "glicko";
+}
+
+size_t RatingEngine::History::eventsAt(size_t race) const {
+    if (firstRace < 0 || race < static_cast<size_t>(firstRace)) {
+        return 0;
+    }
+    size_t offset = race - static_cast<size_t>(firstRace);
+    return offset < eventsUpTo.size() ? eventsUpTo[offset] : rating.size();
+}
+
+const RatingEngine::History* RatingEngine::Table::find(int id) const {
+    if (id < 0 || static_cast<size_t>(id) >= slotOfId.size() || slotOfId[id] < 0) {
+        return nullptr;
+    }
+    return &histories[slotOfId[id]];
+}
+
+RatingEngine::History& RatingEngine::Table::at(int id) {
+    if (static_cast<size_t>(id) >= slotOfId.size()) {
+        slotOfId.resize(static_cast<size_t>(id) + 1, -1);
+    }
+    if (slotOfId[id] < 0) {
+        slotOfId[id] = static_cast<int32_t>(histories.size());
+        ids.push_back(id);
+        histories.emplace_back();
+    }
+    return histories[slotOfId[id]];
+}
+
+RatingEngine::RatingEngine(const Dataset& data, const RatingSettings& settings) : data(data), ratingSettings(settings) {
+    indexRaces();
+    addRows(0);
+    replayFrom(0);
+}
+
+// Numeros de carrera segun racesByDate y filas de cada una, desde cero
+void RatingEngine::indexRaces() {
+    raceOrder.clear();
+    raceIndex.clear();
+    for (const Race* race : data.indexes.racesByDate) {
+        if (race->raceId >= 0 && static_cast<size_t>(race->raceId) >= raceIndex.size()) {
+            raceIndex.resize(static_cast<size_t>(race->raceId) + 1, -1);
+        }
+        if (race->raceId >= 0) {
+            raceIndex[race->raceId] = static_cast<int32_t>(raceOrder.size());
+        }
+        raceOrder.push_back(race->raceId);
+    }
+    raceRows.assign(raceOrder.size(), vector<uint32_t>());
+}
+
+// Reparte las filas de carrera desde firstRow entre sus carreras
+void RatingEngine::addRows(size_t firstRow) {
+    const ResultsTable& results = data.results;
+    for (size_t row = firstRow; row < results.size(); ++row) {
+        int raceId = results.raceId[row];
+        if (results.session[row] == static_cast<uint8_t>(Session::Race)
+            && raceId >= 0 && static_cast<size_t>(raceId) < raceIndex.size() && raceIndex[raceId] >= 0) {
+            raceRows[raceIndex[raceId]].push_back(static_cast<uint32_t>(row));
+        }
+    }
+}
+
+void RatingEngine::appendResults(size_t firstRow) {
+    const vector<const Race*>& races = data.indexes.racesByDate;
+    size_t common = 0;
+    while (common < raceOrder.size() && common < races.size() && races[common]->raceId == raceOrder[common]) {
+        ++common;
+    }
+
+    size_t start = processed;
+    if (common < raceOrder.size()) {
+        // Una carrera nueva cae antes de otras ya puntuadas: cambian los numeros de carrera
+        indexRaces();
+        addRows(0);
+        start = common;
+    } else {
+        for (size_t i = raceOrder.size(); i < races.size(); ++i) {
+            int raceId = races[i]->raceId;
+            if (raceId >= 0 && static_cast<size_t>(raceId) >= raceIndex.size()) {
+                raceIndex.resize(static_cast<size_t>(raceId) + 1, -1);
+            }
+            if (raceId >= 0) {
+                raceIndex[raceId] = static_cast<int32_t>(i);
+            }
+            raceOrder.push_back(raceId);
+        }
+        raceRows.resize(raceOrder.size());
+        // Filas nuevas de carreras ya puntuadas (p. ej. resultados que llegan tarde)
+        const ResultsTable& results = data.results;
+        for (size_t row = firstRow; row < results.size(); ++row) {
+            int raceId = results.raceId[row];
+            if (raceId >= 0 && static_cast<size_t>(raceId) < raceIndex.size() && raceIndex[raceId] >= 0) {
+                start = min(start, static_cast<size_t>(raceIndex[raceId]));
+            }
+        }
+        addRows(firstRow);
+    }
+
+    if (start < processed) {
+        rewind(start);
+    }
+    replayFrom(processed);
+}
+
+// Olvida las carreras desde 'race' en todos los historiales
+void RatingEngine::rewind(size_t race) {
+    for (Table* table : { &drivers, &teams }) {
+        for (History& history : table->histories) {
+            if (history.firstRace < 0) {
+                continue;
+            }
+            if (static_cast<size_t>(history.firstRace) >= race) {
+                history = History();
+                continue;
+            }
+            size_t kept = race - static_cast<size_t>(history.firstRace);
+            if (kept >= history.eventsUpTo.size()) {
+                continue;
+            }
+            history.eventsUpTo.resize(kept);
+            // La ultima posicion tiene que ser una carrera corrida
+            while (history.eventsUpTo.size() > 1 && history.eventsUpTo.back() == history.eventsUpTo[history.eventsUpTo.size() - 2]) {
+                history.eventsUpTo.pop_back();
+            }
+            history.rating.resize(history.eventsUpTo.back());
+            history.deviation.resize(history.eventsUpTo.back());
+        }
+    }
+    processed = race;
+}
+
+void RatingEngine::replayFrom(size_t race) {
+    replayed = 0;
+    for (size_t i = race; i < raceOrder.size(); ++i) {
+        rateRace(i);
+        ++replayed;
+    }
+    processed = raceOrder.size();
+}
+
+void RatingEngine::rateRace(size_t race) {
+    const ResultsTable& results = data.results;
+    vector<Entrant> driverEntrants;
+    vector<Entrant> teamEntrants;
+    for (uint32_t row : raceRows[race]) {
+        Outcome outcome = data.statuses.outcome(results.statusId[row]);
+        if (outcome == Outcome::DidNotStart) {
+            continue;
+        }
+        int order = finishOrder(results, row, outcome);
+        if (results.driverId[row] >= 0 && !(ratingSettings.excludeMechanical && outcome == Outcome::Mechanical)) {
+            driverEntrants.push_back({ results.driverId[row], order });
+        }
+        if (results.constructorId[row] >= 0) {
+            teamEntrants.push_back({ results.constructorId[row], order });
+        }
+    }
+    rate(drivers, driverEntrants, race);
+    rate(teams, teamEntrants, race);
+}
+
+// Todos contra todos con las puntuaciones previas a la carrera; despues se
+// guardan las nuevas a la vez
+void RatingEngine::rate(Table& table, vector<Entrant>& entrants, size_t race) {
+    // Una entrada por id con su mejor puesto (equipos con varios coches, pilotos que compartieron coche)
+    sort(entrants.begin(), entrants.end(), [](const Entrant& a, const Entrant& b) {
+        return a.id != b.id ? a.id < b.id : a.order < b.order;
+    });
+    entrants.erase(unique(entrants.begin(), entrants.end(), [](const Entrant& a, const Entrant& b) { return a.id == b.id; }),
+        entrants.end());
+    size_t count = entrants.size();
+    if (count < 2) {
+        return;
+    }
+
+    const RatingSettings& settings = ratingSettings;
+    bool glicko = settings.model == RatingModel::Glicko;
+    vector<double> rating(count), deviation(count), scale(count);
+    for (size_t i = 0; i < count; ++i) {
+        const History& history = table.at(entrants[i].id);
+        if (history.rating.empty()) {
+            rating[i] = settings.initialRating;
+            deviation[i] = settings.initialDeviation;
+        } else {
+            rating[i] = history.rating.back();
+            double idle = static_cast<double>(race - history.lastRace());
+            deviation[i] = min(sqrt(static_cast<double>(history.deviation.back()) * history.deviation.back()
+                + settings.deviationGrowth * settings.deviationGrowth * idle), settings.initialDeviation);
+        }
+        // g(RD) de Glicko; con Elo todos los duelos pesan igual
+        scale[i] = glicko ? 1.0 / sqrt(1.0 + 3.0 * GLICKO_Q * GLICKO_Q * deviation[i] * deviation[i] / (PI * PI)) : 1.0;
+    }
+
+    double weight = 1.0 / static_cast<double>(count - 1);
+    vector<double> newRating(count), newDeviation(count, 0.0);
+    for (size_t i = 0; i < count; ++i) {
+        double surprise = 0.0;     // Suma de g (s - E)
+        double information = 0.0;  // Suma de g^2 E (1 - E)
+        for (size_t j = 0; j < count; ++j) {
+            if (i == j) {
+                continue;
+            }
+            double expected = 1.0 / (1.0 + pow(10.0, -scale[j] * (rating[i] - rating[j]) / 400.0));
+            double score = entrants[i].order < entrants[j].order ? 1.0 : entrants[i].order == entrants[j].order ? 0.5 : 0.0;
+            surprise += weight * scale[j] * (score - expected);
+            information += weight * scale[j] * scale[j] * expected * (1.0 - expected);
+        }
+        if (glicko) {
+            double variance = 1.0 / (1.0 / (deviation[i] * deviation[i]) + GLICKO_Q * GLICKO_Q * information);
+            newRating[i] = rating[i] + GLICKO_Q * variance * surprise;
+            newDeviation[i] = max(sqrt(variance), settings.minDeviation);
+        } else {
+            newRating[i] = rating[i] + settings.kFactor * surprise;
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        History& history = table.at(entrants[i].id);
+        if (history.firstRace < 0) {
+            history.firstRace = static_cast<int32_t>(race);
+        }
+        uint16_t events = static_cast<uint16_t>(history.rating.size());
+        history.eventsUpTo.resize(race - static_cast<size_t>(history.firstRace), events);
+        history.eventsUpTo.push_back(static_cast<uint16_t>(events + 1));
+        history.rating.push_back(static_cast<float>(newRating[i]));
+        history.deviation.push_back(static_cast<float>(newDeviation[i]));
+    }
+}
+
+optional<Rating> RatingEngine::ratingAt(RankingEntity entity, int id, size_t race) const {
+    const History* history = tableFor(entity).find(id);
+    size_t events = history ? history->eventsAt(race) : 0;
+    if (events == 0) {
+        return nullopt;
+    }
+    return Rating{ history->rating[events - 1], history->deviation[events - 1], events };
+}
+
+optional<double> RatingEngine::peak(RankingEntity entity, int id, size_t firstRace, size_t lastRace) const {
+    const History* history = tableFor(entity).find(id);
+    if (!history || lastRace < firstRace) {
+        return nullopt;
+    }
+    size_t from = firstRace > 0 ? history->eventsAt(firstRace - 1) : 0;
+    size_t to = history->eventsAt(lastRace);
+    if (from >= to) {
+        return nullopt;
+    }
+    return *max_element(history->rating.begin() + from, history->rating.begin() + to);
+}
+
+vector<RatedEntry> RatingEngine::top(RankingEntity entity, size_t firstRace, size_t race, size_t count) const {
+    const Table& table = tableFor(entity);
+    vector<RatedEntry> entries;
+    for (size_t slot = 0; slot < table.histories.size(); ++slot) {
+        const History& history = table.histories[slot];
+        size_t events = history.eventsAt(race);
+        size_t before = firstRace > 0 ? history.eventsAt(firstRace - 1) : 0;
+        if (events > before) {
+            entries.push_back({ table.ids[slot], { history.rating[events - 1], history.deviation[events - 1], events } });
+        }
+    }
+    auto better = [](const RatedEntry& a, const RatedEntry& b) {
+        return a.rating.rating != b.rating.rating ? a.rating.rating > b.rating.rating : a.entityId < b.entityId;
+    };
+    if (entries.size() > count) {
+        partial_sort(entries.begin(), entries.begin() + count, entries.end(), better);
+        entries.resize(count);
+    } else {
+        sort(entries.begin(), entries.end(), better);
+    }
+    return entries;
+}
+
+RatingEngineSet::RatingEngineSet(const Dataset& data) : data(data) {
+    RatingSettings defaults;
+    engines[defaults.key()] = make_unique<RatingEngine>(data, defaults);
+}
+
+const RatingEngine* RatingEngineSet::get(const RatingSettings& settings) {
+    string key = settings.key();
+    {
+        lock_guard<mutex> lock(enginesMutex);
+        auto found = engines.find(key);
+        if (found != engines.end()) {
+            return found->second.get();
+        }
+        if (engines.size() >= MAX_ENGINES) {
+            return nullptr;
+        }
+    }
+    // Se construye sin bloquear: las consultas con otros parametros no esperan
+    unique_ptr<RatingEngine> built = make_unique<RatingEngine>(data, settings);
+    lock_guard<mutex> lock(enginesMutex);
+    unique_ptr<RatingEngine>& engine = engines[key];
+    if (!engine) {
+        engine = move(built);
+    }
+    return engine.get();
+}
+
+void RatingEngineSet::appendResults(size_t firstRow) {
+    lock_guard<mutex> lock(enginesMutex);
+    for (auto& entry : engines) {
+        entry.second->appendResults(firstRow);
+    }
+}
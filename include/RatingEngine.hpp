@@ -0,0 +1,155 @@
+#ifndef RATING_ENGINE_HPP
+#define RATING_ENGINE_HPP
+
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+#include "Dataset.hpp"
+#include "RankingEngine.hpp"
+
+using namespace std;
+
+enum class RatingModel { Elo, Glicko };
+
+struct RatingSettings {
+    RatingModel model = RatingModel::Glicko;
+    double initialRating = 1500.0;
+    double kFactor = 32.0;             // Elo: cambio maximo por carrera
+    double initialDeviation = 350.0;   // Glicko: desviacion de un debutante (y maxima)
+    double minDeviation = 30.0;
+    double deviationGrowth = 15.0;     // Glicko: c, la desviacion crece sqrt(RD^2 + c^2 t) tras t carreras
+    bool excludeMechanical = true;     // Las averias no cuentan para el piloto (si para el equipo)
+
+    // Texto con los valores que cambian el resultado (clave de cache)
+    string key() const;
+
+    static optional<RatingModel> parseModel(const string& name);  // elo, glicko
+    static const char* modelName(RatingModel model);
+};
+
+struct Rating {
+    double rating;
+    double deviation;  // 0 con Elo
+    size_t races;      // Carreras puntuadas hasta ese momento
+};
+
+struct RatedEntry {
+    int entityId;
+    Rating rating;
+};
+
+// Puntuaciones tipo Elo/Glicko de pilotos y equipos a partir del orden de
+// llegada de cada carrera (todos contra todos; cada carrera cuenta como una
+// partida, asi que cada duelo pesa 1 / (rivales)). Los equipos se comparan por
+// su mejor coche. Los no clasificados quedan detras de los clasificados,
+// ordenados por vueltas; los que no salieron no cuentan.
+//
+// Las carreras se procesan en el orden de indexes.racesByDate y el indice en
+// ese vector es el "numero de carrera". Cada entidad guarda sus puntuaciones
+// tras cada carrera en la que corrio (float) y, para cada carrera desde su
+// debut hasta la ultima, cuantas lleva: la puntuacion "tras la carrera N" es
+// una lectura directa, sin buscar.
+class RatingEngine {
+public:
+    // 'data' debe seguir vivo mientras se use el motor
+    explicit RatingEngine(const Dataset& data, const RatingSettings& settings = RatingSettings());
+
+    RatingEngine(const RatingEngine&) = delete;
+    RatingEngine& operator=(const RatingEngine&) = delete;
+
+    // Incorpora las filas de data.results desde firstRow y las carreras nuevas
+    // (DataManager::appendDelta). Solo se recalcula desde la primera carrera
+    // afectada: si el delta trae carreras posteriores, solo esas. No debe
+    // coincidir con consultas en curso.
+    void appendResults(size_t firstRow);
+
+    const RatingSettings& settings() const { return ratingSettings; }
+    size_t raceCount() const { return raceOrder.size(); }
+    // Carreras procesadas desde la ultima reconstruccion (completa o parcial)
+    size_t replayedRaces() const { return replayed; }
+
+    // Puntuacion tras la carrera 'race' (indice de racesByDate); nullopt si aun no habia corrido
+    optional<Rating> ratingAt(RankingEntity entity, int id, size_t race) const;
+
+    // Mejor puntuacion tras alguna de las carreras [firstRace, lastRace]; nullopt si no corrio en ellas
+    optional<double> peak(RankingEntity entity, int id, size_t firstRace, size_t lastRace) const;
+
+    // Las 'count' mejores puntuaciones tras la carrera 'race' entre quienes
+    // corrieron en [firstRace, race], de mayor a menor
+    vector<RatedEntry> top(RankingEntity entity, size_t firstRace, size_t race, size_t count) const;
+
+private:
+    // Historial de una entidad: rating/deviation tras cada carrera en la que
+    // corrio; eventsUpTo[i] = carreras corridas hasta firstRace + i (incluida)
+    struct History {
+        int32_t firstRace = -1;
+        vector<uint16_t> eventsUpTo;
+        vector<float> rating;
+        vector<float> deviation;
+
+        size_t eventsAt(size_t race) const;
+        size_t lastRace() const { return static_cast<size_t>(firstRace) + eventsUpTo.size() - 1; }
+    };
+
+    struct Table {
+        vector<int32_t> slotOfId;  // id -> slot (-1 si no hay)
+        vector<int> ids;
+        vector<History> histories;
+
+        const History* find(int id) const;
+        History& at(int id);
+    };
+
+    // Participante de una carrera; menor 'order' es mejor
+    struct Entrant {
+        int id;
+        int order;
+    };
+
+    const Dataset& data;
+    RatingSettings ratingSettings;
+    Table drivers;
+    Table teams;
+    vector<int> raceOrder;               // Numero de carrera -> raceId
+    vector<int32_t> raceIndex;           // raceId -> numero de carrera (-1 si no hay)
+    vector<vector<uint32_t>> raceRows;   // Numero de carrera -> filas de carrera de ResultsTable
+    size_t processed = 0;                // Carreras ya puntuadas
+    size_t replayed = 0;
+
+    const Table& tableFor(RankingEntity entity) const { return entity == RankingEntity::Driver ? drivers : teams; }
+    void indexRaces();
+    void addRows(size_t firstRow);
+    void rewind(size_t race);
+    void replayFrom(size_t race);
+    void rateRace(size_t race);
+    void rate(Table& table, vector<Entrant>& entrants, size_t race);
+};
+
+// Motores compartidos entre hilos, uno por RatingSettings::key(). El de los
+// parametros por defecto se construye con el conjunto; los demas, la primera
+// vez que se piden, hasta MAX_ENGINES.
+class RatingEngineSet {
+public:
+    static const size_t MAX_ENGINES = 16;
+
+    // 'data' debe seguir vivo mientras se use el conjunto
+    explicit RatingEngineSet(const Dataset& data);
+
+    // Motor con esos parametros; nullptr si no estaba y ya hay MAX_ENGINES
+    const RatingEngine* get(const RatingSettings& settings);
+
+    // RatingEngine::appendResults en todos los motores; no debe coincidir con consultas en curso
+    void appendResults(size_t firstRow);
+
+private:
+    const Dataset& data;
+    mutex enginesMutex;
+    map<string, unique_ptr<RatingEngine>> engines;  // Clave: RatingSettings::key()
+};
+
+#endif // RATING_ENGINE_HPP
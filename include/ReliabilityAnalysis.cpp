@@ -0,0 +1,103 @@
+#include "ReliabilityAnalysis.hpp"
+#include <algorithm>
+
+void OutcomeCounts::add(Outcome outcome) {
+    ++counts[static_cast<size_t>(outcome)];
+    if (outcome != Outcome::DidNotStart) {
+        ++starts;
+    }
+}
+
+void OutcomeCounts::merge(const OutcomeCounts& other) {
+    starts += other.starts;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+}
+
+ReliabilityAnalysis::ReliabilityAnalysis(const ResultsTable& results, const StatusDictionary& statuses,
+    const map<int, Race>& races) : results(results), statuses(statuses) {
+    if (!races.empty()) {
+        circuitOfRace.assign(static_cast<size_t>(max(0, races.rbegin()->first)) + 1, -1);
+    }
+    for (const auto& entry : races) {
+        if (entry.first >= 0 && entry.second.circuit) {
+            circuitOfRace[entry.first] = entry.second.circuit->circuitId;
+        }
+    }
+}
+
+// Filas de carrera dentro del rango de anos
+bool ReliabilityAnalysis::counts(size_t row, int startYear, int endYear) const {
+    int year = results.year[row];
+    return results.session[row] == static_cast<uint8_t>(Session::Race)
+        && (!startYear || year >= startYear) && (!endYear || year <= endYear);
+}
+
+vector<GroupReliability> ReliabilityAnalysis::compute(ReliabilityGroup group, int startYear, int endYear) const {
+    // Los ids de grupo son densos y pequenos: un acumulador por id
+    vector<OutcomeCounts> groups;
+    vector<bool> seen;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (!counts(i, startYear, endYear)) {
+            continue;
+        }
+        int groupId = 0;
+        switch (group) {
+        case ReliabilityGroup::All: groupId = 0; break;
+        case ReliabilityGroup::Constructor: groupId = results.constructorId[i]; break;
+        case ReliabilityGroup::Driver: groupId = results.driverId[i]; break;
+        case ReliabilityGroup::Season: groupId = results.year[i]; break;
+        case ReliabilityGroup::Circuit: {
+            int raceId = results.raceId[i];
+            groupId = raceId >= 0 && static_cast<size_t>(raceId) < circuitOfRace.size() ? circuitOfRace[raceId] : -1;
+            break;
+        }
+        }
+        if (groupId < 0) {
+            continue;
+        }
+        if (static_cast<size_t>(groupId) >= groups.size()) {
+            groups.resize(static_cast<size_t>(groupId) + 1);
+            seen.resize(static_cast<size_t>(groupId) + 1, false);
+        }
+        groups[groupId].add(statuses.outcome(results.statusId[i]));
+        seen[groupId] = true;
+    }
+
+    vector<GroupReliability> reliability;
+    for (size_t groupId = 0; groupId < groups.size(); ++groupId) {
+        if (seen[groupId]) {
+            reliability.push_back({ static_cast<int>(groupId), groups[groupId] });
+        }
+    }
+    return reliability;
+}
+
+OutcomeCounts ReliabilityAnalysis::overall(int startYear, int endYear) const {
+    vector<GroupReliability> all = compute(ReliabilityGroup::All, startYear, endYear);
+    return all.empty() ? OutcomeCounts() : all.front().outcomes;
+}
+
+vector<StatusCount> ReliabilityAnalysis::causes(int startYear, int endYear, int constructorId) const {
+    vector<size_t> perStatus(statuses.size(), 0);
+    for (size_t i = 0; i < results.size(); ++i) {
+        int statusId = results.statusId[i];
+        if (counts(i, startYear, endYear) && statuses.contains(statusId)
+            && (constructorId < 0 || results.constructorId[i] == constructorId)) {
+            ++perStatus[statusId];
+        }
+    }
+
+    vector<StatusCount> causes;
+    for (size_t statusId = 0; statusId < perStatus.size(); ++statusId) {
+        Outcome outcome = statuses.outcome(static_cast<int>(statusId));
+        if (perStatus[statusId] && outcome != Outcome::Finished) {
+            causes.push_back({ static_cast<int>(statusId), outcome, perStatus[statusId] });
+        }
+    }
+    sort(causes.begin(), causes.end(), [](const StatusCount& a, const StatusCount& b) {
+        return a.count != b.count ? a.count > b.count : a.statusId < b.statusId;
+    });
+    return causes;
+}
@@ -0,0 +1,70 @@
+#ifndef RELIABILITY_ANALYSIS_HPP
+#define RELIABILITY_ANALYSIS_HPP
+
+#include <map>
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include "Race.hpp"
+#include "ResultsTable.hpp"
+#include "StatusDictionary.hpp"
+
+using namespace std;
+
+// Recuento de participaciones por clase de estado. Las de DidNotStart se
+// cuentan pero no son salidas, asi que no entran en las tasas.
+struct OutcomeCounts {
+    size_t starts = 0;
+    array<size_t, StatusDictionary::OUTCOME_COUNT> counts{};
+
+    size_t count(Outcome outcome) const { return counts[static_cast<size_t>(outcome)]; }
+    void add(Outcome outcome);
+    void merge(const OutcomeCounts& other);
+
+    double rate(Outcome outcome) const { return starts ? static_cast<double>(count(outcome)) / starts : 0.0; }
+    double finishRate() const { return rate(Outcome::Finished); }
+    double failureRate() const { return rate(Outcome::Mechanical); }  // Averias por salida
+    double attrition() const { return starts ? 1.0 - finishRate() : 0.0; }  // Salidas que no terminaron
+};
+
+enum class ReliabilityGroup { All, Constructor, Driver, Season, Circuit };
+
+struct GroupReliability {
+    int groupId;  // constructorId, driverId, ano o circuitId; 0 con ReliabilityGroup::All
+    OutcomeCounts outcomes;
+};
+
+// Veces que se repite un estado (causa de abandono)
+struct StatusCount {
+    int statusId;
+    Outcome outcome;
+    size_t count;
+};
+
+// Fiabilidad y abandonos por grupos en una sola pasada sobre las columnas
+// statusId, year, raceId, driverId y constructorId de ResultsTable, sin copiar
+// filas. Solo cuentan las carreras: los abandonos del sprint no se registran
+// con la misma causa en todas las temporadas.
+class ReliabilityAnalysis {
+public:
+    ReliabilityAnalysis(const ResultsTable& results, const StatusDictionary& statuses, const map<int, Race>& races = {});
+
+    // Un elemento por grupo con participaciones en [startYear, endYear] (0 = sin limite), en orden de id
+    vector<GroupReliability> compute(ReliabilityGroup group, int startYear = 0, int endYear = 0) const;
+
+    // Todas las participaciones juntas
+    OutcomeCounts overall(int startYear = 0, int endYear = 0) const;
+
+    // Estados que no son 'Finished' de mas a menos frecuente; constructorId < 0 = todos los equipos
+    vector<StatusCount> causes(int startYear = 0, int endYear = 0, int constructorId = -1) const;
+
+private:
+    const ResultsTable& results;
+    const StatusDictionary& statuses;
+    vector<int32_t> circuitOfRace;  // raceId -> circuitId (-1 si no hay)
+
+    bool counts(size_t row, int startYear, int endYear) const;
+};
+
+#endif // RELIABILITY_ANALYSIS_HPP
@@ -1,158 +1,200 @@
-#include "ResultsPredictor.hpp"
-#include <iostream>
-#include <algorithm>
-#include <cmath> // Necesario para log y max
-#include <numeric>
-#include <vector>
-
-using namespace std;
-
-void ResultsPredictor::predictResults(const map<int, Driver>& drivers, const map<int, DriverStandings>& standings, const map<int, Race>& races, const string& circuitName) {
-    vector<string> driverNames;
-    string inputName;
-    cout << "Ingrese los nombres de los conductores (escriba 'fin' para terminar):" << endl;
-    while (true) {
-        getline(cin, inputName);
-        if (inputName == "fin") {
-            break;
-        }
-        driverNames.push_back(inputName);
-    }
-
-    map<int, pair<double, double>> driverPoints;
-    for (const auto& entry : standings) {
-        const DriverStandings& ds = entry.second;
-        if (!ds.driver || !ds.race || find(driverNames.begin(), driverNames.end(), ds.driver->fullName) == driverNames.end()) {
-            continue;
-        }
-
-        // Filtra por circuito si se proporciona un nombre de circuito
-        if (!circuitName.empty() && (!ds.race->circuit || ds.race->circuit->name != circuitName)) {
-            continue;
-        }
-
-        int currentYear = 2023;
-        double yearsSinceRace = currentYear - ds.race->year + 1;
-        double weight = 1.0 / max(1.0, log(yearsSinceRace));  // Uso de logaritmo para suavizar la penalización
-        driverPoints[ds.driver->driverId].first += ds.points * weight;
-        driverPoints[ds.driver->driverId].second += weight;
-    }
-
-    vector<pair<double, int>> weightedAverages;
-    for (const auto& dp : driverPoints) {
-        if (dp.second.second > 0) {
-            double average = dp.second.first / dp.second.second;
-            weightedAverages.push_back(make_pair(average, dp.first));
-        }
-    }
-
-    sort(weightedAverages.rbegin(), weightedAverages.rend());
-
-    cout << "Pronóstico de resultados basado en el desempeño pasado" << (circuitName.empty() ? "" : " para el circuito '" + circuitName + "'") << ":" << endl;
-    for (const auto& wa : weightedAverages) {
-        cout << "Conductor ID " << wa.second << " (" << drivers.at(wa.second).fullName << "): " << wa.first << " puntos" << endl;
-    }
-}
-
-void ResultsPredictor::predictTeamResults(const map<int, Team>& teams, const map<int, TeamStandings>& standings, const map<int, Race>& races, const string& circuitName) {
-    vector<string> teamNames;
-    string inputName;
-    cout << "Ingrese los nombres de los equipos (escriba 'fin' para terminar):" << endl;
-    while (true) {
-        getline(cin, inputName);
-        if (inputName == "fin") {
-            break;
-        }
-        teamNames.push_back(inputName);
-    }
-
-    map<int, pair<double, double>> teamPoints; // teamId -> (suma ponderada de puntos, suma de pesos)
-    for (const auto& entry : standings) {
-        const TeamStandings& ts = entry.second;
-        if (!ts.team || !ts.race || find(teamNames.begin(), teamNames.end(), ts.team->name) == teamNames.end()) {
-            continue;
-        }
-
-        // Filtra por circuito si se proporciona un nombre de circuito
-        if (!circuitName.empty() && (!ts.race->circuit || ts.race->circuit->name != circuitName)) {
-            continue;
-        }
-
-        int currentYear = 2023;
-        double yearsSinceRace = currentYear - ts.race->year + 1;
-        double weight = 1.0 / max(1.0, log(yearsSinceRace)); // Uso de logaritmo para suavizar la penalización
-        teamPoints[ts.team->teamId].first += ts.points * weight;
-        teamPoints[ts.team->teamId].second += weight;
-    }
-
-    vector<pair<double, int>> weightedAverages;
-    for (const auto& tp : teamPoints) {
-        if (tp.second.second > 0) {
-            double average = tp.second.first / tp.second.second;
-            weightedAverages.push_back(make_pair(average, tp.first));
-        }
-    }
-
-    sort(weightedAverages.rbegin(), weightedAverages.rend());
-
-    cout << "Pronóstico de resultados para equipos" << (circuitName.empty() ? "" : " para el circuito '" + circuitName + "'") << ":" << endl;
-    for (const auto& wa : weightedAverages) {
-        cout << "Equipo ID " << wa.second << " (" << teams.at(wa.second).name << "): " << wa.first << " puntos" << endl;
-    }
-}
-
-double ResultsPredictor::calculatePearsonCorrelation(const vector<int>& x, const vector<int>& y) {
-    int n = x.size();
-    double sum_x = accumulate(x.begin(), x.end(), 0.0);
-    double sum_y = accumulate(y.begin(), y.end(), 0.0);
-    double sum_x2 = inner_product(x.begin(), x.end(), x.begin(), 0.0);
-    double sum_y2 = inner_product(y.begin(), y.end(), y.begin(), 0.0);
-    double sum_xy = inner_product(x.begin(), x.end(), y.begin(), 0.0);
-
-    double numerator = n * sum_xy - sum_x * sum_y;
-    double denominator = sqrt((n * sum_x2 - sum_x * sum_x) * (n * sum_y2 - sum_y * sum_y));
-
-    return (denominator == 0) ? 0 : numerator / denominator;
-}
-
-void ResultsPredictor::calculateStartPositionImpact(const map<int, ResultsInfo_driver>& driverResults, const map<int, ResultsInfo_team>& teamResults) {
-    vector<int> startPositions;
-    vector<int> finalPositions;
-
-    // Procesar resultados de conductores
-    for (const auto& entry : driverResults) {
-        const ResultsInfo_driver& info = entry.second;
-        if (info.getDriver() && info.getRace()) {
-            startPositions.push_back(info.getGrid());
-            finalPositions.push_back(info.getPosition());
-        }
-    }
-
-    // Procesar resultados de equipos
-    for (const auto& entry : teamResults) {
-        const ResultsInfo_team& info = entry.second;
-        if (info.getTeam() && info.getRace()) {
-            startPositions.push_back(info.getGrid());
-            finalPositions.push_back(info.getPosition());
-        }
-    }
-
-    double correlation = calculatePearsonCorrelation(startPositions, finalPositions);
-    cout << "Pearson Correlation: " << correlation << endl;
-    if (correlation > 0.5) {
-        cout << "Strong positive correlation: Better start position strongly indicates better final position." << endl;
-    }
-    else if (correlation > 0.2) {
-        cout << "Moderate positive correlation: Better start position somewhat indicates better final position." << endl;
-    }
-    else if (correlation > -0.2) {
-        cout << "Weak or no correlation: Start position has little effect on final position." << endl;
-    }
-    else if (correlation > -0.5) {
-        cout << "Moderate negative correlation: Better start position somewhat indicates worse final position." << endl;
-    }
-    else {
-        cout << "Strong negative correlation: Better start position strongly indicates worse final position." << endl;
-    }
-
+#include "ResultsPredictor.hpp"
+#include "CorrelationEngine.hpp"
+#include <iostream>
+#include <algorithm>
+#include <cmath> // Necesario para log y max
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Lee nombres de cin hasta "fin"
+vector<string> readNames() {
+    vector<string> names;
+    string inputName;
+    while (true) {
+        getline(cin, inputName);
+        if (inputName == "fin") {
+            break;
+        }
+        names.push_back(inputName);
+    }
+    return names;
+}
+
+// Conjunto de ids como mapa de bits (los ids de Ergast son densos y pequenos)
+vector<bool> idSet(const vector<int>& ids) {
+    vector<bool> bits;
+    for (int id : ids) {
+        if (id >= 0) {
+            if (static_cast<size_t>(id) >= bits.size()) {
+                bits.resize(id + 1);
+            }
+            bits[id] = true;
+        }
+    }
+    return bits;
+}
+
+bool contains(const vector<bool>& bits, int id) {
+    return id >= 0 && static_cast<size_t>(id) < bits.size() && bits[id];
+}
+
+// Suma ponderada de las filas de 'id' en unas columnas, solo las del circuito si se pide uno
+void accumulateColumns(const StandingsColumns& columns, int id, const vector<bool>* circuitSet, const vector<double>& weights,
+    double& weightedValue, double& totalWeight) {
+    pair<size_t, size_t> rows = columns.rowsOf(id);
+    if (!circuitSet) {
+        PredictionKernel::accumulate(columns.points.data() + rows.first, columns.yearSlots.data() + rows.first,
+            rows.second - rows.first, weights.data(), weightedValue, totalWeight);
+        return;
+    }
+
+    vector<double> filteredPoints;
+    vector<int32_t> filteredSlots;
+    for (size_t row = rows.first; row < rows.second; ++row) {
+        if (contains(*circuitSet, columns.circuitIds[row])) {
+            filteredPoints.push_back(columns.points[row]);
+            filteredSlots.push_back(columns.yearSlots[row]);
+        }
+    }
+    PredictionKernel::accumulate(filteredPoints.data(), filteredSlots.data(), filteredPoints.size(), weights.data(),
+        weightedValue, totalWeight);
+}
+
+// Media ponderada de puntos de cada entidad pedida, de mayor a menor.
+// Los nombres y el circuito se resuelven a ids una sola vez con el indice de
+// nombres; el peso de cada ano sale de una tabla y las sumas se hacen con
+// PredictionKernel sobre las columnas de clasificaciones. Con qualifyingWeight,
+// la media se corrige con la distancia a la pole (columnas 'pace'); las
+// entidades sin tiempos de clasificacion se quedan con sus puntos. Con
+// reliabilityWeight se penaliza la tasa de averias (columnas 'reliability').
+template <typename FindIds>
+vector<pair<double, int>> weightedPrediction(const StandingsColumns& columns, const StandingsColumns& pace,
+    const StandingsColumns& reliability, const DataIndexes& indexes, const vector<string>& names, const string& circuitName, const PredictionSettings& settings,
+    FindIds findIds) {
+    vector<int> wanted;
+    for (const string& name : names) {
+        vector<int> ids = findIds(name);
+        wanted.insert(wanted.end(), ids.begin(), ids.end());
+    }
+    vector<bool> wantedSet = idSet(wanted);
+    vector<bool> circuitSet = idSet(indexes.names.findCircuits(circuitName));
+    const vector<bool>* circuitFilter = circuitName.empty() ? nullptr : &circuitSet;
+    vector<double> weights = PredictionKernel::buildWeightTable(settings, columns.firstYear, columns.lastYear);
+
+    // El ritmo y la fiabilidad usan el mismo ano de referencia que los puntos aunque sus columnas empiecen mas tarde
+    auto correctionWeights = [&](const StandingsColumns& correction, double factor) {
+        if (factor <= 0) {
+            return vector<double>();
+        }
+        PredictionSettings correctionSettings = settings;
+        if (correctionSettings.referenceYear <= 0) {
+            correctionSettings.referenceYear = columns.lastYear;
+        }
+        return PredictionKernel::buildWeightTable(correctionSettings, correction.firstYear, correction.lastYear);
+    };
+    vector<double> paceWeights = correctionWeights(pace, settings.qualifyingWeight);
+    vector<double> reliabilityWeights = correctionWeights(reliability, settings.reliabilityWeight);
+
+    vector<pair<double, int>> weightedAverages;
+    for (size_t id = 0; id < wantedSet.size(); ++id) {
+        if (!wantedSet[id]) {
+            continue;
+        }
+        double weightedPoints = 0.0;
+        double totalWeight = 0.0;
+        accumulateColumns(columns, static_cast<int>(id), circuitFilter, weights, weightedPoints, totalWeight);
+        if (totalWeight <= 0) {
+            continue;
+        }
+        double average = weightedPoints / totalWeight;
+
+        if (!paceWeights.empty()) {
+            double weightedGap = 0.0;
+            double gapWeight = 0.0;
+            accumulateColumns(pace, static_cast<int>(id), circuitFilter, paceWeights, weightedGap, gapWeight);
+            if (gapWeight > 0) {
+                average *= exp(-settings.qualifyingWeight * weightedGap / gapWeight);
+            }
+        }
+        if (!reliabilityWeights.empty()) {
+            double weightedFailures = 0.0;
+            double startWeight = 0.0;
+            accumulateColumns(reliability, static_cast<int>(id), circuitFilter, reliabilityWeights, weightedFailures, startWeight);
+            if (startWeight > 0) {
+                average *= pow(1.0 - weightedFailures / startWeight, settings.reliabilityWeight);
+            }
+        }
+        weightedAverages.push_back(make_pair(average, static_cast<int>(id)));
+    }
+
+    sort(weightedAverages.rbegin(), weightedAverages.rend());
+    return weightedAverages;
+}
+
+}
+
+vector<pair<double, int>> ResultsPredictor::calculateDriverPrediction(const DataIndexes& indexes,
+    const vector<string>& driverNames, const string& circuitName) {
+    return weightedPrediction(indexes.driverStandingColumns, indexes.driverQualifyingColumns, indexes.driverReliabilityColumns, indexes, driverNames, circuitName, settings,
+        [&](const string& name) { return indexes.names.findDrivers(name); });
+}
+
+vector<pair<double, int>> ResultsPredictor::calculateTeamPrediction(const DataIndexes& indexes,
+    const vector<string>& teamNames, const string& circuitName) {
+    return weightedPrediction(indexes.teamStandingColumns, indexes.teamQualifyingColumns, indexes.teamReliabilityColumns, indexes, teamNames, circuitName, settings,
+        [&](const string& name) { return indexes.names.findTeams(name); });
+}
+
+void ResultsPredictor::predictResults(const map<int, Driver>& drivers, const DataIndexes& indexes, const string& circuitName) {
+    cout << "Ingrese los nombres de los conductores (escriba 'fin' para terminar):" << endl;
+    vector<string> driverNames = readNames();
+    vector<pair<double, int>> weightedAverages = calculateDriverPrediction(indexes, driverNames, circuitName);
+
+    cout << "Pronóstico de resultados basado en el desempeño pasado" << (circuitName.empty() ? "" : " para el circuito '" + circuitName + "'") << ":" << endl;
+    for (const auto& wa : weightedAverages) {
+        cout << "Conductor ID " << wa.second << " (" << drivers.at(wa.second).fullName << "): " << wa.first << " puntos" << endl;
+    }
+}
+
+void ResultsPredictor::predictTeamResults(const map<int, Team>& teams, const DataIndexes& indexes, const string& circuitName) {
+    cout << "Ingrese los nombres de los equipos (escriba 'fin' para terminar):" << endl;
+    vector<string> teamNames = readNames();
+    vector<pair<double, int>> weightedAverages = calculateTeamPrediction(indexes, teamNames, circuitName);
+
+    cout << "Pronóstico de resultados para equipos" << (circuitName.empty() ? "" : " para el circuito '" + circuitName + "'") << ":" << endl;
+    for (const auto& wa : weightedAverages) {
+        cout << "Equipo ID " << wa.second << " (" << teams.at(wa.second).name << "): " << wa.first << " puntos" << endl;
+    }
+}
+
+double ResultsPredictor::calculateStartPositionCorrelation(const ResultsTable& results) {
+    // Correlacion global de siempre: todas las filas, incluidas las salidas desde el pit lane (grid 0)
+    CorrelationOptions options;
+    options.includePitLaneStarts = true;
+    options.ranks = false;
+    return CorrelationEngine(results).overall(options).stats.pearson();
+}
+
+void ResultsPredictor::calculateStartPositionImpact(const ResultsTable& results) {
+    double correlation = calculateStartPositionCorrelation(results);
+    cout << "Pearson Correlation: " << correlation << endl;
+    if (correlation > 0.5) {
+        cout << "Strong positive correlation: Better start position strongly indicates better final position." << endl;
+    }
+    else if (correlation > 0.2) {
+        cout << "Moderate positive correlation: Better start position somewhat indicates better final position." << endl;
+    }
+    else if (correlation > -0.2) {
+        cout << "Weak or no correlation: Start position has little effect on final position." << endl;
+    }
+    else if (correlation > -0.5) {
+        cout << "Moderate negative correlation: Better start position somewhat indicates worse final position." << endl;
+    }
+    else {
+        cout << "Strong negative correlation: Better start position strongly indicates worse final position." << endl;
+    }
+
 }
\ No newline at end of file
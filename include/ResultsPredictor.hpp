@@ -1,27 +1,37 @@
-#ifndef RESULTS_PREDICTOR_HPP
-#define RESULTS_PREDICTOR_HPP
-
-#include <string>
-#include <map>
-#include <vector>
-#include "Driver.hpp"
-#include "DriverStandings.hpp"
-#include "Race.hpp"
-#include "Team.hpp"
-#include "TeamStandings.hpp"
-#include "ResultsInfo_driver.hpp"
-#include "ResultsInfo_team.hpp"
-
-using namespace std;
-
-class ResultsPredictor {
-private:
-    double calculatePearsonCorrelation(const vector<int>& x, const vector<int>& y);
-    
-public:
-    void predictResults(const map<int, Driver>& drivers, const map<int, DriverStandings>& standings, const map<int, Race>& races, const string& circuitName = "");
-    void predictTeamResults(const map<int, Team>& teams, const map<int, TeamStandings>& standings, const map<int, Race>& races, const string& circuitName = "");
-    void calculateStartPositionImpact(const map<int, ResultsInfo_driver>& driverResults, const map<int, ResultsInfo_team>& teamResults);
-};
-
+#ifndef RESULTS_PREDICTOR_HPP
+#define RESULTS_PREDICTOR_HPP
+
+#include <string>
+#include <map>
+#include <vector>
+#include "Driver.hpp"
+#include "DriverStandings.hpp"
+#include "Race.hpp"
+#include "Team.hpp"
+#include "TeamStandings.hpp"
+#include "ResultsTable.hpp"
+#include "DataIndexes.hpp"
+#include "PredictionKernel.hpp"
+
+using namespace std;
+
+class ResultsPredictor {
+public:
+    // Funcion de peso y ano de referencia de las predicciones
+    PredictionSettings settings;
+
+    void predictResults(const map<int, Driver>& drivers, const DataIndexes& indexes, const string& circuitName = "");
+    void predictTeamResults(const map<int, Team>& teams, const DataIndexes& indexes, const string& circuitName = "");
+    void calculateStartPositionImpact(const ResultsTable& results);
+
+    // Versiones sin entrada/salida por consola (modo por lotes).
+    // Los nombres se buscan en indexes.names (sin distinguir mayusculas ni acentos).
+    // Devuelven pares (puntos ponderados, id) de mayor a menor.
+    vector<pair<double, int>> calculateDriverPrediction(const DataIndexes& indexes,
+        const vector<string>& driverNames, const string& circuitName = "");
+    vector<pair<double, int>> calculateTeamPrediction(const DataIndexes& indexes,
+        const vector<string>& teamNames, const string& circuitName = "");
+    double calculateStartPositionCorrelation(const ResultsTable& results);
+};
+
 #endif // RESULTS_PREDICTOR_HPP
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "ResultsTable.hpp"
+
+void ResultsTable::reserve(size_t rows) {
+    resultId.reserve(rows);
+    raceId.reserve(rows);
+    driverId.reserve(rows);
+    constructorId.reserve(rows);
+    grid.reserve(rows);
+    position.reserve(rows);
+    points.reserve(rows);
+    year.reserve(rows);
+    laps.reserve(rows);
+    milliseconds.reserve(rows);
+    fastestLap.reserve(rows);
+    fastestLapMs.reserve(rows);
+    statusId.reserve(rows);
+    session.reserve(rows);
+}
+
+void ResultsTable::resize(size_t rows) {
+    resultId.resize(rows);
+    raceId.resize(rows);
+    driverId.resize(rows);
+    constructorId.resize(rows);
+    grid.resize(rows);
+    position.resize(rows);
+    points.resize(rows);
+    year.resize(rows);
+    laps.resize(rows);
+    milliseconds.resize(rows);
+    fastestLap.resize(rows);
+    fastestLapMs.resize(rows);
+    statusId.resize(rows);
+    session.resize(rows);
+}
+
+void ResultsTable::copyRow(size_t from, size_t to) {
+    resultId[to] = resultId[from];
+    raceId[to] = raceId[from];
+    driverId[to] = driverId[from];
+    constructorId[to] = constructorId[from];
+    grid[to] = grid[from];
+    position[to] = position[from];
+    points[to] = points[from];
+    year[to] = year[from];
+    laps[to] = laps[from];
+    milliseconds[to] = milliseconds[from];
+    fastestLap[to] = fastestLap[from];
+    fastestLapMs[to] = fastestLapMs[from];
+    statusId[to] = statusId[from];
+    session[to] = session[from];
+}
+
+void ResultsTable::appendRows(const ResultsTable& other) {
+    resultId.insert(resultId.end(), other.resultId.begin(), other.resultId.end());
+    raceId.insert(raceId.end(), other.raceId.begin(), other.raceId.end());
+    driverId.insert(driverId.end(), other.driverId.begin(), other.driverId.end());
+    constructorId.insert(constructorId.end(), other.constructorId.begin(), other.constructorId.end());
+    grid.insert(grid.end(), other.grid.begin(), other.grid.end());
+    position.insert(position.end(), other.position.begin(), other.position.end());
+    points.insert(points.end(), other.points.begin(), other.points.end());
+    year.insert(year.end(), other.year.begin(), other.year.end());
+    laps.insert(laps.end(), other.laps.begin(), other.laps.end());
+    milliseconds.insert(milliseconds.end(), other.milliseconds.begin(), other.milliseconds.end());
+    fastestLap.insert(fastestLap.end(), other.fastestLap.begin(), other.fastestLap.end());
+    fastestLapMs.insert(fastestLapMs.end(), other.fastestLapMs.begin(), other.fastestLapMs.end());
+    statusId.insert(statusId.end(), other.statusId.begin(), other.statusId.end());
+    session.insert(session.end(), other.session.begin(), other.session.end());
+}
+
+// Anade una fila al final de todas las columnas
+void ResultsTable::append(int resultId, int raceId, int driverId, int constructorId, int grid, int position, int pointsHundredths,
+    int year, int laps, int milliseconds, int fastestLap, int fastestLapMs, int statusId, Session session) {
+    this->resultId.push_back(resultId);
+    this->raceId.push_back(raceId);
+    this->driverId.push_back(driverId);
+    this->constructorId.push_back(constructorId);
+    this->grid.push_back(grid);
+    this->position.push_back(position);
+    this->points.push_back(pointsHundredths);
+    this->year.push_back(year);
+    this->laps.push_back(laps);
+    this->milliseconds.push_back(milliseconds);
+    this->fastestLap.push_back(fastestLap);
+    this->fastestLapMs.push_back(fastestLapMs);
+    this->statusId.push_back(statusId);
+    this->session.push_back(static_cast<uint8_t>(session));
+}
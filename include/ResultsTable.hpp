@@ -0,0 +1,100 @@
+#ifndef RESULTS_TABLE_HPP
+#define RESULTS_TABLE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// Sesion a la que pertenece cada fila de resultados
+enum class Session : uint8_t { Race = 0, Sprint = 1 };
+
+// Conjunto de sesiones que incluye una consulta: un bit por Session
+using SessionMask = uint8_t;
+const SessionMask RACE_SESSIONS = 1 << static_cast<int>(Session::Race);
+const SessionMask SPRINT_SESSIONS = 1 << static_cast<int>(Session::Sprint);
+const SessionMask ALL_SESSIONS = RACE_SESSIONS | SPRINT_SESSIONS;
+
+inline bool inSessions(SessionMask sessions, uint8_t session) { return (sessions >> session) & 1; }
+
+// Tabla de resultados en formato columnar (struct-of-arrays).
+// Cada columna es un vector contiguo de int32_t, de modo que los recorridos
+// solo leen las columnas que usan. El ano de la carrera se desnormaliza al
+// cargar para no tener que seguir punteros a Race.
+// Las carreras y los sprints comparten la tabla; la columna 'session' los
+// distingue, de modo que una consulta filtra por sesion en la misma pasada.
+// Un piloto tiene como mucho una fila por (carrera, sesion).
+class ResultsTable {
+public:
+    vector<int32_t> resultId;
+    vector<int32_t> raceId;
+    vector<int32_t> driverId;
+    vector<int32_t> constructorId;
+    vector<int32_t> grid;
+    vector<int32_t> position;      // -1 si no se clasifico (\N: retirada, descalificacion, no salida)
+    vector<int32_t> points;        // centesimas de punto (coma fija): 4.5 -> 450
+    vector<int32_t> year;
+    vector<int32_t> laps;
+    vector<int32_t> milliseconds;  // -1 si no hay tiempo (\N)
+    vector<int32_t> fastestLap;    // -1 si no hay vuelta rapida (\N)
+    vector<int32_t> fastestLapMs;  // Tiempo de la vuelta rapida; -1 si no hay
+    vector<int32_t> statusId;      // Codigo de StatusDictionary (status.csv)
+    vector<uint8_t> session;       // Session
+
+    // Vista ligera de una fila; conserva los accesores de los antiguos ResultsInfo_driver/ResultsInfo_team
+    class Row {
+    public:
+        Row(const ResultsTable* table, size_t index) : table(table), index(index) {}
+
+        size_t getIndex() const { return index; }
+        int getResultId() const { return table->resultId[index]; }
+        int getRaceId() const { return table->raceId[index]; }
+        int getDriverId() const { return table->driverId[index]; }
+        int getConstructorId() const { return table->constructorId[index]; }
+        int getGrid() const { return table->grid[index]; }
+        int getPosition() const { return table->position[index]; }
+        double getPoints() const { return table->points[index] / 100.0; }
+        int getYear() const { return table->year[index]; }
+        int getLaps() const { return table->laps[index]; }
+        int getMilliseconds() const { return table->milliseconds[index]; }
+        int getFastestLap() const { return table->fastestLap[index]; }
+        int getFastestLapMs() const { return table->fastestLapMs[index]; }
+        int getStatusId() const { return table->statusId[index]; }
+        Session getSession() const { return static_cast<Session>(table->session[index]); }
+
+    private:
+        const ResultsTable* table;
+        size_t index;
+    };
+
+    class const_iterator {
+    public:
+        const_iterator(const ResultsTable* table, size_t index) : table(table), index(index) {}
+        Row operator*() const { return Row(table, index); }
+        const_iterator& operator++() { ++index; return *this; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+
+    private:
+        const ResultsTable* table;
+        size_t index;
+    };
+
+    size_t size() const { return resultId.size(); }
+    bool empty() const { return resultId.empty(); }
+    Row operator[](size_t index) const { return Row(this, index); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    void reserve(size_t rows);
+    void resize(size_t rows);
+    // Copia la fila 'from' sobre la fila 'to' (para compactar la tabla)
+    void copyRow(size_t from, size_t to);
+    // Anade al final todas las filas de otra tabla
+    void appendRows(const ResultsTable& other);
+    void append(int resultId, int raceId, int driverId, int constructorId, int grid, int position, int pointsHundredths,
+        int year, int laps, int milliseconds, int fastestLap, int fastestLapMs, int statusId, Session session = Session::Race);
+};
+
+#endif // RESULTS_TABLE_HPP
@@ -0,0 +1,56 @@
+#include "StatusDictionary.hpp"
+
+void StatusDictionary::add(int statusId, InternedString name) {
+    if (statusId < 0) {
+        return;
+    }
+    if (static_cast<size_t>(statusId) >= names.size()) {
+        names.resize(static_cast<size_t>(statusId) + 1);
+        outcomes.resize(static_cast<size_t>(statusId) + 1, static_cast<uint8_t>(Outcome::Other));
+    }
+    names[statusId] = name;
+    outcomes[statusId] = static_cast<uint8_t>(classify(name.str()));
+}
+
+// Los textos de status.csv son un conjunto cerrado (unos 140); lo que no esta
+// en ninguna lista y no es una retirada generica se considera averia
+Outcome StatusDictionary::classify(string_view status) {
+    if (status == "Finished" || (status.size() > 1 && status[0] == '+')) {
+        return Outcome::Finished;
+    }
+    for (string_view text : { "Disqualified", "Excluded", "Underweight" }) {
+        if (status == text) {
+            return Outcome::Disqualified;
+        }
+    }
+    for (string_view text : { "Accident", "Collision", "Collision damage", "Spun off", "Fatal accident", "Damage",
+                              "Debris", "Front wing", "Broken wing", "Puncture", "Tyre puncture" }) {
+        if (status == text) {
+            return Outcome::Accident;
+        }
+    }
+    for (string_view text : { "Did not qualify", "Did not prequalify", "107% Rule", "Withdrew" }) {
+        if (status == text) {
+            return Outcome::DidNotStart;
+        }
+    }
+    for (string_view text : { "Retired", "Not classified", "Not restarted", "Physical", "Injured", "Injury",
+                              "Eye injury", "Illness", "Driver unwell", "Safety", "Safety concerns" }) {
+        if (status == text) {
+            return Outcome::Other;
+        }
+    }
+    return status.empty() ? Outcome::Other : Outcome::Mechanical;
+}
+
+const char* StatusDictionary::outcomeName(Outcome outcome) {
+    switch (outcome) {
+    case Outcome::Finished: return "finished";
+    case Outcome::Mechanical: return "mechanical";
+    case Outcome::Accident: return "accident";
+    case Outcome::Disqualified: return "disqualified";
+    case Outcome::DidNotStart: return "did-not-start";
+    case Outcome::Other: return "other";
+    }
+    return "";
+}
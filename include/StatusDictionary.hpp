@@ -0,0 +1,48 @@
+#ifndef STATUS_DICTIONARY_HPP
+#define STATUS_DICTIONARY_HPP
+
+#include <vector>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include "InternedString.hpp"
+
+using namespace std;
+
+// Como acabo una participacion, segun su estado
+enum class Outcome : uint8_t {
+    Finished,      // "Finished" o "+N Laps"
+    Mechanical,    // Averias del coche (motor, caja, frenos, neumaticos...)
+    Accident,      // Accidentes, toques y danos
+    Disqualified,  // Descalificado o excluido
+    DidNotStart,   // No se clasifico, se retiro antes de salir...
+    Other          // Retirada sin causa, motivos fisicos o estado desconocido
+};
+
+// Diccionario de status.csv: la columna statusId de ResultsTable es el codigo
+// y aqui estan el texto y la clase de cada uno, en vectores indexados por
+// statusId (los ids son densos y pequenos), para clasificar una fila con una
+// sola lectura.
+class StatusDictionary {
+public:
+    static const size_t OUTCOME_COUNT = 6;
+
+    vector<InternedString> names;  // statusId -> texto (vacio si no existe)
+    vector<uint8_t> outcomes;      // statusId -> Outcome
+
+    size_t size() const { return names.size(); }
+    bool contains(int statusId) const { return statusId >= 0 && static_cast<size_t>(statusId) < size() && !names[statusId].empty(); }
+
+    Outcome outcome(int statusId) const {
+        return statusId >= 0 && static_cast<size_t>(statusId) < outcomes.size() ? static_cast<Outcome>(outcomes[statusId]) : Outcome::Other;
+    }
+    InternedString name(int statusId) const { return contains(statusId) ? names[statusId] : InternedString(); }
+
+    // Anade o sustituye un estado; la clase sale del texto
+    void add(int statusId, InternedString name);
+
+    static Outcome classify(string_view status);
+    static const char* outcomeName(Outcome outcome);  // finished, mechanical, accident...
+};
+
+#endif // STATUS_DICTIONARY_HPP
@@ -1,39 +1,97 @@
-#include "StrategyRecommendation.hpp"
-
-using namespace std;
-
-string StrategyRecommendation::recommendPitStops(const string& weather, int laps, double circuitLength) {
-    // Ejemplo de lógica: Asumir más paradas en condiciones de lluvia
-    if (weather == "rainy") {
-        return to_string(laps / 20 + 1) + " pit stops are recommended due to wet conditions.";
-    } else {
-        return to_string(laps / 30 + 1) + " pit stops are recommended.";
-    }
-}
-
-string StrategyRecommendation::recommendTireType(const string& weather, int laps) {
-    // Decidir sobre el tipo de neumático según el clima
-    if (weather == "rainy") {
-        return "Wet tires are recommended.";
-    } else if (weather == "hot") {
-        return "Soft tires are recommended for better grip.";
-    } else {
-        return "Hard tires are recommended for durability.";
-    }
-}
-
-string StrategyRecommendation::recommendFuelStrategy(int laps, double circuitLength, const string& weather) {
-    double fuelPerLap = 2.4; // Consumo estimado de combustible por vuelta en kg
-    double fuelNeeded = laps * fuelPerLap;
-    return "Estimated fuel needed: " + to_string(fuelNeeded) + " kg.";
-}
-
-string StrategyRecommendation::recommendCarSetup(const string& circuitType, const string& weather) {
-    if (circuitType == "highDownforce" && weather == "rainy") {
-        return "Increase downforce and use full wets.";
-    } else if (circuitType == "highSpeed") {
-        return "Decrease downforce for better top speed.";
-    } else {
-        return "Standard setup recommended.";
-    }
+#include "StrategyRecommendation.hpp"
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+string StrategyRecommendation::recommendPitStops(const string& weather, int laps, double circuitLength,
+    const CircuitPitProfile* history) {
+    if (history && history->typicalStops > 0) {
+        // Las vueltas historicas se escalan a la distancia pedida
+        double scale = history->raceLaps > 0 ? static_cast<double>(laps) / history->raceLaps : 1.0;
+        auto scaled = [&](int lap) { return max(1, min(laps, static_cast<int>(lap * scale + 0.5))); };
+
+        int stops = history->typicalStops + (weather == "rainy" ? 1 : 0);
+        ostringstream text;
+        text << stops << " pit stops are recommended"
+             << (weather == "rainy" ? " due to wet conditions" : "")
+             << " (typical at this circuit: " << history->typicalStops << ", over " << history->entries
+             << " drivers in " << history->races << " races).";
+
+        text << "\nStop laps: ";
+        for (int stop = 0; stop < stops; ++stop) {
+            // Sin historico para esa parada, se reparte el resto de la carrera a partes iguales
+            int lap = static_cast<size_t>(stop) < history->stopLaps.size()
+                ? scaled(history->stopLaps[stop].medianLap)
+                : laps * (stop + 1) / (stops + 1);
+            text << (stop ? ", " : "") << "around lap " << lap;
+        }
+        text << ".";
+
+        if (history->undercutStart > 0) {
+            text << "\nUndercut window: laps " << scaled(history->undercutStart) << "-" << scaled(history->undercutEnd) << ".";
+        }
+        if (history->medianSeconds > 0) {
+            text << "\nTypical pit lane time: " << fixed << setprecision(1) << history->medianSeconds << " s.";
+        }
+        return text.str();
+    }
+
+    // Ejemplo de lógica: Asumir más paradas en condiciones de lluvia
+    if (weather == "rainy") {
+        return to_string(laps / 20 + 1) + " pit stops are recommended due to wet conditions.";
+    } else {
+        return to_string(laps / 30 + 1) + " pit stops are recommended.";
+    }
+}
+
+string StrategyRecommendation::recommendStrategy(const string& weather, int laps, double circuitLength,
+    const CircuitPitProfile* history, const SimulationSettings& settings) {
+    RaceModel model = RaceModel::build(laps, circuitLength, weather, history);
+    StrategySimulator simulator(model);
+    vector<StrategyResult> results = simulator.run(settings);
+    if (results.empty()) {
+        return "No valid strategy for " + to_string(laps) + " laps (" + simulator.emptyReason(settings) + ").";
+    }
+
+    ostringstream text;
+    text << fixed << setprecision(1)
+         << settings.runs << " simulated races (lap " << model.lapSeconds << " s, pit loss " << model.pitLossSeconds
+         << " s, safety car " << static_cast<int>(model.safetyCarRate * 100 + 0.5) << "%; expected time [95% CI]):";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const StrategyResult& result = results[i];
+        // Tiempo esperado con el intervalo de confianza del 95% de la media
+        text << "\n" << i + 1 << ". " << StrategySimulator::describe(result.strategy)
+             << ": " << result.meanSeconds << " s [" << result.lowerSeconds << ", " << result.upperSeconds << "]"
+             << " (+" << result.meanSeconds - results.front().meanSeconds << " s, sd " << result.stdDevSeconds << " s)";
+    }
+    return text.str();
+}
+
+string StrategyRecommendation::recommendTireType(const string& weather, int laps) {
+    // Decidir sobre el tipo de neumático según el clima
+    if (weather == "rainy") {
+        return "Wet tires are recommended.";
+    } else if (weather == "hot") {
+        return "Soft tires are recommended for better grip.";
+    } else {
+        return "Hard tires are recommended for durability.";
+    }
+}
+
+string StrategyRecommendation::recommendFuelStrategy(int laps, double circuitLength, const string& weather) {
+    double fuelPerLap = 2.4; // Consumo estimado de combustible por vuelta en kg
+    double fuelNeeded = laps * fuelPerLap;
+    return "Estimated fuel needed: " + to_string(fuelNeeded) + " kg.";
+}
+
+string StrategyRecommendation::recommendCarSetup(const string& circuitType, const string& weather) {
+    if (circuitType == "highDownforce" && weather == "rainy") {
+        return "Increase downforce and use full wets.";
+    } else if (circuitType == "highSpeed") {
+        return "Decrease downforce for better top speed.";
+    } else {
+        return "Standard setup recommended.";
+    }
 }
\ No newline at end of file
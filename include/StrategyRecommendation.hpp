@@ -1,16 +1,25 @@
-#ifndef STRATEGY_RECOMMENDATION_HPP
-#define STRATEGY_RECOMMENDATION_HPP
-
-#include <string>
-
-using namespace std;
-
-class StrategyRecommendation {
-public:
-    string recommendPitStops(const string& weather, int laps, double circuitLength);
-    string recommendTireType(const string& weather, int laps);
-    string recommendFuelStrategy(int laps, double circuitLength, const string& weather);
-    string recommendCarSetup(const string& circuitType, const string& weather);
-};
-
+#ifndef STRATEGY_RECOMMENDATION_HPP
+#define STRATEGY_RECOMMENDATION_HPP
+
+#include <string>
+#include "PitStopAnalysis.hpp"
+#include "StrategySimulator.hpp"
+
+using namespace std;
+
+class StrategyRecommendation {
+public:
+    // Con 'history' (perfil del circuito en pit_stops.csv) la recomendacion sale del
+    // historico: numero tipico de paradas, vueltas de cada parada escaladas a 'laps'
+    // y ventana de undercut. Sin historico se usa la regla general.
+    string recommendPitStops(const string& weather, int laps, double circuitLength,
+        const CircuitPitProfile* history = nullptr);
+    // Mejores estrategias de neumaticos segun la simulacion Monte Carlo (StrategySimulator)
+    string recommendStrategy(const string& weather, int laps, double circuitLength,
+        const CircuitPitProfile* history = nullptr, const SimulationSettings& settings = SimulationSettings());
+    string recommendTireType(const string& weather, int laps);
+    string recommendFuelStrategy(int laps, double circuitLength, const string& weather);
+    string recommendCarSetup(const string& circuitType, const string& weather);
+};
+
 #endif // STRATEGY_RECOMMENDATION_HPP
\ No newline at end of file
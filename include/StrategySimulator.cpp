@@ -0,0 +1,416 @@
+#include "StrategySimulator.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+
+// Modelo de cada compuesto: ritmo respecto al blando (s/vuelta), desgaste
+// (s por vuelta de antiguedad), vida util en vueltas y caida a partir de ella
+struct TyreModel {
+    Compound compound;
+    const char* name;
+    double paceOffset;
+    double wear;
+    int life;
+    double cliff;
+};
+
+const TyreModel TYRES[] = {
+    { Compound::Soft, "S", 0.00, 0.080, 20, 0.20 },
+    { Compound::Medium, "M", 0.45, 0.050, 30, 0.15 },
+    { Compound::Hard, "H", 0.85, 0.030, 42, 0.12 },
+    { Compound::Intermediate, "I", 0.00, 0.060, 30, 0.15 },
+    { Compound::Wet, "W", 0.90, 0.035, 40, 0.12 },
+};
+
+const TyreModel& tyre(Compound compound) {
+    return TYRES[static_cast<size_t>(compound)];
+}
+
+const double FUEL_GAIN = 0.03;        // s/vuelta que se gana por cada vuelta de combustible gastado
+const double WEAR_SPREAD = 0.12;      // Desviacion del desgaste entre carreras
+const double LAP_NOISE = 0.35;        // Desviacion del ritmo por vuelta
+const double SAFETY_CAR_SLOWDOWN = 0.4;  // Una vuelta neutralizada es un 40% mas lenta
+const double SAFETY_CAR_PIT_SAVING = 0.5;  // Parar neutralizado cuesta la mitad
+const double PIT_NOISE = 0.5;         // Desviacion de la duracion de una parada
+const double SLOW_STOP_RATE = 0.04;   // Paradas con problemas: 2-8 s mas
+const size_t RUN_BLOCK = 4096;        // Escenarios por bloque (y por generador)
+
+// xoshiro256** sembrado con splitmix64: rapido y reproducible en cualquier plataforma
+class RandomStream {
+public:
+    explicit RandomStream(uint64_t seed) {
+        for (uint64_t& word : state) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotate(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotate(state[3], 45);
+        return result;
+    }
+
+    // Uniforme en [0, 1)
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // Normal estandar (Box-Muller)
+    double normal() {
+        if (hasSpare) {
+            hasSpare = false;
+            return spare;
+        }
+        double radius = sqrt(-2.0 * log(1.0 - uniform()));
+        double angle = 6.283185307179586 * uniform();
+        spare = radius * sin(angle);
+        hasSpare = true;
+        return radius * cos(angle);
+    }
+
+private:
+    uint64_t state[4];
+    double spare = 0.0;
+    bool hasSpare = false;
+
+    static uint64_t rotate(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+bool isWet(const string& weather) {
+    return weather == "rainy" || weather == "lluvioso";
+}
+
+}
+
+RaceModel RaceModel::build(int laps, double circuitLength, const string& weather, const CircuitPitProfile* history) {
+    RaceModel model;
+    model.laps = laps;
+    model.lapSeconds = circuitLength > 0 ? circuitLength / 200.0 * 3600.0 : 90.0;
+    if (history) {
+        if (history->lapSeconds > 0) {
+            model.lapSeconds = history->lapSeconds;
+        }
+        if (history->medianSeconds > 0) {
+            model.pitLossSeconds = history->medianSeconds;
+        }
+        if (history->races > 0) {
+            model.safetyCarRate = history->safetyCarRate;
+        }
+    }
+    model.wet = isWet(weather);
+    if (model.wet) {
+        model.lapSeconds *= 1.12;
+    }
+    model.wearScale = model.lapSeconds / 90.0;
+    return model;
+}
+
+StrategySimulator::StrategySimulator(const RaceModel& model) : model(model) {}
+
+const char* StrategySimulator::compoundName(Compound compound) {
+    return tyre(compound).name;
+}
+
+string StrategySimulator::describe(const Strategy& strategy) {
+    string text;
+    for (const Stint& stint : strategy.stints) {
+        text += (text.empty() ? "" : " - ") + string(compoundName(stint.compound)) + " " + to_string(stint.laps);
+    }
+    return text;
+}
+
+vector<Compound> StrategySimulator::allowedCompounds() const {
+    return model.wet
+        ? vector<Compound>{ Compound::Intermediate, Compound::Wet }
+        : vector<Compound>{ Compound::Soft, Compound::Medium, Compound::Hard };
+}
+
+// Limites de una tanda, recortados a la distancia de la carrera
+int StrategySimulator::minStintLaps(const SimulationSettings& settings) const {
+    return max(1, min(settings.minStint, model.laps));
+}
+
+int StrategySimulator::maxStintLaps(Compound compound) const {
+    return min(static_cast<int>(tyre(compound).life / model.wearScale * 1.5), model.laps);
+}
+
+vector<Strategy> StrategySimulator::enumerateStrategies(const SimulationSettings& settings) const {
+    vector<Compound> allowed = allowedCompounds();
+    int lapStep = max(1, settings.lapStep);
+    int minStint = minStintLaps(settings);
+    auto maxStint = [&](Compound compound) { return maxStintLaps(compound); };
+
+    vector<Strategy> strategies;
+    vector<Stint> stints;
+    // Reparte las vueltas restantes entre las tandas de 'compounds' desde 'index'
+    auto extend = [&](auto& self, const vector<Compound>& compounds, size_t index, int lapsDone) -> void {
+        Compound compound = compounds[index];
+        if (index + 1 == compounds.size()) {
+            int remaining = model.laps - lapsDone;
+            if (remaining >= minStint && remaining <= maxStint(compound)) {
+                stints.push_back({ compound, remaining });
+                strategies.push_back({ stints });
+                stints.pop_back();
+            }
+            return;
+        }
+        int lastPit = min(lapsDone + maxStint(compound), model.laps - minStint);
+        for (int pit = lapsDone + minStint; pit <= lastPit; ++pit) {
+            if (pit % lapStep != 0) {
+                continue;
+            }
+            stints.push_back({ compound, pit - lapsDone });
+            self(self, compounds, index + 1, pit);
+            stints.pop_back();
+        }
+    };
+
+    // En seco sin sitio para una parada (carrera mas corta que dos tandas) se admite no parar
+    bool stopFits = model.laps >= 2 * minStint;
+    for (int stops = model.wet || !stopFits ? 0 : 1; stops <= settings.maxStops; ++stops) {
+        // Todas las secuencias de compuestos de stops + 1 tandas
+        vector<size_t> digits(static_cast<size_t>(stops) + 1, 0);
+        while (true) {
+            vector<Compound> compounds;
+            for (size_t digit : digits) {
+                compounds.push_back(allowed[digit]);
+            }
+            // En seco el reglamento obliga a usar al menos dos compuestos
+            bool valid = model.wet || stops == 0 || any_of(compounds.begin(), compounds.end(),
+                [&](Compound c) { return c != compounds.front(); });
+            if (valid) {
+                extend(extend, compounds, 0, 0);
+            }
+
+            size_t position = 0;
+            while (position < digits.size() && ++digits[position] == allowed.size()) {
+                digits[position++] = 0;
+            }
+            if (position == digits.size()) {
+                break;
+            }
+        }
+    }
+    return strategies;
+}
+
+StrategySimulator::Scenarios StrategySimulator::generateScenarios(const SimulationSettings& settings, size_t stopsPerRun) const {
+    Scenarios scenarios;
+    size_t runs = settings.runs;
+    scenarios.stopsPerRun = stopsPerRun;
+    scenarios.wearFactor.resize(runs);
+    scenarios.paceNoise.resize(runs);
+    scenarios.safetyCarStart.resize(runs);
+    scenarios.safetyCarEnd.resize(runs);
+    scenarios.pitNoise.resize(runs * stopsPerRun);
+
+    // Un generador por bloque, derivado de la semilla y del numero de bloque
+    auto generateBlock = [&](size_t block) {
+        RandomStream random(settings.seed ^ (0xD1B54A32D192ED03ULL * (block + 1)));
+        size_t end = min(runs, (block + 1) * RUN_BLOCK);
+        for (size_t run = block * RUN_BLOCK; run < end; ++run) {
+            scenarios.wearFactor[run] = max(0.5, 1.0 + WEAR_SPREAD * random.normal());
+            double pace = LAP_NOISE * sqrt(static_cast<double>(model.laps)) * random.normal();
+
+            scenarios.safetyCarStart[run] = 0;
+            scenarios.safetyCarEnd[run] = 0;
+            if (model.laps >= 4 && random.uniform() < model.safetyCarRate) {
+                int start = 2 + static_cast<int>(random.uniform() * (model.laps - 3));
+                int length = 3 + static_cast<int>(random.uniform() * 3);
+                scenarios.safetyCarStart[run] = start;
+                scenarios.safetyCarEnd[run] = min(model.laps, start + length);
+                pace += (scenarios.safetyCarEnd[run] - start) * model.lapSeconds * SAFETY_CAR_SLOWDOWN;
+            }
+            scenarios.paceNoise[run] = pace;
+
+            for (size_t stop = 0; stop < stopsPerRun; ++stop) {
+                double noise = PIT_NOISE * random.normal();
+                if (random.uniform() < SLOW_STOP_RATE) {
+                    noise += 2.0 + 6.0 * random.uniform();
+                }
+                scenarios.pitNoise[run * stopsPerRun + stop] = noise;
+            }
+        }
+    };
+
+    ThreadPool pool(settings.threads == 0 ? thread::hardware_concurrency() : settings.threads);
+    vector<future<void>> blocks;
+    for (size_t block = 0; block * RUN_BLOCK < runs; ++block) {
+        blocks.push_back(pool.submit([&, block]() { generateBlock(block); }));
+    }
+    for (auto& block : blocks) {
+        block.get();
+    }
+    return scenarios;
+}
+
+// Parte fija del tiempo de una tanda (ritmo del compuesto)
+double StrategySimulator::stintSeconds(const Stint& stint) const {
+    return stint.laps * tyre(stint.compound).paceOffset;
+}
+
+// Desgaste acumulado de una tanda en forma cerrada: lineal con la antiguedad
+// (0..laps-1) y cuadratico pasada la vida util
+double StrategySimulator::stintWearSeconds(const Stint& stint) const {
+    const TyreModel& model = tyre(stint.compound);
+    double laps = stint.laps;
+    double seconds = model.wear * laps * (laps - 1) / 2.0;
+    int life = max(1, static_cast<int>(model.life / this->model.wearScale));
+    double beyond = stint.laps - 1 - life;
+    if (beyond > 0) {
+        seconds += model.cliff * beyond * (beyond + 1) * (2 * beyond + 1) / 6.0;
+    }
+    return seconds * this->model.wearScale;
+}
+
+void StrategySimulator::layout(const Strategy& strategy, double& fixed, double& wear, vector<int>& pitLaps) const {
+    double laps = model.laps;
+    fixed = laps * model.lapSeconds - FUEL_GAIN * laps * (laps - 1) / 2.0;
+    wear = 0.0;
+    pitLaps.clear();
+    int lap = 0;
+    for (size_t i = 0; i < strategy.stints.size(); ++i) {
+        fixed += stintSeconds(strategy.stints[i]);
+        wear += stintWearSeconds(strategy.stints[i]);
+        lap += strategy.stints[i].laps;
+        if (i + 1 < strategy.stints.size()) {
+            pitLaps.push_back(lap);
+        }
+    }
+}
+
+StrategyResult StrategySimulator::evaluateOne(const Strategy& strategy, const Scenarios& scenarios) const {
+    double fixed;
+    double wear;
+    vector<int> pitLaps;
+    layout(strategy, fixed, wear, pitLaps);
+
+    // Welford sobre la diferencia con la parte fija para no perder precision
+    size_t runs = scenarios.wearFactor.size();
+    double mean = 0.0;
+    double m2 = 0.0;
+    for (size_t run = 0; run < runs; ++run) {
+        double seconds = scenarios.wearFactor[run] * wear + scenarios.paceNoise[run];
+        int safetyCarStart = scenarios.safetyCarStart[run];
+        int safetyCarEnd = scenarios.safetyCarEnd[run];
+        const double* pitNoise = scenarios.pitNoise.data() + run * scenarios.stopsPerRun;
+        for (size_t stop = 0; stop < pitLaps.size(); ++stop) {
+            bool neutralised = pitLaps[stop] >= safetyCarStart && pitLaps[stop] < safetyCarEnd;
+            seconds += model.pitLossSeconds * (neutralised ? 1.0 - SAFETY_CAR_PIT_SAVING : 1.0) + pitNoise[stop];
+        }
+        double delta = seconds - mean;
+        mean += delta / (run + 1);
+        m2 += delta * (seconds - mean);
+    }
+
+    double stdDev = runs > 1 ? sqrt(m2 / (runs - 1)) : 0.0;
+    double margin = runs > 0 ? 1.96 * stdDev / sqrt(static_cast<double>(runs)) : 0.0;
+    return { strategy, fixed + mean, stdDev, fixed + mean - margin, fixed + mean + margin };
+}
+
+vector<StrategyResult> StrategySimulator::evaluate(const vector<Strategy>& strategies, const SimulationSettings& settings) const {
+    vector<StrategyResult> best;
+    if (strategies.empty() || settings.runs == 0 || settings.topCount == 0) {
+        return best;
+    }
+
+    size_t stopsPerRun = 0;
+    for (const Strategy& strategy : strategies) {
+        stopsPerRun = max(stopsPerRun, strategy.stops());
+    }
+    Scenarios scenarios = generateScenarios(settings, stopsPerRun);
+
+    // El tiempo de una estrategia es lineal en los terminos de cada escenario, asi que su
+    // media sale de las medias de los escenarios: desgaste, ritmo y, para cada parada y
+    // vuelta, coste medio de parar (la fraccion de escenarios neutralizados en esa vuelta
+    // abarata la parada). Ordenar todas las estrategias cuesta O(paradas) por estrategia;
+    // solo las mejores se recorren escenario a escenario para la desviacion y el intervalo.
+    size_t runs = scenarios.wearFactor.size();
+    double meanWear = 0.0;
+    double meanPace = 0.0;
+    vector<double> neutralisedShare(static_cast<size_t>(model.laps) + 1, 0.0);
+    vector<double> meanPitNoise(stopsPerRun, 0.0);
+    for (size_t run = 0; run < runs; ++run) {
+        meanWear += scenarios.wearFactor[run];
+        meanPace += scenarios.paceNoise[run];
+        for (int lap = scenarios.safetyCarStart[run]; lap < scenarios.safetyCarEnd[run]; ++lap) {
+            neutralisedShare[lap] += 1.0;
+        }
+        for (size_t stop = 0; stop < stopsPerRun; ++stop) {
+            meanPitNoise[stop] += scenarios.pitNoise[run * stopsPerRun + stop];
+        }
+    }
+    meanWear /= runs;
+    meanPace /= runs;
+    for (double& share : neutralisedShare) {
+        share /= runs;
+    }
+    for (double& noise : meanPitNoise) {
+        noise /= runs;
+    }
+
+    vector<double> means(strategies.size());
+    vector<int> pitLaps;
+    for (size_t i = 0; i < strategies.size(); ++i) {
+        double fixed;
+        double wear;
+        layout(strategies[i], fixed, wear, pitLaps);
+        double mean = fixed + meanWear * wear + meanPace;
+        for (size_t stop = 0; stop < pitLaps.size(); ++stop) {
+            mean += model.pitLossSeconds * (1.0 - SAFETY_CAR_PIT_SAVING * neutralisedShare[pitLaps[stop]]) + meanPitNoise[stop];
+        }
+        means[i] = mean;
+    }
+
+    // Empates por orden de enumeracion, para que el resultado sea estable
+    vector<size_t> order(strategies.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    size_t count = min(settings.topCount, order.size());
+    partial_sort(order.begin(), order.begin() + count, order.end(), [&](size_t a, size_t b) {
+        return means[a] != means[b] ? means[a] < means[b] : a < b;
+    });
+    for (size_t i = 0; i < count; ++i) {
+        best.push_back(evaluateOne(strategies[order[i]], scenarios));
+    }
+    // Las medias recalculadas pueden diferir en el ultimo decimal del orden anterior
+    stable_sort(best.begin(), best.end(), [](const StrategyResult& a, const StrategyResult& b) {
+        return a.meanSeconds < b.meanSeconds;
+    });
+    return best;
+}
+
+string StrategySimulator::emptyReason(const SimulationSettings& settings) const {
+    int longestStint = 0;
+    for (Compound compound : allowedCompounds()) {
+        longestStint = max(longestStint, maxStintLaps(compound));
+    }
+    int stints = max(settings.maxStops, 0) + 1;
+    if (static_cast<long long>(longestStint) * stints < model.laps) {
+        return "la carrera (" + to_string(model.laps) + " vueltas) es demasiado larga para " + to_string(settings.maxStops)
+            + " paradas: una tanda dura como mucho " + to_string(longestStint) + " vueltas";
+    }
+    if (model.laps < settings.minStint) {
+        return "la carrera (" + to_string(model.laps) + " vueltas) es mas corta que la tanda minima ("
+            + to_string(settings.minStint) + " vueltas)";
+    }
+    return "ninguna parada cae en una vuelta multiplo de " + to_string(max(1, settings.lapStep)) + " con tandas de "
+        + to_string(minStintLaps(settings)) + " a " + to_string(longestStint) + " vueltas";
+}
+
+vector<StrategyResult> StrategySimulator::run(const SimulationSettings& settings) const {
+    return evaluate(enumerateStrategies(settings), settings);
+}
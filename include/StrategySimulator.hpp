@@ -0,0 +1,116 @@
+#ifndef STRATEGY_SIMULATOR_HPP
+#define STRATEGY_SIMULATOR_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "PitStopAnalysis.hpp"
+
+using namespace std;
+
+enum class Compound { Soft, Medium, Hard, Intermediate, Wet };
+
+struct Stint {
+    Compound compound;
+    int laps;
+};
+
+// Estrategia: neumatico y vueltas de cada tanda; se para al final de cada tanda salvo la ultima
+struct Strategy {
+    vector<Stint> stints;
+
+    size_t stops() const { return stints.empty() ? 0 : stints.size() - 1; }
+};
+
+// Parametros de la carrera simulada
+struct RaceModel {
+    int laps = 0;
+    double lapSeconds = 90.0;      // Vuelta de referencia
+    double pitLossSeconds = 22.0;  // Tiempo perdido en una parada
+    double safetyCarRate = 0.3;    // Probabilidad de neutralizacion por carrera
+    double wearScale = 1.0;        // Desgaste relativo a una vuelta de 90 s
+    bool wet = false;
+
+    // Modelo a partir del historico del circuito (si lo hay) y de la distancia pedida.
+    // Sin historico: vuelta a 200 km/h de media, 22 s por parada y 30% de safety car.
+    static RaceModel build(int laps, double circuitLength, const string& weather, const CircuitPitProfile* history);
+};
+
+struct SimulationSettings {
+    size_t runs = 10000;   // Carreras simuladas por estrategia
+    uint64_t seed = 1;
+    size_t threads = 0;    // 0 = todos los nucleos
+    int maxStops = 2;
+    int lapStep = 2;       // Vueltas de parada candidatas: multiplos de lapStep
+    int minStint = 5;
+    size_t topCount = 5;
+};
+
+struct StrategyResult {
+    Strategy strategy;
+    double meanSeconds;
+    double stdDevSeconds;
+    double lowerSeconds;   // Intervalo de confianza del 95% de la media
+    double upperSeconds;
+};
+
+// Simulador Monte Carlo de estrategias de paradas y neumaticos.
+// Cada carrera simulada (escenario) sortea el desgaste del dia, el ruido de
+// ritmo, una posible neutralizacion (las paradas durante ella cuestan menos) y
+// la duracion de cada parada. Todas las estrategias se evaluan con los mismos
+// escenarios, asi que las diferencias entre ellas no dependen del azar de cada una.
+//
+// Los escenarios se generan en paralelo por bloques de tamano fijo, cada uno con
+// su propio generador derivado de la semilla: el resultado es el mismo para una
+// semilla dada con cualquier numero de hilos. El tiempo de cada tanda sale en
+// forma cerrada y las estrategias se ordenan con las medias de los escenarios;
+// solo las mejores se evaluan escenario a escenario.
+class StrategySimulator {
+public:
+    explicit StrategySimulator(const RaceModel& model);
+
+    // Estrategias candidatas: de 1 a maxStops paradas con al menos dos compuestos
+    // en seco (de 0 a maxStops en mojado, o en seco si no cabe ninguna parada),
+    // tandas entre minStint y 1.5 veces la vida del neumatico, sin pasar de la carrera
+    vector<Strategy> enumerateStrategies(const SimulationSettings& settings) const;
+
+    // Por que enumerateStrategies no devuelve ninguna (demasiadas vueltas para
+    // las paradas permitidas, carrera mas corta que una tanda o paso entre paradas)
+    string emptyReason(const SimulationSettings& settings) const;
+
+    // Evalua las estrategias y devuelve las settings.topCount mejores por tiempo medio
+    vector<StrategyResult> evaluate(const vector<Strategy>& strategies, const SimulationSettings& settings) const;
+
+    // enumerateStrategies + evaluate
+    vector<StrategyResult> run(const SimulationSettings& settings) const;
+
+    static const char* compoundName(Compound compound);
+    static string describe(const Strategy& strategy);  // p. ej. "M 20 - H 38"
+
+private:
+    // Escenarios en columnas; pitNoise tiene maxStops valores por escenario
+    struct Scenarios {
+        size_t stopsPerRun = 0;
+        vector<double> wearFactor;
+        vector<double> paceNoise;
+        vector<int32_t> safetyCarStart;  // Primera vuelta neutralizada; 0 si no hay
+        vector<int32_t> safetyCarEnd;    // Primera vuelta ya sin neutralizar
+        vector<double> pitNoise;
+    };
+
+    RaceModel model;
+
+    vector<Compound> allowedCompounds() const;
+    int minStintLaps(const SimulationSettings& settings) const;
+    int maxStintLaps(Compound compound) const;
+
+    Scenarios generateScenarios(const SimulationSettings& settings, size_t stopsPerRun) const;
+    double stintSeconds(const Stint& stint) const;
+    double stintWearSeconds(const Stint& stint) const;
+    // Parte fija del tiempo (vueltas, combustible y ritmo de los compuestos), desgaste y vueltas de parada
+    void layout(const Strategy& strategy, double& fixed, double& wear, vector<int>& pitLaps) const;
+    StrategyResult evaluateOne(const Strategy& strategy, const Scenarios& scenarios) const;
+};
+
+#endif // STRATEGY_SIMULATOR_HPP
@@ -1,9 +1,9 @@
-#include "Team.hpp"
-
-// Constructor predeterminado
-Team::Team()
-    : teamId(0), name(""), nationality("") {}
-
-// Constructor con parámetros
-Team::Team(int teamId, std::string name, std::string nationality)
-    : teamId(teamId), name(name), nationality(nationality) {}
\ No newline at end of file
+#include "Team.hpp"
+
+// Constructor predeterminado
+Team::Team()
+    : teamId(0) {}
+
+// Constructor con parámetros
+Team::Team(int teamId, InternedString name, InternedString nationality, InternedString teamRef)
+    : teamId(teamId), name(name), nationality(nationality), teamRef(teamRef) {}
\ No newline at end of file
@@ -1,18 +1,19 @@
-#ifndef TEAM_HPP
-#define TEAM_HPP
-
-#include <string>
-
-using namespace std;
-
-class Team {
-public:
-    int teamId;
-    string name;
-    string nationality;
-
-    Team();  // Constructor predeterminado vacío
-    Team(int teamId, string name, string nationality);  // Constructor con parámetros
-};
-
+#ifndef TEAM_HPP
+#define TEAM_HPP
+
+#include "InternedString.hpp"
+
+using namespace std;
+
+class Team {
+public:
+    int teamId;
+    InternedString name;
+    InternedString nationality;
+    InternedString teamRef;  // constructorRef de Ergast (p. ej. "mclaren")
+
+    Team();  // Constructor predeterminado vacío
+    Team(int teamId, InternedString name, InternedString nationality, InternedString teamRef = InternedString());  // Constructor con parámetros
+};
+
 #endif // TEAM_HPP
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+using namespace std;
+
+// Pool de hilos de tamano fijo con cola FIFO.
+// Las tareas se ejecutan en el orden en que se envian, asi que una tarea que
+// espera el future de otra enviada antes nunca bloquea el pool.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads = thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    template <typename F>
+    auto submit(F&& task) -> future<invoke_result_t<F>> {
+        using R = invoke_result_t<F>;
+        auto packaged = make_shared<packaged_task<R()>>(forward<F>(task));
+        future<R> result = packaged->get_future();
+        {
+            lock_guard<mutex> lock(queueMutex);
+            tasks.emplace([packaged]() { (*packaged)(); });
+        }
+        available.notify_one();
+        return result;
+    }
+
+private:
+    vector<thread> workers;
+    queue<function<void()>> tasks;
+    mutex queueMutex;
+    condition_variable available;
+    bool stopping;
+
+    void workerLoop();
+};
+
+#endif // THREAD_POOL_HPP